@@ -0,0 +1,122 @@
+const path = require('path');
+
+// Стоимость ошибок: divide() на каждый элемент с try/catch против одного divideMany() с маской ошибок.
+// Запуск: node benchmark [--size 100000] [--rates 0,0.001,0.01,0.1,0.5] [--repeats 5]
+// Перед запуском соберите нужные примеры (npm run build в их папках), несобранные пропускаются
+
+const VARIANTS = ['napi-throw', 'napi-return', 'node-addon-api-throw', 'node-addon-api-return'];
+
+function parseArgs() {
+    const options = { size: 100_000, rates: [0, 0.001, 0.01, 0.1, 0.5], repeats: 5 };
+    const args = process.argv.slice(2);
+    for (let i = 0; i < args.length; i++) {
+        switch (args[i]) {
+            case '--size':
+                options.size = parseInt(args[++i], 10);
+                break;
+            case '--rates':
+                options.rates = args[++i].split(',').map(Number);
+                break;
+            case '--repeats':
+                options.repeats = parseInt(args[++i], 10);
+                break;
+        }
+    }
+    return options;
+}
+
+function loadVariants() {
+    const loaded = [];
+    for (const name of VARIANTS) {
+        try {
+            const addon = require(path.join(__dirname, '..', name, 'build', 'Release', 'divider.node'));
+            loaded.push({ name, addon });
+        } catch {
+            console.warn(`⚠️ ${name}: не собран, пропускаем (cd ${name} && npm run build)`);
+        }
+    }
+    return loaded;
+}
+
+// Делители: доля errorRate нулей, разбросанных случайно
+function generateInput(size, errorRate) {
+    const a = new Float64Array(size);
+    const b = new Float64Array(size);
+    for (let i = 0; i < size; i++) {
+        a[i] = Math.random() * 100;
+        b[i] = Math.random() < errorRate ? 0 : 1 + Math.random() * 100;
+    }
+    return { a, b };
+}
+
+// Отдельная функция-цикл на каждый вариант, чтобы точка вызова оставалась мономорфной
+function createPerCallLoop() {
+    return new Function('divide', 'a', 'b', `
+        let sum = 0;
+        let errors = 0;
+        for (let i = 0; i < a.length; i++) {
+            try {
+                sum += divide(a[i], b[i]);
+            } catch {
+                errors++;
+            }
+        }
+        return errors;
+    `);
+}
+
+function perCall(addon, a, b, loop) {
+    return loop(addon.divide, a, b);
+}
+
+function batch(addon, a, b) {
+    return addon.divideMany(a, b).errorCount;
+}
+
+// ns на элемент, медиана по repeats прогонам после прогревочного
+function measure(run, repeats, size) {
+    run();
+    const samples = [];
+    for (let r = 0; r < repeats; r++) {
+        const start = process.hrtime.bigint();
+        run();
+        samples.push(Number(process.hrtime.bigint() - start) / size);
+    }
+    samples.sort((x, y) => x - y);
+    return samples[Math.floor(samples.length / 2)];
+}
+
+function main() {
+    const options = parseArgs();
+    const variants = loadVariants();
+    if (variants.length === 0) {
+        console.error('❌ Ни один пример не собран');
+        process.exit(1);
+    }
+
+    console.log(`\n⏱️  ns на элемент, ${options.size} элементов, медиана из ${options.repeats} прогонов`);
+    console.log('    divide  - вызов на каждый элемент, деление на ноль бросает исключение (try/catch в JS)');
+    console.log('    many    - один divideMany(), деление на ноль - NaN и бит в маске ошибок\n');
+
+    const columns = variants.flatMap(({ name }) => [`${name} divide`, `${name} many`]);
+    console.log('Ошибок'.padEnd(10) + columns.map(c => c.padStart(30)).join(''));
+
+    for (const rate of options.rates) {
+        const { a, b } = generateInput(options.size, rate);
+        const row = [];
+        for (const { name, addon } of variants) {
+            const loop = createPerCallLoop();
+            const perCallErrors = perCall(addon, a, b, loop);
+            const batchErrors = batch(addon, a, b);
+            if (perCallErrors !== batchErrors) {
+                throw new Error(`${name}: divide нашел ${perCallErrors} ошибок, divideMany - ${batchErrors}`);
+            }
+
+            row.push(measure(() => perCall(addon, a, b, loop), options.repeats, options.size));
+            row.push(measure(() => batch(addon, a, b), options.repeats, options.size));
+        }
+        console.log(`${(rate * 100).toFixed(1)}%`.padEnd(10) + row.map(ns => ns.toFixed(2).padStart(30)).join(''));
+    }
+}
+
+main();
\ No newline at end of file
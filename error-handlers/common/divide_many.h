@@ -0,0 +1,35 @@
+#pragma once
+
+// Пакетное деление для divideMany во всех примерах: ошибка деления на ноль - это данные, а не исключение.
+// Вместо throw на каждую ошибку: NaN в частном и бит в маске ошибок, вызов всегда завершается успешно
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Размер маски ошибок в байтах: бит i % 8 байта i / 8 - ошибка в элементе i
+inline size_t DivideManyMaskSize(size_t n) {
+    return (n + 7) / 8;
+}
+
+// q[i] = a[i] / b[i]; при b[i] == 0 - q[i] = NaN и бит i в errors. Возвращает число ошибок.
+// Без ветвлений внутри блока из 8 элементов: компилятор векторизует деление и сборку байта маски
+inline size_t DivideMany(const double* a, const double* b, size_t n, double* q, uint8_t* errors) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    size_t errorCount = 0;
+
+    for (size_t block = 0; block < DivideManyMaskSize(n); ++block) {
+        const size_t begin = block * 8;
+        const size_t end = begin + 8 < n ? begin + 8 : n;
+
+        uint8_t mask = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const bool zero = b[i] == 0.0;
+            q[i] = zero ? nan : a[i] / b[i];
+            mask |= static_cast<uint8_t>(zero) << (i - begin);
+            errorCount += zero;
+        }
+        errors[block] = mask;
+    }
+    return errorCount;
+}
@@ -2,6 +2,7 @@
   "targets": [
     { 
       "target_name": "divider",
+      "include_dirs": [ "../common" ],
       "sources": [ "divider.cpp" ]
     }
   ]
@@ -1,4 +1,5 @@
 #include <node_api.h>
+#include "divide_many.h"
 
 napi_value NapiDivide(napi_env env, napi_callback_info info) {
     napi_status status;
@@ -38,12 +39,94 @@ napi_value NapiDivide(napi_env env, napi_callback_info info) {
     return result;
 }
 
+// Float64Array -> указатель на данные и длина, false если аргумент другого типа.
+// Признак - именно bool: у пустого массива указатель на данные может быть nullptr
+static bool GetFloat64Array(napi_env env, napi_value value, const double** data, size_t* length) {
+    bool is_typedarray = false;
+    napi_typedarray_type type;
+    void* raw;
+    if (napi_is_typedarray(env, value, &is_typedarray) != napi_ok || !is_typedarray) return false;
+    if (napi_get_typedarray_info(env, value, &type, length, &raw, nullptr, nullptr) != napi_ok) return false;
+    if (type != napi_float64_array) return false;
+    *data = static_cast<const double*>(raw);
+    return true;
+}
+
+static napi_status CreateTypedArray(napi_env env, napi_typedarray_type type, size_t length, size_t element_size, void** data, napi_value* result) {
+    napi_value arraybuffer;
+    napi_status status = napi_create_arraybuffer(env, length * element_size, data, &arraybuffer);
+    if (status != napi_ok) return status;
+    return napi_create_typedarray(env, type, length, arraybuffer, 0, result);
+}
+
+// divideMany(a, b) -> { quotients, errors, errorCount }
+// Деление на ноль не бросает: NaN в quotients и бит в маске errors (Uint8Array, бит i % 8 байта i / 8).
+// Ошибка бросается только для неверных аргументов - это ошибка вызывающего кода, а не данных
+napi_value NapiDivideMany(napi_env env, napi_callback_info info) {
+    napi_status status;
+    size_t argc = 2;
+    napi_value args[2];
+    
+    status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok) return nullptr;
+    
+    if (argc < 2) {
+        napi_throw_error(env, nullptr, "Требуется два аргумента");
+        return nullptr;
+    }
+    
+    size_t n, n2;
+    const double* a;
+    if (!GetFloat64Array(env, args[0], &a, &n)) {
+        napi_throw_type_error(env, nullptr, "Первый аргумент должен быть Float64Array");
+        return nullptr;
+    }
+    
+    const double* b;
+    if (!GetFloat64Array(env, args[1], &b, &n2)) {
+        napi_throw_type_error(env, nullptr, "Второй аргумент должен быть Float64Array");
+        return nullptr;
+    }
+    
+    if (n != n2) {
+        napi_throw_range_error(env, nullptr, "Массивы должны быть одной длины");
+        return nullptr;
+    }
+    
+    void* quotients_data;
+    void* errors_data;
+    napi_value quotients, errors;
+    status = CreateTypedArray(env, napi_float64_array, n, sizeof(double), &quotients_data, &quotients);
+    if (status != napi_ok) return nullptr;
+    
+    status = CreateTypedArray(env, napi_uint8_array, DivideManyMaskSize(n), 1, &errors_data, &errors);
+    if (status != napi_ok) return nullptr;
+    
+    size_t error_count = DivideMany(a, b, n, static_cast<double*>(quotients_data), static_cast<uint8_t*>(errors_data));
+    
+    napi_value result, count;
+    status = napi_create_object(env, &result);
+    if (status != napi_ok) return nullptr;
+    
+    status = napi_create_double(env, static_cast<double>(error_count), &count);
+    if (status != napi_ok) return nullptr;
+    
+    if (napi_set_named_property(env, result, "quotients", quotients) != napi_ok) return nullptr;
+    if (napi_set_named_property(env, result, "errors", errors) != napi_ok) return nullptr;
+    if (napi_set_named_property(env, result, "errorCount", count) != napi_ok) return nullptr;
+    
+    return result;
+}
+
 napi_value Init(napi_env env, napi_value exports) {
     napi_value fn;
     
     napi_create_function(env, nullptr, 0, NapiDivide, nullptr, &fn);
     napi_set_named_property(env, exports, "divide", fn);
     
+    napi_create_function(env, nullptr, 0, NapiDivideMany, nullptr, &fn);
+    napi_set_named_property(env, exports, "divideMany", fn);
+    
     return exports;
 }
 
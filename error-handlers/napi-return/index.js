@@ -3,4 +3,11 @@ try {
     console.log(divider.divide(10, 0));
 } catch (error) {
     console.log('Error: ', error.message);
-}
\ No newline at end of file
+}
+
+// Пакетный вариант не бросает: деление на ноль - NaN в quotients и бит в маске errors
+const { quotients, errors, errorCount } = divider.divideMany(new Float64Array([10, 1, 9]), new Float64Array([2, 0, 3]));
+console.log(quotients, errors, errorCount);
+
+// Пустые массивы - корректный вход: пустой результат, а не ошибка типа
+console.log(divider.divideMany(new Float64Array(0), new Float64Array(0)).errorCount);
@@ -1,6 +1,7 @@
 #include <node_api.h>
 #include <string>
 #include <stdexcept>
+#include "divide_many.h"
 
 napi_value NapiDivide(napi_env env, napi_callback_info info) {
     napi_status status;
@@ -41,12 +42,82 @@ napi_value NapiDivide(napi_env env, napi_callback_info info) {
     }
 }
 
+// Float64Array -> указатель на данные и длина, иначе исключение
+static const double* GetFloat64Array(napi_env env, napi_value value, size_t* length, const char* error) {
+    bool is_typedarray = false;
+    napi_typedarray_type type;
+    void* data;
+    if (napi_is_typedarray(env, value, &is_typedarray) != napi_ok || !is_typedarray ||
+        napi_get_typedarray_info(env, value, &type, length, &data, nullptr, nullptr) != napi_ok ||
+        type != napi_float64_array) {
+        throw std::runtime_error(error);
+    }
+    return static_cast<const double*>(data);
+}
+
+static napi_value CreateTypedArray(napi_env env, napi_typedarray_type type, size_t length, size_t element_size, void** data) {
+    napi_value arraybuffer, result;
+    if (napi_create_arraybuffer(env, length * element_size, data, &arraybuffer) != napi_ok ||
+        napi_create_typedarray(env, type, length, arraybuffer, 0, &result) != napi_ok) {
+        throw std::runtime_error("Ошибка создания результата");
+    }
+    return result;
+}
+
+// divideMany(a, b) -> { quotients, errors, errorCount }
+// Деление на ноль не бросает: NaN в quotients и бит в маске errors (Uint8Array, бит i % 8 байта i / 8).
+// Исключения остаются только для неверных аргументов - это ошибка вызывающего кода, а не данных
+napi_value NapiDivideMany(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    
+    try {
+        napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+        if (status != napi_ok) throw std::runtime_error("Ошибка получения аргументов");
+        
+        if (argc < 2) {
+            throw std::runtime_error("Требуется два аргумента");
+        }
+        
+        size_t n, n2;
+        const double* a = GetFloat64Array(env, args[0], &n, "Первый аргумент должен быть Float64Array");
+        const double* b = GetFloat64Array(env, args[1], &n2, "Второй аргумент должен быть Float64Array");
+        if (n != n2) {
+            throw std::runtime_error("Массивы должны быть одной длины");
+        }
+        
+        void* quotients_data;
+        void* errors_data;
+        napi_value quotients = CreateTypedArray(env, napi_float64_array, n, sizeof(double), &quotients_data);
+        napi_value errors = CreateTypedArray(env, napi_uint8_array, DivideManyMaskSize(n), 1, &errors_data);
+        
+        size_t error_count = DivideMany(a, b, n, static_cast<double*>(quotients_data), static_cast<uint8_t*>(errors_data));
+        
+        napi_value result, count;
+        if (napi_create_object(env, &result) != napi_ok ||
+            napi_create_double(env, static_cast<double>(error_count), &count) != napi_ok ||
+            napi_set_named_property(env, result, "quotients", quotients) != napi_ok ||
+            napi_set_named_property(env, result, "errors", errors) != napi_ok ||
+            napi_set_named_property(env, result, "errorCount", count) != napi_ok) {
+            throw std::runtime_error("Ошибка создания результата");
+        }
+        return result;
+        
+    } catch (const std::exception& e) {
+        napi_throw_error(env, nullptr, e.what());
+        return nullptr;
+    }
+}
+
 napi_value Init(napi_env env, napi_value exports) {
     napi_value fn;
     
     napi_create_function(env, nullptr, 0, NapiDivide, nullptr, &fn);
     napi_set_named_property(env, exports, "divide", fn);
     
+    napi_create_function(env, nullptr, 0, NapiDivideMany, nullptr, &fn);
+    napi_set_named_property(env, exports, "divideMany", fn);
+    
     return exports;
 }
 
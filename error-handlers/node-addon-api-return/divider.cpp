@@ -1,4 +1,5 @@
 #include <napi.h>
+#include "divide_many.h"
 
 Napi::Value NapiDivide(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -24,8 +25,47 @@ Napi::Value NapiDivide(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, a / b);
 }
 
+// divideMany(a, b) -> { quotients, errors, errorCount }
+// Деление на ноль не бросает: NaN в quotients и бит в маске errors (Uint8Array, бит i % 8 байта i / 8).
+// Ошибка бросается только для неверных аргументов - это ошибка вызывающего кода, а не данных
+Napi::Value NapiDivideMany(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2) {
+        Napi::TypeError::New(env, "Требуется два аргумента").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto isFloat64Array = [](const Napi::Value& value) {
+        return value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_float64_array;
+    };
+    if (!isFloat64Array(info[0]) || !isFloat64Array(info[1])) {
+        Napi::TypeError::New(env, "Аргументы должны быть Float64Array").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    Napi::Float64Array a = info[0].As<Napi::Float64Array>();
+    Napi::Float64Array b = info[1].As<Napi::Float64Array>();
+    if (a.ElementLength() != b.ElementLength()) {
+        Napi::RangeError::New(env, "Массивы должны быть одной длины").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    const size_t n = a.ElementLength();
+    Napi::Float64Array quotients = Napi::Float64Array::New(env, n);
+    Napi::Uint8Array errors = Napi::Uint8Array::New(env, DivideManyMaskSize(n));
+    size_t errorCount = DivideMany(a.Data(), b.Data(), n, quotients.Data(), errors.Data());
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("quotients", quotients);
+    result.Set("errors", errors);
+    result.Set("errorCount", Napi::Number::New(env, static_cast<double>(errorCount)));
+    return result;
+}
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set(Napi::String::New(env, "divide"), Napi::Function::New(env, NapiDivide));
+    exports.Set(Napi::String::New(env, "divideMany"), Napi::Function::New(env, NapiDivideMany));
     return exports;
 }
 
@@ -1,13 +1,17 @@
 const { generateMatrix } = require('../../utils/generate-matrix');
 const { getFunctionByKey } = require('./functions-registry');
 const config = require('./config');
+const { openPerfCounters } = require('./perf-counters');
 const {
     analyzeTimings,
+    analyzeIterations,
+    calculateGflops,
     ensureOutputDir,
     initCSV,
     appendToCSV,
     logBatchResult,
     logFunctionResult,
+    logIterationStats,
     logMatrixSizeHeader,
     logFunctionHeader,
     forceGarbageCollection,
@@ -37,7 +41,9 @@ class BenchmarkRunner {
     }
 
     // Выполнение одной итерации функции
-    async executeFunction(func, matrixA, matrixB, funcConfig) {
+    // Счетчики включаются вне окна performance.now(), чтобы ioctl не попадал в замер времени
+    async executeFunction(func, matrixA, matrixB, funcConfig, counters = null) {
+        counters?.enable();
         const startTime = performance.now();
         
         try {
@@ -48,20 +54,23 @@ class BenchmarkRunner {
             }
             
             const endTime = performance.now();
+            counters?.disable();
             return endTime - startTime;
         } catch (error) {
+            counters?.disable();
             console.error(`❌ Ошибка выполнения функции: ${error.message}`);
             throw error;
         }
     }
 
     // Выполнение одного батча
-    async executeBatch(func, funcConfig, matrixA, matrixB, batchNum, totalBatches) {
+    async executeBatch(func, funcConfig, matrixA, matrixB, batchNum, totalBatches, iterationTimes, counters) {
         const batchTimes = [];
         
         for (let i = 0; i < this.config.iterationsPerBatch; i++) {
-            const iterationTime = await this.executeFunction(func, matrixA, matrixB, funcConfig);
+            const iterationTime = await this.executeFunction(func, matrixA, matrixB, funcConfig, counters);
             batchTimes.push(iterationTime);
+            iterationTimes.push(iterationTime);
             
             // Небольшая пауза между итерациями
             if (i < this.config.iterationsPerBatch - 1) {
@@ -95,16 +104,36 @@ class BenchmarkRunner {
         }
 
         const { func, name } = funcConfig;
+        const matrixSize = matrixA.length;
+
+        // Приведение входных данных к формату функции (например, квантование в int8)
+        if (funcConfig.prepare) {
+            [matrixA, matrixB] = funcConfig.prepare(matrixA, matrixB);
+        }
         
         await this.warmupFunction(func, funcConfig, matrixA, matrixB);
-        
+
+        // После разогрева все рабочие потоки (libuv, пул аддона) уже созданы
+        const counters = this.config.perfCounters ? openPerfCounters() : null;
+        try {
+            return await this.runBatches(func, funcConfig, name, matrixA, matrixB, matrixSize, counters);
+        } finally {
+            counters?.close();
+        }
+    }
+
+    // Батчи с авто-ретраем до достижения стабильности
+    async runBatches(func, funcConfig, name, matrixA, matrixB, matrixSize, counters) {
         const batchTimes = [];
+        const iterationTimes = [];
         let currentBatches = this.config.batches;
         let currentIterations = this.config.iterationsPerBatch;
         let retryCount = 0;
     
         while (retryCount <= this.config.autoRetry.maxRetries) {
             batchTimes.length = 0;
+            iterationTimes.length = 0;
+            counters?.reset();
             
             for (let batch = 1; batch <= currentBatches; batch++) {
                 if (this.config.gcBetweenBatches && batch > 1) {
@@ -113,7 +142,7 @@ class BenchmarkRunner {
                 }
                 
                 const batchTime = await this.executeBatch(
-                func, funcConfig, matrixA, matrixB, batch, currentBatches
+                func, funcConfig, matrixA, matrixB, batch, currentBatches, iterationTimes, counters
                 );
                 batchTimes.push(batchTime);
             }
@@ -126,8 +155,13 @@ class BenchmarkRunner {
                 !this.config.autoRetry.enabled || 
                 retryCount >= this.config.autoRetry.maxRetries) {
                 
+                Object.assign(analysis, analyzeIterations(iterationTimes));
+                analysis.gflops = calculateGflops(matrixSize, analysis.mean);
+                analysis.counters = counters ? this.perIteration(counters.read(), iterationTimes.length) : null;
+
                 // Выводим результат
                 logFunctionResult(name, analysis, this.config.stabilityThresholds);
+                logIterationStats(analysis);
                 
                 return analysis;
             }
@@ -146,6 +180,15 @@ class BenchmarkRunner {
         }
     }
 
+    // Счетчики за все итерации -> на одну итерацию
+    perIteration(totals, iterations) {
+        const result = {};
+        for (const [key, value] of Object.entries(totals)) {
+            result[key] = value === null ? null : value / iterations;
+        }
+        return result;
+    }
+
     // Тестирование функции для одного размера матрицы
     async benchmarkMatrixSize(matrixSize, functionKey, sizeIndex, totalSizes) {
         logMatrixSizeHeader(matrixSize, sizeIndex + 1, totalSizes);
@@ -11,6 +11,14 @@ const config = {
     batchCooldown: 2000,           // пауза между батчами (мс)
     gcBetweenBatches: false,       // принудительный GC между батчами
     targetStabilityCV: 5.0,        // целевой коэффициент вариации (%)
+    perfCounters: true,            // аппаратные счетчики через perf_event_open (только Linux)
+    
+    // Режим --compare: сравнение с сохраненными результатами
+    compare: {
+        trials: 3,                   // повторов каждого размера
+        threshold: 0.05,             // допустимое ухудшение (5%)
+        alpha: 0.05                  // уровень значимости теста Уэлча
+    },
     
     // Вывод результатов
     outputDir: './benchmarks/raw_results/isolated/',
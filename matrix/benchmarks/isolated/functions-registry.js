@@ -1,5 +1,6 @@
 // Импорты JavaScript функций
 const jsMatrix = require('../../js-native');
+const { quantizeMatrixInt8 } = require('../../utils/generate-matrix');
 
 // Импорт C++ аддона
 let cppMatrix;
@@ -100,6 +101,12 @@ const functionsRegistry = {
             type: 'async',
             available: !!cppMatrix?.multiplySimdAsync
         },
+        'pool-async': {
+            name: 'C++ Pool Async',
+            func: cppMatrix ? promisifyCallback(cppMatrix.multiplyPoolAsync) : null,
+            type: 'async',
+            available: !!cppMatrix?.multiplyPoolAsync
+        },
         accelerate: {
             name: 'C++ Accelerate',
             func: cppMatrix?.multiplyAccelerate,
@@ -111,6 +118,14 @@ const functionsRegistry = {
             func: cppMatrix ? promisifyCallback(cppMatrix.multiplyAccelerateAsync) : null,
             type: 'async',
             available: !!cppMatrix?.multiplyAccelerateAsync && process.platform === 'darwin'
+        },
+        int8: {
+            name: 'C++ Int8',
+            func: (A, B) => cppMatrix.multiplyInt8(A.data, B.data, A.rows, A.cols, B.cols),
+            // Квантование вне замера времени - сравниваем только ядра с double-версиями
+            prepare: (A, B) => [quantizeMatrixInt8(A), quantizeMatrixInt8(B)],
+            type: 'sync',
+            available: !!cppMatrix?.multiplyInt8
         }
     },
 
@@ -138,6 +153,25 @@ const functionsRegistry = {
             func: wasm?.multiplySimdWorker,
             type: 'async',
             available: !!wasm?.multiplySimdWorker
+        },
+        // *_ptr экспорты появляются только после initWasm, поэтому available - геттер
+        'base-heap': {
+            name: 'WASM Base (heap)',
+            func: wasm?.multiplyBaseHeap,
+            type: 'sync',
+            get available() { return !!wasm?.hasHeapExports(); }
+        },
+        'simd-heap': {
+            name: 'WASM SIMD (heap)',
+            func: wasm?.multiplySimdHeap,
+            type: 'sync',
+            get available() { return !!wasm?.hasHeapExports(); }
+        },
+        threads: {
+            name: 'WASM Threads',
+            func: wasm?.multiplyThreads,
+            type: 'async',
+            available: !!wasm?.hasThreadsBuild?.()
         }
     },
 
@@ -5,6 +5,16 @@ const { BenchmarkRunner } = require('./benchmark-runner');
 const { listAvailableFunctions, getFunctionByKey } = require('./functions-registry');
 const config = require('./config');
 const { initWasm } = require('../../wasm');
+const {
+    summarize,
+    loadBaselineCSV,
+    findLatestBaseline,
+    getPlatformResultsDir,
+    compareMetric,
+    printReport,
+    parseCompareArg,
+    COMPARE_HELP
+} = require('../regression');
 
 // Парсинг аргументов командной строки
 function parseArgs() {
@@ -13,11 +23,22 @@ function parseArgs() {
         functionKey: null,
         help: false,
         listFunctions: false,
+        compare: false,
+        baselineFile: null,
+        trials: config.compare.trials,
+        threshold: config.compare.threshold,
+        alpha: config.compare.alpha,
     };
 
     for (let i = 0; i < args.length; i++) {
         const arg = args[i];
 
+        const consumed = parseCompareArg(args, i, options);
+        if (consumed !== null) {
+            i = consumed;
+            continue;
+        }
+
         switch (arg) {
             case '--help':
                 options.help = true;
@@ -50,10 +71,13 @@ function showHelp() {
 ПРИМЕРЫ:
     npm run isolated-benchmark cpp.simd
     npm run isolated-benchmark --functions
+    npm run isolated-benchmark cpp.simd --compare
+    npm run isolated-benchmark cpp.simd --compare benchmarks/linux_results/isolated/cpp_simd_2025-09-24T21-48-26.csv --trials 5
 
 ОПЦИИ:
     --help              Показать эту справку
     --functions         Показать доступные функции
+${COMPARE_HELP}
 
 ФОРМАТЫ ФУНКЦИЙ:
     tech.name               Например: js.base, cpp.simd, rust.accelerate
@@ -72,6 +96,57 @@ function generateOutputFileName(options) {
     return path.resolve(config.outputDir, `${basename}_${timestamp}.csv`);
 }
 
+// Режим сравнения: те же размеры, что в baseline, несколько прогонов на размер
+// Выборка текущего прогона - средние всех батчей всех прогонов,
+// у baseline есть только avg/min/max батчей, поэтому sd оценивается как (max - min) / 4
+async function runCompare(runner, options) {
+    const baselineFile = options.baselineFile || findLatestBaseline(getPlatformResultsDir('isolated'), options.functionKey);
+    if (!baselineFile) {
+        console.error(`❌ Baseline для ${options.functionKey} не найден, укажите файл: --compare <file.csv>`);
+        process.exitCode = 1;
+        return;
+    }
+
+    const baseline = loadBaselineCSV(baselineFile);
+    const sizes = [...baseline.keys()];
+    console.log(`🎯 Сравнение с baseline:`);
+    console.log(`   • Функция: ${options.functionKey}`);
+    console.log(`   • Baseline: ${baselineFile}`);
+    console.log(`   • Размеры: ${sizes.join(', ')}`);
+    console.log(`   • Прогонов на размер: ${options.trials}, порог: ${options.threshold * 100}%, alpha: ${options.alpha}\n`);
+
+    const comparisons = [];
+    for (let i = 0; i < sizes.length; i++) {
+        const size = sizes[i];
+        const row = baseline.get(size);
+        const batchTimes = [];
+
+        for (let trial = 0; trial < options.trials; trial++) {
+            const analysis = await runner.benchmarkMatrixSize(size, options.functionKey, i, sizes.length);
+            if (!analysis) {
+                process.exitCode = 1;
+                return;
+            }
+            batchTimes.push(...analysis.batchTimes);
+        }
+
+        comparisons.push(compareMetric({
+            size,
+            metric: 'time_ms',
+            baseline: { mean: row.avg, sd: (row.max - row.min) / 4, n: config.batches },
+            current: summarize(batchTimes),
+            higherIsBetter: false,
+            threshold: options.threshold,
+            alpha: options.alpha
+        }));
+    }
+
+    const regressions = printReport(`${options.functionKey} vs ${path.basename(baselineFile)}`, comparisons);
+    if (regressions > 0) {
+        process.exitCode = 1;
+    }
+}
+
 // Основная функция
 async function main() {
     const options = parseArgs();
@@ -105,6 +180,11 @@ async function main() {
                 return;
             }
             
+            if (options.compare) {
+                await runCompare(runner, options);
+                return;
+            }
+
             functions = [options.functionKey];
             outputFile = generateOutputFileName(options);
                     
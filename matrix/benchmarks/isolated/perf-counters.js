@@ -0,0 +1,29 @@
+// Обертка над нативным аддоном perf_counters (perf_event_open)
+// Без аддона, не на Linux или без доступа к PMU возвращает null - бенчмарк пишет пустые колонки
+let addon = null;
+try {
+    addon = require('bindings')('perf_counters');
+} catch (error) {
+    addon = null;
+}
+
+const PERF_COUNTER_NAMES = ['cycles', 'instructions', 'branchMisses', 'l1dMisses', 'llcMisses'];
+
+// Открывать после разогрева: счетчики вешаются только на уже существующие потоки
+function openPerfCounters() {
+    if (!addon) {
+        return null;
+    }
+
+    const counters = new addon.PerfCounters();
+    if (counters.available.length === 0) {
+        counters.close();
+        return null;
+    }
+    return counters;
+}
+
+module.exports = {
+    PERF_COUNTER_NAMES,
+    openPerfCounters
+};
\ No newline at end of file
@@ -1,4 +1,5 @@
 const fs = require('fs');
+const { PERF_COUNTER_NAMES } = require('./perf-counters');
 
 // Статистические функции
 function calculateMean(values) {
@@ -32,6 +33,26 @@ function analyzeTimings(batchTimes) {
     };
 }
 
+// Перцентиль по методу nearest-rank
+function calculatePercentile(values, percentile) {
+    const sorted = [...values].sort((a, b) => a - b);
+    const rank = Math.ceil((percentile / 100) * sorted.length);
+    return sorted[Math.min(sorted.length - 1, Math.max(0, rank - 1))];
+}
+
+// Хвосты распределения по отдельным итерациям (среднее по батчам их сглаживает)
+function analyzeIterations(iterationTimes) {
+    return {
+        p50: parseFloat(calculatePercentile(iterationTimes, 50).toFixed(3)),
+        p99: parseFloat(calculatePercentile(iterationTimes, 99).toFixed(3))
+    };
+}
+
+// GFLOP/s для умножения n x n: 2 * n^3 операций
+function calculateGflops(matrixSize, meanMs) {
+    return parseFloat(((2 * Math.pow(matrixSize, 3)) / (meanMs * 1e6)).toFixed(3));
+}
+
 // Форматирование чисел для CSV
 function formatNumberForCSV(number) {
     // нужен для корректного импорта в Google Sheets
@@ -57,6 +78,11 @@ function ensureOutputDir(outputDir) {
     }
 }
 
+// branchMisses -> branch_misses
+function toSnakeCase(name) {
+    return name.replace(/[A-Z]/g, letter => `_${letter.toLowerCase()}`);
+}
+
 // Инициализация CSV файла
 function initCSV(outputFile, functionKey) {
     const headers = ['matrix_size'];
@@ -66,6 +92,12 @@ function initCSV(outputFile, functionKey) {
     headers.push(`avg_${cleanKey}`);    // Среднее время
     headers.push(`min_${cleanKey}`);    // Минимальное время
     headers.push(`max_${cleanKey}`);    // Максимальное время
+    headers.push(`p50_${cleanKey}`);    // Медиана по итерациям
+    headers.push(`p99_${cleanKey}`);    // 99-й перцентиль по итерациям
+    headers.push(`gflops_${cleanKey}`); // Производительность
+
+    // Аппаратные счетчики на одну итерацию (пусто, если PMU недоступен)
+    PERF_COUNTER_NAMES.forEach(name => headers.push(`${toSnakeCase(name)}_${cleanKey}`));
 
     const headerLine = headers.join(';') + '\n';
     fs.writeFileSync(outputFile, headerLine);
@@ -80,6 +112,14 @@ function appendToCSV(outputFile, matrixSize, results) {
     row.push(formatNumberForCSV(results.mean));    // Среднее
     row.push(formatNumberForCSV(results.min));     // Min
     row.push(formatNumberForCSV(results.max));     // Max
+    row.push(formatNumberForCSV(results.p50));     // p50
+    row.push(formatNumberForCSV(results.p99));     // p99
+    row.push(formatNumberForCSV(results.gflops));  // GFLOP/s
+
+    PERF_COUNTER_NAMES.forEach(name => {
+        const value = results.counters?.[name];
+        row.push(value === null || value === undefined ? '' : formatNumberForCSV(Math.round(value)));
+    });
 
     const rowLine = row.join(';') + '\n';
     fs.appendFileSync(outputFile, rowLine);
@@ -99,6 +139,21 @@ function logFunctionResult(funcName, analysis, thresholds) {
                 `${stability.color}(CV: ${analysis.cv}%, min: ${analysis.min}ms, max: ${analysis.max}ms) ${stability.icon} ${stability.label}${reset}`);
 }
 
+function logIterationStats(analysis) {
+    console.log(`     p50: ${analysis.p50}ms, p99: ${analysis.p99}ms, ${analysis.gflops} GFLOP/s`);
+
+    const counters = analysis.counters;
+    if (!counters) {
+        console.log('     ⚠️ Аппаратные счетчики недоступны');
+        return;
+    }
+
+    const format = (value) => (value === null ? 'n/a' : Math.round(value).toLocaleString('ru-RU'));
+    const ipc = counters.cycles && counters.instructions !== null ? (counters.instructions / counters.cycles).toFixed(2) : 'n/a';
+    console.log(`     cycles: ${format(counters.cycles)}, instructions: ${format(counters.instructions)} (IPC ${ipc}), ` +
+                `L1D miss: ${format(counters.l1dMisses)}, LLC miss: ${format(counters.llcMisses)}, branch miss: ${format(counters.branchMisses)}`);
+}
+
 function logMatrixSizeHeader(matrixSize, current, total) {
     console.log(`\n🔢 Матрица ${matrixSize}x${matrixSize} (${current}/${total})`);
     console.log('═'.repeat(50));
@@ -128,6 +183,9 @@ module.exports = {
     calculateStandardDeviation,
     calculateCoefficientOfVariation,
     analyzeTimings,
+    calculatePercentile,
+    analyzeIterations,
+    calculateGflops,
 
     // Работа с CSV
     formatNumberForCSV,
@@ -139,6 +197,7 @@ module.exports = {
     getStabilityInfo,
     logBatchResult,
     logFunctionResult,
+    logIterationStats,
     logMatrixSizeHeader,
     logFunctionHeader,
 
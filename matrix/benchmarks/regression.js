@@ -0,0 +1,230 @@
+const fs = require('fs');
+const path = require('path');
+
+// Сравнение нового прогона с сохраненными результатами (linux_results / macos_results)
+// Используется в режиме --compare isolated и server бенчмарков
+
+// ========================== Статистика ==========================
+
+function summarize(values) {
+    const n = values.length;
+    const mean = values.reduce((sum, v) => sum + v, 0) / n;
+    // Несмещенная дисперсия: выборки маленькие (батчи, прогоны)
+    const variance = n > 1 ? values.reduce((acc, v) => acc + Math.pow(v - mean, 2), 0) / (n - 1) : 0;
+    return { mean, sd: Math.sqrt(variance), n };
+}
+
+// ln Г(x), аппроксимация Ланцоша
+function logGamma(x) {
+    const g = 7;
+    const c = [
+        0.99999999999980993, 676.5203681218851, -1259.1392167224028, 771.32342877765313,
+        -176.61503916999185, 12.507343278686905, -0.13857109526572012, 9.9843695780195716e-6, 1.5056327351493116e-7
+    ];
+    if (x < 0.5) {
+        return Math.log(Math.PI / Math.sin(Math.PI * x)) - logGamma(1 - x);
+    }
+    x -= 1;
+    let a = c[0];
+    const t = x + g + 0.5;
+    for (let i = 1; i < g + 2; i++) {
+        a += c[i] / (x + i);
+    }
+    return 0.5 * Math.log(2 * Math.PI) + (x + 0.5) * Math.log(t) - t + Math.log(a);
+}
+
+// Регуляризованная неполная бета-функция I_x(a, b), цепная дробь (Numerical Recipes)
+function incompleteBeta(x, a, b) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    if (x > (a + 1) / (a + b + 2)) {
+        return 1 - incompleteBeta(1 - x, b, a);
+    }
+
+    const front = Math.exp(logGamma(a + b) - logGamma(a) - logGamma(b) + a * Math.log(x) + b * Math.log(1 - x)) / a;
+    let f = 1, c = 1, d = 0;
+    for (let i = 0; i <= 200; i++) {
+        const m = Math.floor(i / 2);
+        let numerator;
+        if (i === 0) {
+            numerator = 1;
+        } else if (i % 2 === 0) {
+            numerator = (m * (b - m) * x) / ((a + 2 * m - 1) * (a + 2 * m));
+        } else {
+            numerator = -((a + m) * (a + b + m) * x) / ((a + 2 * m) * (a + 2 * m + 1));
+        }
+
+        d = 1 + numerator * d;
+        d = Math.abs(d) < 1e-30 ? 1e-30 : d;
+        d = 1 / d;
+        c = 1 + numerator / c;
+        c = Math.abs(c) < 1e-30 ? 1e-30 : c;
+        f *= c * d;
+        if (Math.abs(1 - c * d) < 1e-10) {
+            break;
+        }
+    }
+    return front * (f - 1);
+}
+
+// P(T > t) для распределения Стьюдента с df степенями свободы
+function studentTSurvival(t, df) {
+    const tail = 0.5 * incompleteBeta(df / (df + t * t), df / 2, 0.5);
+    return t > 0 ? tail : 1 - tail;
+}
+
+// Односторонний тест Уэлча: вероятность увидеть такое ухудшение current относительно baseline случайно
+// higherIsBetter: true для RPS, false для времени/латентности
+function welchTest(baseline, current, higherIsBetter) {
+    const se2 = (baseline.sd * baseline.sd) / baseline.n + (current.sd * current.sd) / current.n;
+    if (se2 === 0) {
+        // Нет разброса - решает только порог
+        return { t: 0, df: 0, pValue: current.mean === baseline.mean ? 1 : 0 };
+    }
+
+    const worse = higherIsBetter ? baseline.mean - current.mean : current.mean - baseline.mean;
+    const t = worse / Math.sqrt(se2);
+
+    // Степени свободы Уэлча-Саттертуэйта (выборка из одного элемента в знаменатель не входит)
+    const term = (s) => (s.n > 1 ? Math.pow((s.sd * s.sd) / s.n, 2) / (s.n - 1) : 0);
+    const df = Math.max(1, (se2 * se2) / Math.max(term(baseline) + term(current), 1e-300));
+
+    return { t, df, pValue: studentTSurvival(t, df) };
+}
+
+// ========================== Baseline ==========================
+
+function parseCSVNumber(value) {
+    return value === undefined || value === '' ? null : parseFloat(value.replace(',', '.'));
+}
+
+// CSV бенчмарка -> Map(size -> { avg, min, max, p99, ... }), колонки берутся по префиксу до ключа метода
+function loadBaselineCSV(file) {
+    const lines = fs.readFileSync(file, 'utf8').trim().split('\n');
+    const headers = lines[0].split(';');
+    const methodKey = headers[1].replace(/^avg_/, '');
+
+    const rows = new Map();
+    for (const line of lines.slice(1)) {
+        const cells = line.split(';');
+        const row = {};
+        headers.forEach((header, i) => {
+            if (i > 0) {
+                row[header.replace(`_${methodKey}`, '')] = parseCSVNumber(cells[i]);
+            }
+        });
+        rows.set(parseInt(cells[0], 10), row);
+    }
+    return rows;
+}
+
+// Последний по времени файл {key}_{timestamp}.csv в каталоге результатов платформы
+function findLatestBaseline(resultsDir, key) {
+    const prefix = key.replace('.', '_');
+    const pattern = new RegExp(`^${prefix.replace(/[-]/g, '\\-')}_(\\d{4}-\\d{2}-\\d{2}T\\d{2}-\\d{2}-\\d{2})\\.csv$`);
+
+    if (!fs.existsSync(resultsDir)) {
+        return null;
+    }
+    const files = fs.readdirSync(resultsDir).filter(name => pattern.test(name)).sort();
+    return files.length > 0 ? path.join(resultsDir, files[files.length - 1]) : null;
+}
+
+function getPlatformResultsDir(kind) {
+    const platformDir = process.platform === 'darwin' ? 'macos_results' : 'linux_results';
+    return path.resolve(__dirname, platformDir, kind);
+}
+
+// ========================== Отчет ==========================
+
+/**
+ * Сравнение одной метрики для одного размера
+ * Регрессия = ухудшение больше порога И статистически значимое (p < alpha)
+ * thresholdOnly - разброс оценить не по чему (один замер с каждой стороны): только порог, pValue = null
+ */
+function compareMetric({ size, metric, baseline, current, higherIsBetter, threshold, alpha, thresholdOnly = false }) {
+    const change = (current.mean - baseline.mean) / baseline.mean;
+    const worseChange = higherIsBetter ? -change : change;
+    const pValue = thresholdOnly ? null : welchTest(baseline, current, higherIsBetter).pValue;
+
+    let status = 'ok';
+    if (worseChange > threshold) {
+        status = thresholdOnly || pValue < alpha ? 'regression' : 'noise';
+    } else if (-worseChange > threshold && (thresholdOnly || 1 - pValue < alpha)) {
+        status = 'improvement';
+    }
+
+    return { size, metric, baseline: baseline.mean, current: current.mean, change, pValue, status };
+}
+
+function printReport(title, comparisons) {
+    const icons = { ok: '⚪', noise: '🟡', regression: '❌', improvement: '✅' };
+    const format = (value) => (value >= 100 ? value.toFixed(1) : value.toFixed(3));
+
+    console.log(`\n📋 ${title}`);
+    console.log('═'.repeat(78));
+    console.log(`${'Размер'.padEnd(8)}${'Метрика'.padEnd(12)}${'Baseline'.padStart(12)}${'Сейчас'.padStart(12)}${'Δ%'.padStart(10)}${'p'.padStart(10)}   Статус`);
+    for (const c of comparisons) {
+        const change = `${c.change >= 0 ? '+' : ''}${(c.change * 100).toFixed(1)}`;
+        console.log(
+            `${String(c.size).padEnd(8)}${c.metric.padEnd(12)}${format(c.baseline).padStart(12)}${format(c.current).padStart(12)}` +
+            `${change.padStart(10)}${(c.pValue === null ? '-' : c.pValue.toFixed(4)).padStart(10)}   ${icons[c.status]} ${c.status}`
+        );
+    }
+
+    const regressions = comparisons.filter(c => c.status === 'regression');
+    console.log('═'.repeat(78));
+    if (regressions.length > 0) {
+        console.log(`❌ Регрессий: ${regressions.length} (размеры: ${[...new Set(regressions.map(c => c.size))].join(', ')})`);
+    } else {
+        console.log('✅ Регрессий нет');
+    }
+    return regressions.length;
+}
+
+// Аргументы режима сравнения, общие для обоих CLI
+function parseCompareArg(args, i, options) {
+    const next = args[i + 1];
+    switch (args[i]) {
+        case '--compare':
+            options.compare = true;
+            // Путь к baseline необязателен: без него берется последний файл из results платформы
+            if (next && next.endsWith('.csv')) {
+                options.baselineFile = next;
+                return i + 1;
+            }
+            return i;
+        case '--trials':
+            options.trials = parseInt(next, 10);
+            return i + 1;
+        case '--threshold':
+            options.threshold = parseFloat(next) / 100;
+            return i + 1;
+        case '--alpha':
+            options.alpha = parseFloat(next);
+            return i + 1;
+        default:
+            return null;
+    }
+}
+
+const COMPARE_HELP = `
+СРАВНЕНИЕ С BASELINE:
+    --compare [file.csv]    Сравнить с baseline (по умолчанию - последний CSV метода в *_results платформы)
+    --trials N              Повторов каждого размера (по умолчанию 3)
+    --threshold P           Допустимое ухудшение, % (по умолчанию 5)
+    --alpha A               Уровень значимости теста Уэлча (по умолчанию 0.05)
+    При регрессии процесс завершается с кодом 1`;
+
+module.exports = {
+    summarize,
+    welchTest,
+    studentTSurvival,
+    loadBaselineCSV,
+    findLatestBaseline,
+    getPlatformResultsDir,
+    compareMetric,
+    printReport,
+    parseCompareArg,
+    COMPARE_HELP
+};
@@ -9,7 +9,19 @@ const config = {
     timeout: 200000,        // таймаут запросов
     cooldown: 2,            // пауза между тестами (секунды)
     warmupDuration: 5,      // длительность разогрева
+
+    // Смешанная нагрузка: параллельно с тяжелым эндпоинтом идут дешевые запросы к /simple,
+    // их латентность показывает, насколько тяжелые запросы блокируют остальные
+    mixedWorkload: false,   // включается также флагом --mixed
+    mixedConnections: 10,   // соединений для /simple
     
+    // Режим --compare: сравнение с сохраненными результатами
+    compare: {
+        trials: 3,          // повторов каждого размера
+        threshold: 0.05,    // допустимое ухудшение (5%)
+        alpha: 0.05         // уровень значимости теста Уэлча
+    },
+
     // Вывод результатов 
     outputDir: './benchmarks/raw_results/server/'       // директория для результатов
 };
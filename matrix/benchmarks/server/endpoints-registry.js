@@ -62,6 +62,16 @@ const endpointsRegistry = {
             name: 'C++ Accelerate Async',
             endpoint: ENDPOINTS.CPP.ACCELERATE_ASYNC,
             available: null
+        },
+        cached: {
+            name: 'C++ Cached',
+            endpoint: ENDPOINTS.CPP.CACHED,
+            available: null
+        },
+        'simd-abortable': {
+            name: 'C++ SIMD Abortable',
+            endpoint: ENDPOINTS.CPP.SIMD_ABORTABLE,
+            available: null
         }
     },
 
@@ -2,8 +2,20 @@
 
 const path = require('path');
 const { ServerRunner } = require('./server-runner');
-const { listAvailableEndpoints, getEndpointByKey } = require('./endpoints-registry');
+const fs = require('fs');
+const { listAvailableEndpoints, getEndpointByKey, checkEndpointAvailability } = require('./endpoints-registry');
+const { updateMatrixSize, getLatencyFile } = require('./utils');
 const config = require('./config');
+const {
+    summarize,
+    loadBaselineCSV,
+    findLatestBaseline,
+    getPlatformResultsDir,
+    compareMetric,
+    printReport,
+    parseCompareArg,
+    COMPARE_HELP
+} = require('../regression');
 
 // Парсинг аргументов командной строки
 function parseArgs() {
@@ -12,11 +24,23 @@ function parseArgs() {
         endpointKey: null,
         help: false,
         listEndpoints: false,
+        mixed: false,
+        compare: false,
+        baselineFile: null,
+        trials: config.compare.trials,
+        threshold: config.compare.threshold,
+        alpha: config.compare.alpha,
     };
 
     for (let i = 0; i < args.length; i++) {
         const arg = args[i];
 
+        const consumed = parseCompareArg(args, i, options);
+        if (consumed !== null) {
+            i = consumed;
+            continue;
+        }
+
         switch (arg) {
             case '--help':
                 options.help = true;
@@ -25,6 +49,10 @@ function parseArgs() {
             case '--endpoints':
                 options.listEndpoints = true;
                 break;
+
+            case '--mixed':
+                options.mixed = true;
+                break;
             
             default:
                 // Если аргумент не начинается с --, считаем его эндпоинтом
@@ -50,10 +78,13 @@ function showHelp() {
     npm run server-benchmark cpp.simd
     npm run server-benchmark rust.accelerate
     npm run server-benchmark --endpoints
+    npm run server-benchmark cpp.simd --compare --trials 3
 
 ОПЦИИ:
     --help, -h          Показать эту справку
     --endpoints         Показать доступные эндпоинты
+    --mixed             Параллельно нагружать /simple (латентность легких запросов под нагрузкой)
+${COMPARE_HELP}
 
 ФОРМАТЫ ЭНДПОИНТОВ:
     tech.name               Например: js.base, cpp.simd, rust.accelerate
@@ -72,6 +103,97 @@ function generateOutputFileName(options) {
     return path.resolve(config.outputDir, `${basename}_${timestamp}.csv`);
 }
 
+// Статистика RPS одного размера: по прогонам, а при одном прогоне - по посекундным замерам autocannon
+function summarizeRps(trialStats) {
+    if (trialStats.length > 1) {
+        return summarize(trialStats.map(stats => stats.avg));
+    }
+    return { mean: trialStats[0].avg, sd: trialStats[0].stddev, n: config.duration };
+}
+
+// Режим сравнения: RPS (больше - лучше) и p99 латентности (меньше - лучше), если у baseline есть _latency.csv
+// У baseline RPS есть только avg/min/max посекундных замеров, поэтому sd оценивается как (max - min) / 4
+async function runCompare(runner, options) {
+    const endpointConfig = getEndpointByKey(options.endpointKey);
+    const baselineFile = options.baselineFile || findLatestBaseline(getPlatformResultsDir('server'), options.endpointKey);
+    if (!baselineFile) {
+        console.error(`❌ Baseline для ${options.endpointKey} не найден, укажите файл: --compare <file.csv>`);
+        process.exitCode = 1;
+        return;
+    }
+    if (!(await checkEndpointAvailability(endpointConfig.endpoint))) {
+        console.error(`❌ Эндпоинт ${endpointConfig.endpoint} недоступен`);
+        process.exitCode = 1;
+        return;
+    }
+
+    const baseline = loadBaselineCSV(baselineFile);
+    const latencyFile = getLatencyFile(baselineFile);
+    const baselineLatency = fs.existsSync(latencyFile) ? loadBaselineCSV(latencyFile) : null;
+    const sizes = [...baseline.keys()];
+
+    console.log(`🎯 Сравнение с baseline:`);
+    console.log(`   • Эндпоинт: ${options.endpointKey} (${endpointConfig.name})`);
+    console.log(`   • Baseline: ${baselineFile}${baselineLatency ? ' (+ латентность)' : ''}`);
+    console.log(`   • Размеры: ${sizes.join(', ')}`);
+    console.log(`   • Прогонов на размер: ${options.trials}, порог: ${options.threshold * 100}%, alpha: ${options.alpha}\n`);
+
+    await runner.warmupServer();
+
+    const comparisons = [];
+    for (const size of sizes) {
+        await updateMatrixSize(size);
+
+        const trialStats = [];
+        for (let trial = 0; trial < options.trials; trial++) {
+            const stats = await runner.runEndpointTest(endpointConfig);
+            if (!stats.failed) {
+                trialStats.push(stats);
+            }
+        }
+        if (trialStats.length < options.trials) {
+            console.warn(`⚠️ Размер ${size}: упавших прогонов ${options.trials - trialStats.length} из ${options.trials}`);
+            process.exitCode = 1;
+        }
+        if (trialStats.length === 0) {
+            continue;
+        }
+
+        const row = baseline.get(size);
+        comparisons.push(compareMetric({
+            size,
+            metric: 'rps',
+            baseline: { mean: row.avg, sd: (row.max - row.min) / 4, n: config.duration },
+            current: summarizeRps(trialStats),
+            higherIsBetter: true,
+            threshold: options.threshold,
+            alpha: options.alpha
+        }));
+
+        // У baseline p99 - одно число без разброса, поэтому тест Уэлча опирается только на разброс прогонов;
+        // при одном прогоне его нет, и вердикт выносится только по порогу
+        const latencyRow = baselineLatency?.get(size);
+        if (latencyRow?.p99) {
+            const current = summarize(trialStats.map(stats => stats.latency.p99));
+            comparisons.push(compareMetric({
+                size,
+                metric: 'p99_ms',
+                baseline: { mean: latencyRow.p99, sd: 0, n: 1 },
+                current,
+                higherIsBetter: false,
+                threshold: options.threshold,
+                alpha: options.alpha,
+                thresholdOnly: current.n < 2
+            }));
+        }
+    }
+
+    const regressions = printReport(`${options.endpointKey} vs ${path.basename(baselineFile)}`, comparisons);
+    if (regressions > 0) {
+        process.exitCode = 1;
+    }
+}
+
 // Основная функция
 async function main() {
     const options = parseArgs();
@@ -91,6 +213,9 @@ async function main() {
     try {
         // Создаем раннер
         const runner = new ServerRunner();
+        if (options.mixed) {
+            runner.config.mixedWorkload = true;
+        }
     
         let outputFile;
         
@@ -103,6 +228,11 @@ async function main() {
                 return;
             }
             
+            if (options.compare) {
+                await runCompare(runner, options);
+                return;
+            }
+
             outputFile = generateOutputFileName(options);
                     
             console.log(`🎯 Запуск server бенчмарков:`);
@@ -1,10 +1,17 @@
 const autocannon = require('autocannon');
 const { getEndpointByKey, checkEndpointAvailability } = require('./endpoints-registry');
+const { ENDPOINTS } = require('../../utils/endpoints');
 const { 
     updateMatrixSize, 
     ensureOutputDir,
     initServerCSV,
     appendServerCSV,
+    initLatencyCSV,
+    appendLatencyCSV,
+    getLatencyFile,
+    resetEventLoopStats,
+    fetchEventLoopStats,
+    pickLatencyPercentiles,
     logMatrixSizeHeader,
     logEndpointResult
 } = require('./utils');
@@ -23,11 +30,13 @@ class ServerRunner {
         
         ensureOutputDir(this.config.outputDir);
         initServerCSV(outputFile, endpointKey);
+        initLatencyCSV(getLatencyFile(outputFile), endpointKey);
         
         console.log(`📊 Конфигурация:`);
         console.log(`   • Размеры матриц: ${this.config.matrixSizes.join(', ')}`);
         console.log(`   • Длительность теста: ${this.config.duration}s`);
         console.log(`   • Server URL: ${this.config.serverUrl}`);
+        console.log(`   • Смешанная нагрузка (/simple): ${this.config.mixedWorkload ? 'да' : 'нет'}`);
         console.log(`   • Файл результатов: ${outputFile}\n`);
     }
 
@@ -54,17 +63,34 @@ class ServerRunner {
         console.log(`  🌐 Тестируем ${name} (${endpoint})...`);
         
         try {
-            const result = await autocannon({
-                url: url,
-                duration: this.config.duration,
-                timeout: this.config.timeout
-            });
+            await resetEventLoopStats();
+
+            // В смешанном режиме /simple нагружается одновременно с тяжелым эндпоинтом
+            const [result, simpleResult] = await Promise.all([
+                autocannon({
+                    url: url,
+                    duration: this.config.duration,
+                    timeout: this.config.timeout
+                }),
+                this.config.mixedWorkload
+                    ? autocannon({
+                        url: `${this.config.serverUrl}${ENDPOINTS.SIMPLE}`,
+                        duration: this.config.duration,
+                        connections: this.config.mixedConnections,
+                        timeout: this.config.timeout
+                    })
+                    : null
+            ]);
 
             // Берём готовые статистики из autocannon
             const stats = {
                 avg: parseFloat(result.requests.average.toFixed(2)),
                 min: result.requests.min,
-                max: result.requests.max
+                max: result.requests.max,
+                stddev: result.requests.stddev,
+                latency: pickLatencyPercentiles(result.latency),
+                simpleLatency: simpleResult ? pickLatencyPercentiles(simpleResult.latency) : null,
+                eventLoop: await fetchEventLoopStats()
             };
 
             logEndpointResult(name, stats);
@@ -72,10 +98,16 @@ class ServerRunner {
             
         } catch (error) {
             console.log(`    ❌ Ошибка: ${error.message}`);
+            // Та же форма, что у успешного замера: режим сравнения отбрасывает такие прогоны по failed
             return {
                 avg: 0,
                 min: 0,
-                max: 0
+                max: 0,
+                stddev: 0,
+                latency: null,
+                simpleLatency: null,
+                eventLoop: null,
+                failed: true
             };
         }
     }
@@ -122,6 +154,7 @@ class ServerRunner {
                 
                 this.allResults[matrixSize] = results;
                 appendServerCSV(outputFile, matrixSize, results);
+                appendLatencyCSV(getLatencyFile(outputFile), matrixSize, results);
             }
             
             const duration = Math.round((Date.now() - startTime) / 1000);
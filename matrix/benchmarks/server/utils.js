@@ -2,6 +2,9 @@ const fs = require('fs');
 const path = require('path');
 const axios = require('axios');
 const config = require('./config');
+const { ENDPOINTS } = require('../../utils/endpoints');
+
+const LATENCY_PERCENTILES = ['p50', 'p90', 'p99', 'p99_9'];
 
 function convertToCSVNumber(number) {
     return number.toString().replace('.', ',');
@@ -33,6 +36,40 @@ async function updateMatrixSize(size) {
     }
 }
 
+// Сброс гистограммы задержек event loop на сервере перед тестом
+async function resetEventLoopStats() {
+    try {
+        await axios.post(`${config.serverUrl}${ENDPOINTS.EVENT_LOOP_RESET}`);
+        return true;
+    } catch (error) {
+        console.warn('  ⚠️ Не удалось сбросить статистику event loop:', error.message);
+        return false;
+    }
+}
+
+// Задержки event loop за время теста (мс), null если сервер их не отдает
+async function fetchEventLoopStats() {
+    try {
+        const response = await axios.get(`${config.serverUrl}${ENDPOINTS.EVENT_LOOP_STATS}`);
+        return response.data;
+    } catch (error) {
+        console.warn('  ⚠️ Не удалось получить статистику event loop:', error.message);
+        return null;
+    }
+}
+
+// Перцентили латентности из HDR-гистограммы autocannon (мс)
+function pickLatencyPercentiles(latency) {
+    const result = {};
+    LATENCY_PERCENTILES.forEach(p => { result[p] = latency[p]; });
+    return result;
+}
+
+// cpp_simd_2025-01-15T14-30-45.csv -> cpp_simd_2025-01-15T14-30-45_latency.csv
+function getLatencyFile(outputFile) {
+    return outputFile.replace(/\.csv$/, '_latency.csv');
+}
+
 // Создание директории для результатов
 function ensureOutputDir(outputDir) {
     if (!fs.existsSync(outputDir)) {
@@ -53,6 +90,34 @@ function initServerCSV(outputFile, endpointKey) {
     }
 }
 
+// CSV с хвостами латентности, рядом с основным (RPS)
+function initLatencyCSV(outputFile, endpointKey) {
+    if (fs.existsSync(outputFile)) {
+        return;
+    }
+
+    const cleanEndpoint = endpointKey.replace('.', '_');
+    const headers = ['matrix_size'];
+    LATENCY_PERCENTILES.forEach(p => headers.push(`${p}_${cleanEndpoint}`));
+    // Латентность /simple при смешанной нагрузке (пусто без --mixed)
+    LATENCY_PERCENTILES.forEach(p => headers.push(`simple_${p}_${cleanEndpoint}`));
+    ['mean', 'p50', 'p99', 'max'].forEach(p => headers.push(`event_loop_${p}_${cleanEndpoint}`));
+
+    fs.writeFileSync(outputFile, headers.join(';') + '\n');
+    console.log(`📊 Создан CSV файл: ${path.basename(outputFile)}`);
+}
+
+function appendLatencyCSV(outputFile, matrixSize, results) {
+    const format = (value) => (value === null || value === undefined ? '' : convertToCSVNumber(value));
+    const row = [matrixSize];
+
+    LATENCY_PERCENTILES.forEach(p => row.push(format(results.latency?.[p])));
+    LATENCY_PERCENTILES.forEach(p => row.push(format(results.simpleLatency?.[p])));
+    ['mean', 'p50', 'p99', 'max'].forEach(p => row.push(format(results.eventLoop?.[p])));
+
+    fs.appendFileSync(outputFile, row.join(';') + '\n');
+}
+
 // Добавление строки в CSV файл
 function appendServerCSV(outputFile, matrixSize, results) {
     const row = [
@@ -76,19 +141,37 @@ function logMatrixSizeHeader(matrixSize, current, total) {
 
 // Результат тестирования эндпоинта
 function logEndpointResult(endpointName, stats) {
+    const formatLatency = (latency) => LATENCY_PERCENTILES.map(p => `${p}=${latency[p]}`).join(', ');
+
     console.log(`  ✅ ${endpointName}:`);
     console.log(`     📊 RPS: avg=${stats.avg}, min=${stats.min}, max=${stats.max}`);
+    if (stats.latency) {
+        console.log(`     ⏱️ Латентность (мс): ${formatLatency(stats.latency)}`);
+    }
+    if (stats.simpleLatency) {
+        console.log(`     ⏱️ /simple параллельно (мс): ${formatLatency(stats.simpleLatency)}`);
+    }
+    if (stats.eventLoop) {
+        const el = stats.eventLoop;
+        console.log(`     🔁 Задержка event loop (мс): mean=${el.mean.toFixed(2)}, p50=${el.p50.toFixed(2)}, p99=${el.p99.toFixed(2)}, max=${el.max.toFixed(2)}`);
+    }
 }
 
 module.exports = {
     ensureOutputDir,
     initServerCSV,
     appendServerCSV,
+    initLatencyCSV,
+    appendLatencyCSV,
+    getLatencyFile,
     logMatrixSizeHeader,
     logEndpointResult,
     
     // Утилиты
     convertToCSVNumber,
     updateMatrixSize,
+    resetEventLoopStats,
+    fetchEventLoopStats,
+    pickLatencyPercentiles,
     getStabilityInfo
 };
\ No newline at end of file
@@ -11,6 +11,9 @@
             "-framework Accelerate"
           ]
         }],
+        ["OS=='linux'", {
+          "libraries": [ "-ldl" ]
+        }],
         ["OS=='linux' and target_arch=='x64'", {
           "cflags_cc": [
             "-O3",
@@ -47,6 +50,14 @@
       "target_name": "matrix",
       "sources": [ "cpp-addons/matrix.cpp" ],
       "defines": [ "NAPI_DISABLE_CPP_EXCEPTIONS" ]
+    },
+    {
+      "include_dirs" : [
+        "<!@(node -p \"require('node-addon-api').include\")"
+      ],
+      "target_name": "perf_counters",
+      "sources": [ "cpp-addons/perf_counters.cpp" ],
+      "defines": [ "NAPI_DISABLE_CPP_EXCEPTIONS" ]
     }
   ]
 }
\ No newline at end of file
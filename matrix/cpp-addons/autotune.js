@@ -0,0 +1,236 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { promisify } = require('util');
+const cppMatrix = require('bindings')('matrix');
+
+// Таблица решений хранится рядом с аддоном, путь можно переопределить через MATRIX_AUTOTUNE_FILE
+const DEFAULT_TABLE_FILE = path.join(__dirname, '..', 'autotune.json');
+// Границы корзин по каждому измерению: сетка - все формы m x k x n из этих значений
+const DEFAULT_DIMS = [16, 64, 256, 512];
+const DEFAULT_REPEATS = 3;
+
+// Кандидаты: ядро + параметры блокировки. blockCols и poolGrain передаются в каждый вызов ядра,
+// глобальная setKernelTuning не меняется - параллельные multiply() не мешают друг другу
+const BLOCK_COLS = [0, 32, 64, 128, 256];
+const POOL_GRAINS = [0, 8, 32];
+
+const KERNELS = {
+    base: { func: cppMatrix.multiplyBase, type: 'sync' },
+    simd: { func: cppMatrix.multiplySimd, type: 'sync', tunable: ['blockCols'] },
+    'simd-async': { func: cppMatrix.multiplySimdAsync && promisify(cppMatrix.multiplySimdAsync), type: 'async', tunable: ['blockCols'] },
+    'pool-async': { func: cppMatrix.multiplyPoolAsync && promisify(cppMatrix.multiplyPoolAsync), type: 'async', tunable: ['blockCols', 'poolGrain'] },
+    ...(process.platform === 'darwin' && {
+        accelerate: { func: cppMatrix.multiplyAccelerate, type: 'sync' }
+    })
+};
+
+let table = null;
+// Индекс загруженной таблицы: границы корзин по m, k, n и решения по ключу корзины
+let index = null;
+// Диск читается один раз: отсутствие таблицы тоже запоминается, иначе каждый multiply() делал бы
+// синхронный readFileSync. Перечитать - явный loadTable() или autotune()
+let tableLoaded = false;
+
+function getTableFile() {
+    return process.env.MATRIX_AUTOTUNE_FILE || DEFAULT_TABLE_FILE;
+}
+
+// Решения валидны только для той же машины и той же сборки аддона
+function getHostKey() {
+    const cpus = os.cpus();
+    return `${process.platform}-${process.arch}-${cpus[0]?.model || 'unknown'}-${cpus.length}-${process.versions.node}`;
+}
+
+function getCandidates(kernelKey) {
+    const tunable = KERNELS[kernelKey].tunable || [];
+    const candidates = [];
+    for (const blockCols of tunable.includes('blockCols') ? BLOCK_COLS : [0]) {
+        for (const poolGrain of tunable.includes('poolGrain') ? POOL_GRAINS : [0]) {
+            candidates.push({ kernel: kernelKey, blockCols, poolGrain });
+        }
+    }
+    return candidates;
+}
+
+// Настройка вызова для ядра: ядра без tunable вызываются как есть
+function getTuningArgs(entry) {
+    return KERNELS[entry.kernel].tunable ? [{ blockCols: entry.blockCols, poolGrain: entry.poolGrain }] : [];
+}
+
+async function runCandidate(candidate, A, B) {
+    const { func, type } = KERNELS[candidate.kernel];
+    const args = getTuningArgs(candidate);
+
+    const start = process.hrtime.bigint();
+    if (type === 'async') {
+        await func(A, B, ...args);
+    } else {
+        func(A, B, ...args);
+    }
+    return Number(process.hrtime.bigint() - start) / 1e6;
+}
+
+// Медиана по repeats запускам после одного прогревочного
+async function measureCandidate(candidate, A, B, repeats) {
+    await runCandidate(candidate, A, B);
+
+    const timings = [];
+    for (let r = 0; r < repeats; r++) {
+        timings.push(await runCandidate(candidate, A, B));
+    }
+    timings.sort((a, b) => a - b);
+    return timings[Math.floor(timings.length / 2)];
+}
+
+// Формы для замера: явные shapes, квадратные sizes или все сочетания dims
+function getShapes(options) {
+    if (options.shapes) {
+        return options.shapes;
+    }
+    if (options.sizes) {
+        return [...options.sizes].sort((a, b) => a - b).map(size => [size, size, size]);
+    }
+    const dims = [...(options.dims || DEFAULT_DIMS)].sort((a, b) => a - b);
+    const shapes = [];
+    for (const m of dims) {
+        for (const k of dims) {
+            for (const n of dims) {
+                shapes.push([m, k, n]);
+            }
+        }
+    }
+    return shapes;
+}
+
+// Случайная матрица rows x cols: generateMatrix умеет только квадратные
+function generateRect(rows, cols) {
+    return Array.from({ length: rows }, () => Array.from({ length: cols }, () => Math.random()));
+}
+
+/**
+ * Замеряет доступные ядра и варианты блокировки на сетке форм m x k x n и сохраняет таблицу решений
+ * @param {{ dims?: number[], sizes?: number[], shapes?: number[][], repeats?: number, kernels?: string[], file?: string, verbose?: boolean }} options
+ */
+async function autotune(options = {}) {
+    const shapes = getShapes(options);
+    const repeats = options.repeats || DEFAULT_REPEATS;
+    const kernels = (options.kernels || Object.keys(KERNELS)).filter(key => KERNELS[key]?.func);
+    const file = options.file || getTableFile();
+
+    const entries = [];
+    for (const [m, k, n] of shapes) {
+        const A = generateRect(m, k);
+        const B = generateRect(k, n);
+
+        let best = null;
+        for (const kernelKey of kernels) {
+            for (const candidate of getCandidates(kernelKey)) {
+                const ms = await measureCandidate(candidate, A, B, repeats);
+                if (!best || ms < best.ms) {
+                    best = { ...candidate, ms };
+                }
+            }
+        }
+
+        entries.push({ m, k, n, ...best });
+        if (options.verbose) {
+            console.log(`📐 ${m}x${k}x${n}: ${best.kernel} (blockCols=${best.blockCols}, poolGrain=${best.poolGrain}) - ${best.ms.toFixed(3)} ms`);
+        }
+    }
+
+    table = { host: getHostKey(), createdAt: new Date().toISOString(), entries };
+    index = buildIndex(entries);
+    tableLoaded = true;
+    fs.writeFileSync(file, JSON.stringify(table, null, 2));
+    return table;
+}
+
+function bucketKey(m, k, n) {
+    return `${m}x${k}x${n}`;
+}
+
+// Таблицы старого формата ({ size }) - квадратные формы
+function buildIndex(entries) {
+    const normalized = entries.map(entry => entry.m ? entry : { ...entry, m: entry.size, k: entry.size, n: entry.size });
+    const bounds = (field) => [...new Set(normalized.map(entry => entry[field]))].sort((a, b) => a - b);
+    return {
+        entries: normalized,
+        m: bounds('m'),
+        k: bounds('k'),
+        n: bounds('n'),
+        byKey: new Map(normalized.map(entry => [bucketKey(entry.m, entry.k, entry.n), entry]))
+    };
+}
+
+// Корзина по одному измерению - ближайшая граница сверху: 200 попадает в 256
+function bucketOf(value, bounds) {
+    return bounds.find(bound => bound >= value) ?? bounds[bounds.length - 1];
+}
+
+// Загружает таблицу с диска, если она снята на этой же машине
+function loadTable(file = getTableFile()) {
+    try {
+        const loaded = JSON.parse(fs.readFileSync(file, 'utf8'));
+        table = loaded.host === getHostKey() && Array.isArray(loaded.entries) ? loaded : null;
+    } catch {
+        table = null;
+    }
+    index = table ? buildIndex(table.entries) : null;
+    tableLoaded = true;
+    return table;
+}
+
+// Решение для корзины (m, k, n): 1000x8x1000 и 8x1000x8 - разные строки таблицы.
+// Если формы нет в сетке (таблица только из квадратов) - ближайшая по логарифмам размеров
+function selectEntry(m, k, n) {
+    if (!tableLoaded) {
+        loadTable();
+    }
+    if (!index || index.entries.length === 0) {
+        return null;
+    }
+
+    const bm = bucketOf(m, index.m), bk = bucketOf(k, index.k), bn = bucketOf(n, index.n);
+    const exact = index.byKey.get(bucketKey(bm, bk, bn));
+    if (exact) {
+        return exact;
+    }
+
+    const distance = (entry) => Math.abs(Math.log2(entry.m / bm)) + Math.abs(Math.log2(entry.k / bk)) + Math.abs(Math.log2(entry.n / bn));
+    return index.entries.reduce((best, entry) => distance(entry) < distance(best) ? entry : best);
+}
+
+/**
+ * Умножение через таблицу autotune: выбирает ядро и блокировку под размер
+ * Без таблицы - multiplySimd. Всегда возвращает Promise, т.к. победителем может быть async ядро
+ */
+async function multiply(A, B) {
+    if (A[0].length !== B.length) {
+        throw new Error("Неподходящие размеры матриц для умножения");
+    }
+
+    const entry = selectEntry(A.length, B.length, B[0].length);
+    if (!entry || !KERNELS[entry.kernel]?.func) {
+        return cppMatrix.multiplySimd(A, B);
+    }
+
+    // Настройка уходит в воркер вместе с вызовом: await другого multiply() ее уже не поменяет
+    return KERNELS[entry.kernel].func(A, B, ...getTuningArgs(entry));
+}
+
+module.exports = {
+    autotune,
+    loadTable,
+    selectEntry,
+    multiply
+};
+
+if (require.main === module) {
+    autotune({ verbose: true })
+        .then(() => console.log(`💾 Таблица сохранена: ${getTableFile()}`))
+        .catch((error) => {
+            console.error('❌ Ошибка autotune:', error.message);
+            process.exit(1);
+        });
+}
\ No newline at end of file
@@ -1,20 +1,78 @@
 #include <napi.h>
 #include "utils.cpp"
+#include "methods/content_hash.cpp"
+#include "methods/cancel_base.cpp"
+#include "methods/thread_budget_base.cpp"
 #include "methods/base.cpp"
 #include "methods/async.cpp"
 #include "methods/simd_base.cpp"
 #include "methods/simd.cpp"
 #include "methods/simd_async.cpp"
+#include "methods/compute_pool.cpp"
+#include "methods/pool.cpp"
+#include "methods/thread_budget.cpp"
+#include "methods/abortable.cpp"
+#include "methods/mapped_file.cpp"
+#include "methods/matrix_file_base.cpp"
+#include "methods/out_of_core.cpp"
+#include "methods/tuning.cpp"
 #include "methods/accelerate.cpp"
 #include "methods/accelerate_async.cpp"
+#include "methods/int8_base.cpp"
+#include "methods/int8.cpp"
+#include "methods/expr_base.cpp"
+#include "methods/shared_store_base.cpp"
+#include "methods/matrix_object.cpp"
+#include "methods/result_cache.cpp"
+#include "methods/matrix_file.cpp"
+#include "methods/shared_store.cpp"
+#include "methods/linalg_base.cpp"
+#include "methods/linalg.cpp"
 
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  auto* data = new MatrixAddonData();
+  data->matrixConstructor = Napi::Persistent(MatrixObject::Init(env));
+  env.SetInstanceData(data);
+
   exports.Set("multiplyBase", Napi::Function::New(env, MultiplyBase));
   exports.Set("multiplyAsync", Napi::Function::New(env, MultiplyAsync));
   exports.Set("multiplySimd", Napi::Function::New(env, MultiplySimd));
   exports.Set("multiplySimdAsync", Napi::Function::New(env, MultiplySimdAsync));
+  exports.Set("getSimdAsyncStats", Napi::Function::New(env, GetSimdAsyncStats));
   exports.Set("multiplyAccelerate", Napi::Function::New(env, MultiplyAccelerate));
   exports.Set("multiplyAccelerateAsync", Napi::Function::New(env, MultiplyAccelerateAsync));
+  exports.Set("multiplyPoolAsync", Napi::Function::New(env, MultiplyPoolAsync));
+  exports.Set("multiplySimdPromise", Napi::Function::New(env, MultiplySimdPromise));
+  exports.Set("multiplyPoolPromise", Napi::Function::New(env, MultiplyPoolPromise));
+  exports.Set("multiplyFilesAsync", Napi::Function::New(env, MultiplyFilesAsync));
+  exports.Set("configureComputePool", Napi::Function::New(env, ConfigureComputePoolJs));
+  exports.Set("getComputeTopology", Napi::Function::New(env, GetComputeTopology));
+  exports.Set("setThreadBudget", Napi::Function::New(env, SetThreadBudget));
+  exports.Set("getThreadConfig", Napi::Function::New(env, GetThreadConfig));
+  exports.Set("setKernelTuning", Napi::Function::New(env, SetKernelTuning));
+  exports.Set("getKernelTuning", Napi::Function::New(env, GetKernelTuning));
+  exports.Set("multiplyInt8", Napi::Function::New(env, MultiplyInt8));
+  exports.Set("Matrix", data->matrixConstructor.Value());
+  exports.Set("multiplyCached", Napi::Function::New(env, MultiplyCached));
+  exports.Set("multiplyCachedAsync", Napi::Function::New(env, MultiplyCachedAsync));
+  exports.Set("getResultCacheStats", Napi::Function::New(env, GetResultCacheStats));
+  exports.Set("configureResultCache", Napi::Function::New(env, ConfigureResultCache));
+  exports.Set("clearResultCache", Napi::Function::New(env, ClearResultCache));
+  exports.Set("saveMatrix", Napi::Function::New(env, SaveMatrix));
+  exports.Set("loadMatrix", Napi::Function::New(env, LoadMatrix));
+  exports.Set("loadMatrixData", Napi::Function::New(env, LoadMatrixData));
+  exports.Set("shareMatrix", Napi::Function::New(env, ShareMatrix));
+  exports.Set("getSharedMatrix", Napi::Function::New(env, GetSharedMatrix));
+  exports.Set("releaseSharedMatrix", Napi::Function::New(env, ReleaseSharedMatrix));
+  exports.Set("getSharedMatrixStats", Napi::Function::New(env, GetSharedMatrixStats));
+  exports.Set("lu", Napi::Function::New(env, Lu));
+  exports.Set("luAsync", Napi::Function::New(env, LuAsync));
+  exports.Set("cholesky", Napi::Function::New(env, Cholesky));
+  exports.Set("choleskyAsync", Napi::Function::New(env, CholeskyAsync));
+  exports.Set("solve", Napi::Function::New(env, Solve));
+  exports.Set("solveAsync", Napi::Function::New(env, SolveAsync));
+  exports.Set("inverse", Napi::Function::New(env, Inverse));
+  exports.Set("inverseAsync", Napi::Function::New(env, InverseAsync));
   return exports;
 }
 
@@ -0,0 +1,270 @@
+#include <napi.h>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <limits>
+
+// Promise-задачи с отменой: options { signal: AbortSignal, timeout: мс }.
+// Пока задача ждет бюджета потоков или стоит в очереди libuv, abort снимает ее оттуда (napi_cancel_async_work)
+// и поток пула не занимается;
+// если она уже считается - ядро видит флаг отмены (CancelToken) на границе панели и выходит.
+// Promise отклоняется ошибкой с name 'AbortError' (cause - signal.reason) или 'TimeoutError'
+
+static Napi::Value MakeCancelError(Napi::Env env, CancelReason reason, Napi::Value cause) {
+	const bool timeout = reason == CancelReason::Timeout;
+	Napi::Object error = Napi::Error::New(env, timeout ? "Превышено время выполнения операции" : "Операция прервана").Value();
+	error.Set("name", Napi::String::New(env, timeout ? "TimeoutError" : "AbortError"));
+	error.Set("code", Napi::String::New(env, timeout ? "ETIMEDOUT" : "ABORT_ERR"));
+	if (!cause.IsEmpty() && !cause.IsUndefined()) {
+		error.Set("cause", cause);
+	}
+	return error;
+}
+
+// AbortSignal и дедлайн одной задачи. Живет в воркере, все методы - на main thread
+class AbortBinding {
+public:
+	// { signal, timeout } из options; false - брошено исключение JS
+	bool Read(Napi::Env env, const Napi::Object& options) {
+		Napi::Value signal = options.Get("signal");
+		if (!signal.IsUndefined()) {
+			if (!signal.IsObject() || !signal.As<Napi::Object>().Get("addEventListener").IsFunction()) {
+				Napi::TypeError::New(env, "signal: ожидается AbortSignal").ThrowAsJavaScriptException();
+				return false;
+			}
+			signal_ = Napi::Persistent(signal.As<Napi::Object>());
+		}
+		Napi::Value timeout = options.Get("timeout");
+		if (!timeout.IsUndefined()) {
+			// Infinity - без дедлайна. Больше 2^31-1 мс setTimeout не умеет (сработал бы через 1 мс), NaN - не число
+			const double ms = timeout.IsNumber() ? timeout.As<Napi::Number>().DoubleValue() : -1.0;
+			if (ms == std::numeric_limits<double>::infinity()) {
+				return true;
+			}
+			if (!(ms >= 0 && ms <= kMaxTimeoutMs)) {
+				Napi::TypeError::New(env, "timeout: ожидается число миллисекунд от 0 до 2147483647 или Infinity").ThrowAsJavaScriptException();
+				return false;
+			}
+			timeoutMs_ = ms;
+			token_->SetTimeout(timeoutMs_);
+		}
+		return true;
+	}
+
+	const std::shared_ptr<CancelToken>& Token() const { return token_; }
+
+	// Сигнал сработал еще до вызова: задачу не ставим в очередь
+	bool AbortedAlready() const {
+		return !signal_.IsEmpty() && signal_.Value().Get("aborted").ToBoolean().Value();
+	}
+
+	Napi::Value Error(Napi::Env env) const {
+		const CancelReason reason = token_->Reason() == CancelReason::None ? CancelReason::Aborted : token_->Reason();
+		Napi::Value cause = !signal_.IsEmpty() && reason == CancelReason::Aborted ? signal_.Value().Get("reason") : Napi::Value();
+		return MakeCancelError(env, reason, cause);
+	}
+
+	// Подписка на 'abort' и таймер дедлайна после постановки: дедлайн ядро видит само, а таймер нужен,
+	// чтобы снять задачу, которая все еще ждет бюджета или очереди libuv. onDequeued вызывается, если задачу
+	// удалось снять из очереди: тогда ни OnOK, ни OnError не будет, и Promise отклоняет он
+	void Attach(Napi::Env env, napi_async_work work, ThreadSlot* slot, std::function<void(Napi::Env)> onDequeued) {
+		std::shared_ptr<CancelToken> token = token_;
+		auto canceller = [env, token, work, slot, onDequeued](CancelReason reason) {
+			return Napi::Function::New(env, [token, work, slot, onDequeued, reason](const Napi::CallbackInfo& info) {
+				token->Cancel(reason);
+				// Ждущая бюджета задача уходит из очереди гейта сразу в libuv и тут же снимается оттуда:
+				// единиц она не брала, а отклонение идет тем же путем, что и для очереди libuv
+				slot->CancelWait();
+				if (napi_cancel_async_work(info.Env(), work) == napi_ok) {
+					onDequeued(info.Env());
+				}
+			});
+		};
+
+		if (!signal_.IsEmpty()) {
+			listener_ = Napi::Persistent(canceller(CancelReason::Aborted));
+			Napi::Object once = Napi::Object::New(env);
+			once.Set("once", Napi::Boolean::New(env, true));
+			Napi::Object signal = signal_.Value();
+			signal.Get("addEventListener").As<Napi::Function>().Call(signal, { Napi::String::New(env, "abort"), listener_.Value(), once });
+		}
+		if (timeoutMs_ >= 0) {
+			Napi::Function setTimeout = env.Global().Get("setTimeout").As<Napi::Function>();
+			timer_ = Napi::Persistent(setTimeout.Call({ canceller(CancelReason::Timeout), Napi::Number::New(env, timeoutMs_) }));
+		}
+	}
+
+	// Из OnOK/OnError: долгоживущий signal не должен держать слушателя завершенной задачи, а таймер - event loop
+	void Detach() {
+		if (!listener_.IsEmpty()) {
+			Napi::Env env = listener_.Env();
+			Napi::Object signal = signal_.Value();
+			signal.Get("removeEventListener").As<Napi::Function>().Call(signal, { Napi::String::New(env, "abort"), listener_.Value() });
+			listener_.Reset();
+		}
+		if (!timer_.IsEmpty()) {
+			Napi::Env env = timer_.Env();
+			env.Global().Get("clearTimeout").As<Napi::Function>().Call({ timer_.Value() });
+			timer_.Reset();
+		}
+	}
+
+private:
+	static constexpr double kMaxTimeoutMs = 2147483647.0;
+
+	std::shared_ptr<CancelToken> token_ = std::make_shared<CancelToken>();
+	double timeoutMs_ = -1.0;
+	Napi::ObjectReference signal_;
+	Napi::FunctionReference listener_;
+	Napi::Reference<Napi::Value> timer_;
+};
+
+static Napi::Value RejectedPromise(Napi::Env env, Napi::Value error) {
+	Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+	deferred.Reject(error);
+	return deferred.Promise();
+}
+
+// Постановка Promise-воркера через бюджет потоков с подпиской на signal;
+// у Worker - Promise(), Abort(), Reject() и Slot()
+template <typename Worker>
+static Napi::Value QueueAbortable(Napi::Env env, Worker* worker, size_t units) {
+	Napi::Promise promise = worker->Promise();
+	QueueWithBudget(env, worker, units);
+	worker->Abort().Attach(env, *worker, &worker->Slot(), [worker](Napi::Env env) {
+		Napi::HandleScope scope(env);
+		worker->Abort().Detach();
+		worker->Reject(worker->Abort().Error(env));
+	});
+	return promise;
+}
+
+// Полоса SIMD-ядра - примерно 4M умножений-сложений (~1 мс), между полосами проверяется отмена
+static bool SimdMatmulCancellable(const double* A, const double* BT, size_t m, size_t k, size_t n, double* C, const CancelToken& cancel) {
+	const size_t panelRows = std::max<size_t>(1, ((size_t)1 << 22) / std::max<size_t>(1, k * n));
+	for (size_t i = 0; i < m; i += panelRows) {
+		if (cancel.Cancelled()) {
+			return false;
+		}
+		SimdMatmulRowRange(A, BT, k, n, i, std::min(m, i + panelRows), C);
+	}
+	return true;
+}
+
+enum class AbortableKernel { Simd, Pool };
+
+class AbortableMultiplyWorker : public Napi::AsyncWorker {
+public:
+	AbortableMultiplyWorker(
+		Napi::Env env,
+		AbortableKernel kernel,
+		std::vector<double>&& A_rowMajor,
+		std::vector<double>&& BT_rowMajor,
+		size_t m, size_t k, size_t n,
+		AbortBinding&& abort)
+	: Napi::AsyncWorker(env),
+	deferred_(Napi::Promise::Deferred::New(env)),
+	abort_(std::move(abort)),
+	kernel_(kernel),
+	A_(std::move(A_rowMajor)),
+	BT_(std::move(BT_rowMajor)),
+	m_(m), k_(k), n_(n) {}
+
+	Napi::Promise Promise() const { return deferred_.Promise(); }
+	AbortBinding& Abort() { return abort_; }
+	void Reject(Napi::Value error) { deferred_.Reject(error); }
+	ThreadSlot& Slot() { return slot_; }
+
+	void Execute() override {
+		ThreadSlot::Hold hold(slot_);
+		const CancelToken& cancel = *abort_.Token();
+		// Задача могла дождаться потока уже отмененной: тогда сразу отдаем бюджет и не занимаем ядра
+		if (cancel.Cancelled()) {
+			SetError("cancelled");
+			return;
+		}
+
+		if (kernel_ == AbortableKernel::Pool) {
+			poolResult_ = NumaMatmul(*GetComputePool(), A_.data(), BT_, m_, k_, n_, &cancel);
+		} else {
+			C_.resize(m_ * n_);
+			SimdMatmulCancellable(A_.data(), BT_.data(), m_, k_, n_, C_.data(), cancel);
+		}
+		if (cancel.Cancelled()) {
+			SetError("cancelled");
+		}
+	}
+
+	void OnOK() override {
+		Napi::Env env = Env();
+		Napi::HandleScope scope(env);
+		abort_.Detach();
+		deferred_.Resolve(kernel_ == AbortableKernel::Pool ? NumaResultToJs(env, poolResult_, m_, n_) : RowMajorToJs(env, C_, m_, n_));
+	}
+
+	void OnError(const Napi::Error& e) override {
+		Napi::Env env = Env();
+		abort_.Detach();
+		deferred_.Reject(abort_.Token()->Reason() != CancelReason::None ? abort_.Error(env) : e.Value());
+	}
+
+private:
+	Napi::Promise::Deferred deferred_;
+	AbortBinding abort_;
+	AbortableKernel kernel_;
+	std::vector<double> A_, BT_, C_;
+	NumaMatmulResult poolResult_;
+	size_t m_, k_, n_;
+	ThreadSlot slot_;
+};
+
+static Napi::Value RunAbortableMultiply(const Napi::CallbackInfo& info, AbortableKernel kernel) {
+	Napi::Env env = info.Env();
+
+	if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsArray()) {
+		Napi::TypeError::New(env, "Ожидается 2 матрицы: matrixA, matrixB[, { signal, timeout }]").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	Napi::Array Ajs = info[0].As<Napi::Array>();
+	Napi::Array Bjs = info[1].As<Napi::Array>();
+
+	size_t m, k, k2, n;
+	if (!ReadShape(Ajs, m, k) || !ReadShape(Bjs, k2, n) || k == 0 || n == 0 || k2 != k) {
+		Napi::TypeError::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	AbortBinding options;
+	if (info.Length() > 2 && !info[2].IsUndefined()) {
+		if (!info[2].IsObject()) {
+			Napi::TypeError::New(env, "Ожидается объект { signal, timeout }").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		if (!options.Read(env, info[2].As<Napi::Object>())) {
+			return env.Null();
+		}
+	}
+	if (options.AbortedAlready()) {
+		return RejectedPromise(env, options.Error(env));
+	}
+
+	std::vector<double> A_rm, B_rm, BT_rm;
+	FlattenRowMajor(Ajs, m, k, A_rm);
+	FlattenRowMajor(Bjs, k, n, B_rm);
+	TransposeRowMajor(B_rm, k, n, BT_rm);
+
+	auto* worker = new AbortableMultiplyWorker(env, kernel, std::move(A_rm), std::move(BT_rm), m, k, n, std::move(options));
+	return QueueAbortable(env, worker, kernel == AbortableKernel::Pool ? GetComputePool()->ThreadCount() : 1);
+}
+
+// multiplySimdPromise(A, B[, { signal, timeout }]) -> Promise<number[][]>
+Napi::Value MultiplySimdPromise(const Napi::CallbackInfo& info) {
+	return RunAbortableMultiply(info, AbortableKernel::Simd);
+}
+
+// multiplyPoolPromise(A, B[, { signal, timeout }]) -> Promise<number[][]>
+Napi::Value MultiplyPoolPromise(const Napi::CallbackInfo& info) {
+	return RunAbortableMultiply(info, AbortableKernel::Pool);
+}
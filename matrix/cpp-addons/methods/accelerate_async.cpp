@@ -19,7 +19,10 @@ public:
 	C_(m * n),
 	m_(m), k_(k), n_(n) {}
 
+	ThreadSlot& Slot() { return slot_; }
+
 	void Execute() override {
+		ThreadSlot::Hold hold(slot_);
 	#ifndef ACCELERATE_AVAILABLE
 		SetError("Accelerate framework недоступен на этой платформе.");
 		return;
@@ -49,6 +52,7 @@ public:
 private:
 	std::vector<double> A_, B_, C_;
 	size_t m_, k_, n_;
+	ThreadSlot slot_;
 };
 
 Napi::Value MultiplyAccelerateAsync(const Napi::CallbackInfo& info) {
@@ -85,7 +89,8 @@ Napi::Value MultiplyAccelerateAsync(const Napi::CallbackInfo& info) {
     FlattenToColMajor(Bjs, k, n, Bflat);
 
     auto* worker = new AccelerateMultiplyWorker(cb, std::move(Aflat), std::move(Bflat), m, k, n);
-    worker->Queue();
+    // Один вызов BLAS занимает blasThreads потоков (см. setThreadBudget)
+    QueueWithBudget(env, worker, BlasThreads());
 
     return env.Undefined();
 }
\ No newline at end of file
@@ -34,7 +34,10 @@ public:
         const std::vector<std::vector<double>>& b)
     : Napi::AsyncWorker(callback), a(a), b(b) {}
 
+    ThreadSlot& Slot() { return slot; }
+
     void Execute() override {
+        ThreadSlot::Hold hold(slot);
         if (!BasicMultiply(a, b, result)) {
             SetError("Неверные размеры матриц");
         }
@@ -51,6 +54,7 @@ public:
 
 private:
     std::vector<std::vector<double>> a, b, result;
+    ThreadSlot slot;
 };
 
 Napi::Value MultiplyAsync(const Napi::CallbackInfo& info) {
@@ -66,7 +70,7 @@ Napi::Value MultiplyAsync(const Napi::CallbackInfo& info) {
     std::vector<std::vector<double>> b = JsArrayToMatrix(info[1].As<Napi::Array>());
   
     MultiplyWorker* worker = new MultiplyWorker(callback, a, b);
-    worker->Queue();
+    QueueWithBudget(env, worker, 1);
   
     return env.Undefined();
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include <atomic>
+#include <chrono>
+
+enum class CancelReason : int { None = 0, Aborted = 1, Timeout = 2 };
+
+// Флаг отмены async-задачи. Ставится из main thread (AbortSignal) или срабатывает по дедлайну;
+// ядра проверяют его между панелями, поэтому отмена останавливает вычисление за миллисекунды.
+// Проверка - atomic load и steady_clock::now() (vDSO), на фоне панели GEMM незаметна
+class CancelToken {
+public:
+	// Только до постановки задачи в очередь
+	void SetTimeout(double ms) {
+		deadline_ = std::chrono::steady_clock::now()
+			+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(ms));
+		hasDeadline_ = true;
+	}
+
+	// Первая причина остается: abort после дедлайна не превращает TimeoutError в AbortError
+	void Cancel(CancelReason reason) {
+		int expected = (int)CancelReason::None;
+		reason_.compare_exchange_strong(expected, (int)reason);
+	}
+
+	bool Cancelled() const {
+		if (reason_.load(std::memory_order_relaxed) != (int)CancelReason::None) {
+			return true;
+		}
+		if (hasDeadline_ && std::chrono::steady_clock::now() >= deadline_) {
+			int expected = (int)CancelReason::None;
+			reason_.compare_exchange_strong(expected, (int)CancelReason::Timeout);
+			return true;
+		}
+		return false;
+	}
+
+	CancelReason Reason() const {
+		return (CancelReason)reason_.load(std::memory_order_relaxed);
+	}
+
+private:
+	mutable std::atomic<int> reason_{ (int)CancelReason::None };
+	bool hasDeadline_ = false;
+	std::chrono::steady_clock::time_point deadline_;
+};
+
+static bool IsCancelled(const CancelToken* cancel) {
+	return cancel != nullptr && cancel->Cancelled();
+}
@@ -0,0 +1,467 @@
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <atomic>
+
+#ifdef __linux__
+	#include <sched.h>
+	#include <dlfcn.h>
+	#include <dirent.h>
+#endif
+
+// ========================== Топология ==========================
+
+struct NumaNodeInfo {
+	int id;
+	std::vector<int> cpus;
+};
+
+// "0-3,8-11" -> [0, 1, 2, 3, 8, 9, 10, 11]
+static std::vector<int> ParseCpuList(const std::string& list) {
+	std::vector<int> cpus;
+	std::stringstream ss(list);
+	std::string part;
+	while (std::getline(ss, part, ',')) {
+		if (part.empty() || part == "\n") {
+			continue;
+		}
+		size_t dash = part.find('-');
+		int from = std::atoi(part.c_str());
+		int to = dash == std::string::npos ? from : std::atoi(part.c_str() + dash + 1);
+		for (int c = from; c <= to; ++c) {
+			cpus.push_back(c);
+		}
+	}
+	return cpus;
+}
+
+// Linux: узлы из /sys/devices/system/node, иначе - один узел на все ядра
+static std::vector<NumaNodeInfo> DetectNumaTopology() {
+	std::vector<NumaNodeInfo> nodes;
+
+#ifdef __linux__
+	if (DIR* dir = opendir("/sys/devices/system/node")) {
+		while (dirent* entry = readdir(dir)) {
+			if (std::strncmp(entry->d_name, "node", 4) != 0 || entry->d_name[4] < '0' || entry->d_name[4] > '9') {
+				continue;
+			}
+			std::ifstream in(std::string("/sys/devices/system/node/") + entry->d_name + "/cpulist");
+			std::string list;
+			std::getline(in, list);
+			std::vector<int> cpus = ParseCpuList(list);
+			if (!cpus.empty()) {
+				nodes.push_back({ std::atoi(entry->d_name + 4), std::move(cpus) });
+			}
+		}
+		closedir(dir);
+	}
+	std::sort(nodes.begin(), nodes.end(), [](const NumaNodeInfo& a, const NumaNodeInfo& b) { return a.id < b.id; });
+#endif
+
+	if (nodes.empty()) {
+		NumaNodeInfo single{ 0, {} };
+		const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+		for (unsigned c = 0; c < hw; ++c) {
+			single.cpus.push_back((int)c);
+		}
+		nodes.push_back(std::move(single));
+	}
+	return nodes;
+}
+
+// libnuma подгружаем через dlopen: аддон собирается и работает и без нее (тогда - first-touch)
+struct LibNuma {
+	bool loaded = false;
+	void* (*allocOnNode)(size_t, int) = nullptr;
+	void (*free)(void*, size_t) = nullptr;
+};
+
+static const LibNuma& GetLibNuma() {
+	static const LibNuma lib = [] {
+		LibNuma l;
+#ifdef __linux__
+		void* handle = dlopen("libnuma.so.1", RTLD_NOW | RTLD_LOCAL);
+		if (!handle) {
+			return l;
+		}
+		auto available = (int (*)())dlsym(handle, "numa_available");
+		l.allocOnNode = (void* (*)(size_t, int))dlsym(handle, "numa_alloc_onnode");
+		l.free = (void (*)(void*, size_t))dlsym(handle, "numa_free");
+		l.loaded = available && l.allocOnNode && l.free && available() >= 0;
+#endif
+		return l;
+	}();
+	return lib;
+}
+
+// Буфер double, размещенный на заданном NUMA-узле (libnuma) или обычный (тогда узел определит first-touch)
+class NumaBuffer {
+public:
+	NumaBuffer() = default;
+	NumaBuffer(const NumaBuffer&) = delete;
+	NumaBuffer& operator=(const NumaBuffer&) = delete;
+	NumaBuffer(NumaBuffer&& other) noexcept { *this = std::move(other); }
+	NumaBuffer& operator=(NumaBuffer&& other) noexcept {
+		std::swap(data_, other.data_);
+		std::swap(count_, other.count_);
+		std::swap(numa_, other.numa_);
+		return *this;
+	}
+	~NumaBuffer() { Release(); }
+
+	void Allocate(size_t count, int nodeId, bool useLibNuma) {
+		Release();
+		count_ = count;
+		const LibNuma& lib = GetLibNuma();
+		if (useLibNuma && lib.loaded) {
+			data_ = static_cast<double*>(lib.allocOnNode(count * sizeof(double), nodeId));
+			numa_ = data_ != nullptr;
+		}
+		if (!data_) {
+			// Память не трогаем: страницы достанутся узлу потока, который первым в них запишет
+			data_ = static_cast<double*>(std::malloc(count * sizeof(double)));
+		}
+	}
+
+	double* Data() const { return data_; }
+	size_t Size() const { return count_; }
+
+private:
+	void Release() {
+		if (!data_) {
+			return;
+		}
+		if (numa_) {
+			GetLibNuma().free(data_, count_ * sizeof(double));
+		} else {
+			std::free(data_);
+		}
+		data_ = nullptr;
+		count_ = 0;
+		numa_ = false;
+	}
+
+	double* data_ = nullptr;
+	size_t count_ = 0;
+	bool numa_ = false;
+};
+
+// ========================== Пул ==========================
+
+// Сколько потоков получит каждый узел: пропорционально числу его ядер, остаток от округления вниз -
+// узлам с наибольшей дробной частью (метод наибольших остатков), сумма ровно threads
+static std::vector<size_t> SplitThreadsByNodes(const std::vector<NumaNodeInfo>& topology, size_t threads, size_t totalCpus) {
+	std::vector<size_t> quota(topology.size());
+	std::vector<size_t> order(topology.size());
+	size_t assigned = 0;
+	for (size_t i = 0; i < topology.size(); ++i) {
+		quota[i] = threads * topology[i].cpus.size() / totalCpus;
+		assigned += quota[i];
+		order[i] = i;
+	}
+	auto remainder = [&](size_t i) { return threads * topology[i].cpus.size() % totalCpus; };
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return remainder(a) > remainder(b); });
+	for (size_t r = 0; assigned < threads; ++r, ++assigned) {
+		++quota[order[r]];
+	}
+	return quota;
+}
+
+struct PoolConfig {
+	size_t threads = 0;  // 0 - по числу ядер
+	bool pin = false;    // привязка потоков к ядрам (sched_setaffinity)
+	bool numa = true;    // размещать буферы через libnuma, если она есть
+};
+
+// Пул потоков с очередью на каждый NUMA-узел
+// Задачи кладутся в очередь узла, где лежат их данные; простаивающий поток может украсть
+// задачу у чужого узла, кроме задач, привязанных к узлу (first-touch подготовка буферов)
+class ComputePool {
+public:
+	explicit ComputePool(const PoolConfig& config)
+	: config_(config), topology_(DetectNumaTopology()) {
+		size_t totalCpus = 0;
+		for (const NumaNodeInfo& node : topology_) {
+			totalCpus += node.cpus.size();
+		}
+		const size_t threads = config_.threads > 0 ? config_.threads : totalCpus;
+
+		for (size_t i = 0; i < topology_.size(); ++i) {
+			nodes_.push_back(std::make_unique<NodeQueue>());
+		}
+
+		// Потоки раздаем узлам пропорционально числу их ядер, а порядок чередует узлы (плавный
+		// weighted round-robin): при любом threads каждый узел получает свою долю, а не узел 0 - все подряд.
+		// Ядра внутри узла - по кругу
+		const std::vector<size_t> quota = SplitThreadsByNodes(topology_, threads, totalCpus);
+		std::vector<long long> credit(topology_.size(), 0);
+		Latch started;
+		for (size_t t = 0; t < threads; ++t) {
+			size_t nodeIndex = 0;
+			for (size_t i = 0; i < topology_.size(); ++i) {
+				credit[i] += (long long)quota[i];
+				if (credit[i] > credit[nodeIndex]) {
+					nodeIndex = i;
+				}
+			}
+			credit[nodeIndex] -= (long long)threads;
+
+			const std::vector<int>& cpus = topology_[nodeIndex].cpus;
+			const int cpu = cpus[nodes_[nodeIndex]->workers++ % cpus.size()];
+			started.Add();
+			threads_.emplace_back([this, nodeIndex, cpu, &started] { WorkerLoop(nodeIndex, cpu, started); });
+		}
+		// Ждем, пока потоки попробуют привязаться к ядрам: getComputeTopology сразу после
+		// configureComputePool должен видеть итог привязки
+		started.Wait();
+	}
+
+	~ComputePool() {
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex_);
+			stop_ = true;
+		}
+		sleepCv_.notify_all();
+		for (std::thread& t : threads_) {
+			t.join();
+		}
+	}
+
+	const PoolConfig& Config() const { return config_; }
+	const std::vector<NumaNodeInfo>& Topology() const { return topology_; }
+	size_t NodeCount() const { return nodes_.size(); }
+	size_t ThreadCount() const { return threads_.size(); }
+	size_t WorkersOnNode(size_t nodeIndex) const { return nodes_[nodeIndex]->workers; }
+	int NodeId(size_t nodeIndex) const { return topology_[nodeIndex].id; }
+	// Потоки, которые не удалось привязать к ядру (например, ядро вне cpuset контейнера), и errno первой ошибки
+	size_t PinFailures() const { return pinFailures_.load(); }
+	int PinErrno() const { return pinErrno_.load(); }
+	bool UsesLibNuma() const { return config_.numa && GetLibNuma().loaded; }
+
+	// Делим [0, total) на непрерывные диапазоны узлов пропорционально числу их потоков
+	// bounds[i]..bounds[i + 1] - строки узла i
+	std::vector<size_t> SplitByNodes(size_t total) const {
+		std::vector<size_t> bounds(nodes_.size() + 1, 0);
+		size_t acc = 0;
+		for (size_t i = 0; i < nodes_.size(); ++i) {
+			acc += nodes_[i]->workers;
+			bounds[i + 1] = total * acc / threads_.size();
+		}
+		return bounds;
+	}
+
+	// fn(nodeIndex, begin, end) по кускам grain в пределах диапазонов узлов, блокирует до завершения
+	void ParallelForNodes(const std::vector<size_t>& bounds, size_t grain,
+		const std::function<void(size_t, size_t, size_t)>& fn) {
+		grain = std::max<size_t>(grain, 1);
+		Latch latch;
+		for (size_t node = 0; node + 1 < bounds.size(); ++node) {
+			for (size_t b = bounds[node]; b < bounds[node + 1]; b += grain) {
+				const size_t e = std::min(b + grain, bounds[node + 1]);
+				latch.Add();
+				Push(node, true, [&fn, &latch, node, b, e] {
+					fn(node, b, e);
+					latch.Done();
+				});
+			}
+		}
+		latch.Wait();
+	}
+
+	// fn(nodeIndex) ровно один раз на потоке каждого узла - для first-touch размещения буферов
+	void RunOnEachNode(const std::function<void(size_t)>& fn) {
+		Latch latch;
+		for (size_t node = 0; node < nodes_.size(); ++node) {
+			if (nodes_[node]->workers == 0) {
+				fn(node);
+				continue;
+			}
+			latch.Add();
+			Push(node, false, [&fn, &latch, node] {
+				fn(node);
+				latch.Done();
+			});
+		}
+		latch.Wait();
+	}
+
+private:
+	struct Task {
+		std::function<void()> fn;
+		bool stealable;
+	};
+
+	struct NodeQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+		size_t workers = 0;
+	};
+
+	struct Latch {
+		std::mutex mutex;
+		std::condition_variable cv;
+		size_t remaining = 0;
+
+		void Add() {
+			std::lock_guard<std::mutex> lock(mutex);
+			++remaining;
+		}
+		void Done() {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--remaining == 0) {
+				cv.notify_all();
+			}
+		}
+		void Wait() {
+			std::unique_lock<std::mutex> lock(mutex);
+			cv.wait(lock, [this] { return remaining == 0; });
+		}
+	};
+
+	void Push(size_t nodeIndex, bool stealable, std::function<void()> fn) {
+		// Узел без потоков (threads < числа узлов) - отдаем задачу узлу, где потоки есть
+		if (nodes_[nodeIndex]->workers == 0) {
+			stealable = true;
+		}
+		{
+			std::lock_guard<std::mutex> lock(nodes_[nodeIndex]->mutex);
+			nodes_[nodeIndex]->tasks.push_back({ std::move(fn), stealable });
+		}
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		sleepCv_.notify_all();
+	}
+
+	bool TryPopLocal(size_t nodeIndex, Task& task) {
+		NodeQueue& q = *nodes_[nodeIndex];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		if (q.tasks.empty()) {
+			return false;
+		}
+		task = std::move(q.tasks.front());
+		q.tasks.pop_front();
+		return true;
+	}
+
+	bool TrySteal(size_t nodeIndex, Task& task) {
+		for (size_t d = 1; d < nodes_.size(); ++d) {
+			NodeQueue& q = *nodes_[(nodeIndex + d) % nodes_.size()];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			// Крадем с конца, чтобы не конкурировать с владельцем за соседние строки
+			if (!q.tasks.empty() && q.tasks.back().stealable) {
+				task = std::move(q.tasks.back());
+				q.tasks.pop_back();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool HasWork(size_t nodeIndex) {
+		for (size_t d = 0; d < nodes_.size(); ++d) {
+			NodeQueue& q = *nodes_[(nodeIndex + d) % nodes_.size()];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (!q.tasks.empty() && (d == 0 || q.tasks.back().stealable)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void WorkerLoop(size_t nodeIndex, int cpu, Latch& started) {
+#ifdef __linux__
+		if (config_.pin) {
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+				int expected = 0;
+				pinErrno_.compare_exchange_strong(expected, errno);
+				++pinFailures_;
+			}
+		}
+#else
+		(void)cpu;
+#endif
+		started.Done();
+
+		Task task;
+		while (true) {
+			if (TryPopLocal(nodeIndex, task) || TrySteal(nodeIndex, task)) {
+				task.fn();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleepMutex_);
+			sleepCv_.wait(lock, [this, nodeIndex] { return stop_ || HasWork(nodeIndex); });
+			if (stop_ && !HasWork(nodeIndex)) {
+				return;
+			}
+		}
+	}
+
+	PoolConfig config_;
+	std::vector<NumaNodeInfo> topology_;
+	std::vector<std::unique_ptr<NodeQueue>> nodes_;
+	std::vector<std::thread> threads_;
+	std::mutex sleepMutex_;
+	std::condition_variable sleepCv_;
+	bool stop_ = false;
+	std::atomic<size_t> pinFailures_{ 0 };
+	std::atomic<int> pinErrno_{ 0 };
+};
+
+// Пул общий на процесс и создается лениво. Задача держит shared_ptr, поэтому
+// переконфигурация не ломает уже идущие вычисления: старый пул умрет после них
+static std::mutex gComputePoolMutex;
+static PoolConfig gComputePoolConfig;
+static std::shared_ptr<ComputePool> gComputePool;
+
+std::shared_ptr<ComputePool> GetComputePool() {
+	std::lock_guard<std::mutex> lock(gComputePoolMutex);
+	if (!gComputePool) {
+		gComputePool = std::make_shared<ComputePool>(gComputePoolConfig);
+	}
+	return gComputePool;
+}
+
+void ConfigureComputePool(const PoolConfig& config) {
+	std::shared_ptr<ComputePool> old;
+	{
+		std::lock_guard<std::mutex> lock(gComputePoolMutex);
+		gComputePoolConfig = config;
+		old = std::move(gComputePool);
+	}
+	// old освобождается здесь, вне мьютекса (join потоков может ждать текущие задачи)
+}
+
+// Trailing update для LU/Cholesky и других крупных GEMM: строки C делятся между потоками пула
+void ParallelGemmAccumulate(
+	const double* A, size_t lda,
+	const double* BT, size_t ldb,
+	size_t rows, size_t k, size_t n,
+	double alpha,
+	double* C, size_t ldc)
+{
+	// Мелкие обновления дешевле посчитать на месте, чем раздавать по потокам
+	if (rows * n * k < (size_t)1 << 18 || rows < 2) {
+		SimdGemmAccumulate(A, lda, BT, ldb, rows, k, n, alpha, C, ldc);
+		return;
+	}
+
+	std::shared_ptr<ComputePool> pool = GetComputePool();
+	const size_t grain = std::max<size_t>(1, rows / (pool->ThreadCount() * 4));
+	pool->ParallelForNodes(pool->SplitByNodes(rows), grain, [&](size_t, size_t b, size_t e) {
+		SimdGemmAccumulate(A + b * lda, lda, BT, ldb, e - b, k, n, alpha, C + b * ldc, ldc);
+	});
+}
\ No newline at end of file
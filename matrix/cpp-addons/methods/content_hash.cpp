@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 128-битный хеш содержимого: ключ кеша результатов и склейки одинаковых async-задач
+struct ContentHash {
+	uint64_t lo = 0;
+	uint64_t hi = 0;
+
+	bool operator==(const ContentHash& other) const { return lo == other.lo && hi == other.hi; }
+};
+
+static constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t kHashPrime3 = 0x165667B19E3779F9ULL;
+
+static inline uint64_t HashRotl(uint64_t x, int r) {
+	return (x << r) | (x >> (64 - r));
+}
+
+// Раунд xxHash64
+static inline uint64_t HashRound(uint64_t acc, uint64_t input) {
+	acc += input * kHashPrime2;
+	acc = HashRotl(acc, 31);
+	return acc * kHashPrime1;
+}
+
+static inline uint64_t HashAvalanche(uint64_t h) {
+	h ^= h >> 33;
+	h *= kHashPrime2;
+	h ^= h >> 29;
+	h *= kHashPrime3;
+	h ^= h >> 32;
+	return h;
+}
+
+// Оптимизация: 4 независимые полосы - умножения не ждут друг друга, скорость упирается в память.
+// Обе половины 128-битного хеша собираются из одного прохода по данным (256 бит состояния)
+static ContentHash HashDoubles(const double* data, size_t count) {
+	uint64_t v[4] = { kHashPrime1 + kHashPrime2, kHashPrime2, 0, 0 - kHashPrime1 };
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		for (size_t lane = 0; lane < 4; ++lane) {
+			uint64_t word;
+			std::memcpy(&word, data + i + lane, sizeof(word));
+			v[lane] = HashRound(v[lane], word);
+		}
+	}
+
+	uint64_t tail = kHashPrime3;
+	for (; i < count; ++i) {
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(word));
+		tail = HashRound(tail, word);
+	}
+
+	const uint64_t length = (uint64_t)count * sizeof(double);
+	ContentHash h;
+	h.lo = HashAvalanche((HashRotl(v[0], 1) + HashRotl(v[1], 7) + HashRotl(v[2], 12) + HashRotl(v[3], 18)) ^ tail ^ length);
+	h.hi = HashAvalanche((v[0] * kHashPrime3) ^ HashRotl(v[1], 23) ^ (v[2] * kHashPrime1) ^ HashRotl(v[3], 41) ^ HashRotl(tail, 11) ^ (length * kHashPrime2));
+	return h;
+}
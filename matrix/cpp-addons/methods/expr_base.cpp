@@ -0,0 +1,198 @@
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+
+// Плотная матрица row-major. Неизменяемая после создания, поэтому ее можно
+// безопасно разделять между JS-объектами и воркерами через shared_ptr
+struct MatrixData {
+	size_t rows = 0;
+	size_t cols = 0;
+	std::vector<double> values;
+
+	// Данные вне values (отображенный файл): storage держит владельца, external указывает на данные
+	const double* external = nullptr;
+	std::shared_ptr<const void> storage;
+
+	const double* Data() const { return external ? external : values.data(); }
+	size_t Size() const { return rows * cols; }
+
+	// Хеш содержимого считается лениво и один раз: данные после создания не меняются
+	mutable std::once_flag hashOnce;
+	mutable std::atomic<bool> hashReady{ false };
+	mutable ContentHash hash;
+};
+
+static const ContentHash& MatrixContentHash(const MatrixData& data) {
+	std::call_once(data.hashOnce, [&data] {
+		data.hash = HashDoubles(data.Data(), data.Size());
+		data.hashReady.store(true, std::memory_order_release);
+	});
+	return data.hash;
+}
+
+using MatrixDataPtr = std::shared_ptr<const MatrixData>;
+
+enum class ExprOp {
+	Leaf,    // готовая матрица
+	MatMul,  // lhs * rhs
+	Add,     // lhs + rhs (поэлементно)
+	Scale,   // lhs * scalar
+	Relu     // max(lhs, 0)
+};
+
+struct ExprNode;
+using ExprNodePtr = std::shared_ptr<const ExprNode>;
+
+// Узел ленивого выражения. Дерево неизменяемо: A.mul(B).add(C) не трогает A, B и C
+struct ExprNode {
+	ExprOp op = ExprOp::Leaf;
+	size_t rows = 0;
+	size_t cols = 0;
+	MatrixDataPtr leaf;
+	ExprNodePtr lhs, rhs;
+	double scalar = 0.0;
+};
+
+static ExprNodePtr MakeLeafNode(MatrixDataPtr data) {
+	auto node = std::make_shared<ExprNode>();
+	node->op = ExprOp::Leaf;
+	node->rows = data->rows;
+	node->cols = data->cols;
+	node->leaf = std::move(data);
+	return node;
+}
+
+static ExprNodePtr MakeExprNode(ExprOp op, ExprNodePtr lhs, ExprNodePtr rhs, double scalar = 0.0) {
+	auto node = std::make_shared<ExprNode>();
+	node->op = op;
+	node->rows = lhs->rows;
+	node->cols = op == ExprOp::MatMul ? rhs->cols : lhs->cols;
+	node->lhs = std::move(lhs);
+	node->rhs = std::move(rhs);
+	node->scalar = scalar;
+	return node;
+}
+
+// Поэлементная операция эпилога
+struct EpilogueOp {
+	ExprOp op;
+	const double* operand; // для Add: строка-источник той же формы, что и результат
+	double scalar;
+};
+
+// Оптимизация: все поэлементные операции применяются за один проход по строке,
+// значение живет в регистре, промежуточные матрицы в память не пишутся
+static void ApplyEpilogue(const std::vector<EpilogueOp>& ops, size_t offset, double* out, size_t len) {
+	size_t x = 0;
+
+#ifdef USE_AVX
+	const __m256d zero = _mm256_setzero_pd();
+	for (; x + 4 <= len; x += 4) {
+		__m256d v = _mm256_loadu_pd(out + x);
+		for (const EpilogueOp& e : ops) {
+			switch (e.op) {
+				case ExprOp::Add: v = _mm256_add_pd(v, _mm256_loadu_pd(e.operand + offset + x)); break;
+				case ExprOp::Scale: v = _mm256_mul_pd(v, _mm256_set1_pd(e.scalar)); break;
+				case ExprOp::Relu: v = _mm256_max_pd(v, zero); break;
+				default: break;
+			}
+		}
+		_mm256_storeu_pd(out + x, v);
+	}
+#elif defined(USE_NEON)
+	const float64x2_t zero = vdupq_n_f64(0.0);
+	for (; x + 2 <= len; x += 2) {
+		float64x2_t v = vld1q_f64(out + x);
+		for (const EpilogueOp& e : ops) {
+			switch (e.op) {
+				case ExprOp::Add: v = vaddq_f64(v, vld1q_f64(e.operand + offset + x)); break;
+				case ExprOp::Scale: v = vmulq_f64(v, vdupq_n_f64(e.scalar)); break;
+				case ExprOp::Relu: v = vmaxq_f64(v, zero); break;
+				default: break;
+			}
+		}
+		vst1q_f64(out + x, v);
+	}
+#endif
+
+	// Хвост (и фоллбек без SIMD)
+	for (; x < len; ++x) {
+		double v = out[x];
+		for (const EpilogueOp& e : ops) {
+			switch (e.op) {
+				case ExprOp::Add: v += e.operand[offset + x]; break;
+				case ExprOp::Scale: v *= e.scalar; break;
+				case ExprOp::Relu: v = v > 0.0 ? v : 0.0; break;
+				default: break;
+			}
+		}
+		out[x] = v;
+	}
+}
+
+// Вычисление дерева выражения
+// 1. От корня снимаем цепочку поэлементных узлов - это эпилог
+// 2. Основание цепочки - либо MatMul, либо готовая матрица
+// 3. MatMul считаем построчно и применяем эпилог к строке, пока она в L1
+MatrixDataPtr EvaluateExpr(const ExprNodePtr& root) {
+	if (root->op == ExprOp::Leaf) {
+		return root->leaf;
+	}
+
+	// Операнды Add, не лежащие на цепочке, материализуем заранее
+	std::vector<MatrixDataPtr> keepAlive;
+	std::vector<EpilogueOp> ops;
+
+	ExprNodePtr base = root;
+	while (base->op == ExprOp::Add || base->op == ExprOp::Scale || base->op == ExprOp::Relu) {
+		if (base->op == ExprOp::Add) {
+			// Сложение коммутативно: продолжаем цепочку через нелистовой операнд
+			const bool chainLeft = base->lhs->op != ExprOp::Leaf || base->rhs->op == ExprOp::Leaf;
+			const ExprNodePtr& side = chainLeft ? base->rhs : base->lhs;
+			MatrixDataPtr operand = EvaluateExpr(side);
+			ops.push_back({ ExprOp::Add, operand->Data(), 0.0 });
+			keepAlive.push_back(std::move(operand));
+			base = chainLeft ? base->lhs : base->rhs;
+		} else {
+			ops.push_back({ base->op, nullptr, base->scalar });
+			base = base->lhs;
+		}
+	}
+	// Собирали от корня к основанию - применять нужно в обратном порядке
+	std::vector<EpilogueOp> epilogue(ops.rbegin(), ops.rend());
+
+	auto result = std::make_shared<MatrixData>();
+	result->rows = root->rows;
+	result->cols = root->cols;
+	const size_t n = result->cols;
+
+	if (base->op == ExprOp::MatMul) {
+		MatrixDataPtr a = EvaluateExpr(base->lhs);
+		MatrixDataPtr b = EvaluateExpr(base->rhs);
+		const size_t k = a->cols;
+
+		std::vector<double> BT;
+		TransposeRowMajor(b->Data(), k, n, BT); // n x k
+
+		result->values.resize(result->rows * n);
+		double* C = result->values.data();
+		for (size_t i = 0; i < result->rows; ++i) {
+			SimdMatmulRowRange(a->Data(), BT.data(), k, n, i, i + 1, C);
+			if (!epilogue.empty()) {
+				ApplyEpilogue(epilogue, i * n, C + i * n, n);
+			}
+		}
+	} else {
+		// Основание - готовая матрица: один проход копирования с эпилогом
+		MatrixDataPtr src = EvaluateExpr(base);
+		result->values.assign(src->Data(), src->Data() + src->Size());
+		double* C = result->values.data();
+		for (size_t i = 0; i < result->rows; ++i) {
+			ApplyEpilogue(epilogue, i * n, C + i * n, n);
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,119 @@
+#include <napi.h>
+#include <vector>
+#include <cstdint>
+#include <string>
+
+// Int8Array / Uint8Array без копирования
+struct Int8Operand {
+	const void* data = nullptr;
+	size_t length = 0;
+	bool isUnsigned = false;
+};
+
+static bool ReadInt8Operand(const Napi::Value& value, Int8Operand& out) {
+	if (!value.IsTypedArray()) {
+		return false;
+	}
+
+	Napi::TypedArray ta = value.As<Napi::TypedArray>();
+	switch (ta.TypedArrayType()) {
+		case napi_int8_array:
+			out.data = value.As<Napi::TypedArrayOf<int8_t>>().Data();
+			out.isUnsigned = false;
+			break;
+		case napi_uint8_array:
+		case napi_uint8_clamped_array:
+			out.data = value.As<Napi::TypedArrayOf<uint8_t>>().Data();
+			out.isUnsigned = true;
+			break;
+		default:
+			return false;
+	}
+
+	out.length = ta.ElementLength();
+	return true;
+}
+
+template <typename TA, typename TB>
+static void RunInt8Matmul(const Int8Operand& a, const Int8Operand& b, size_t m, size_t k, size_t n, int32_t* C) {
+	std::vector<TB> BT;
+	TransposeInt8(static_cast<const TB*>(b.data), k, n, BT); // n x k
+	Int8MatmulRowRow(static_cast<const TA*>(a.data), BT.data(), m, k, n, C);
+}
+
+static void DispatchInt8Matmul(const Int8Operand& a, const Int8Operand& b, size_t m, size_t k, size_t n, int32_t* C) {
+	if (!a.isUnsigned && !b.isUnsigned) {
+		RunInt8Matmul<int8_t, int8_t>(a, b, m, k, n, C);
+	} else if (!a.isUnsigned && b.isUnsigned) {
+		RunInt8Matmul<int8_t, uint8_t>(a, b, m, k, n, C);
+	} else if (a.isUnsigned && !b.isUnsigned) {
+		RunInt8Matmul<uint8_t, int8_t>(a, b, m, k, n, C);
+	} else {
+		RunInt8Matmul<uint8_t, uint8_t>(a, b, m, k, n, C);
+	}
+}
+
+// multiplyInt8(A, B, m, k, n[, rowScales])
+// A(m x k), B(k x n) - row-major Int8Array/Uint8Array
+// Без rowScales -> Int32Array(m * n), с rowScales(Float32Array, длина m) -> Float32Array(m * n)
+Napi::Value MultiplyInt8(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	if (info.Length() < 5 || !info[2].IsNumber() || !info[3].IsNumber() || !info[4].IsNumber()) {
+		Napi::TypeError::New(env, "Ожидается: matrixA, matrixB, m, k, n[, rowScales]").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	Int8Operand a, b;
+	if (!ReadInt8Operand(info[0], a) || !ReadInt8Operand(info[1], b)) {
+		Napi::TypeError::New(env, "Матрицы должны быть Int8Array или Uint8Array").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	const int64_t mi = info[2].As<Napi::Number>().Int64Value();
+	const int64_t ki = info[3].As<Napi::Number>().Int64Value();
+	const int64_t ni = info[4].As<Napi::Number>().Int64Value();
+	if (mi <= 0 || ki <= 0 || ni <= 0) {
+		Napi::Error::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	const size_t m = (size_t)mi, k = (size_t)ki, n = (size_t)ni;
+	if (a.length != m * k || b.length != k * n) {
+		Napi::Error::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	// Накопитель int32: на длинных строках сумма могла бы молча переполниться
+	const size_t maxK = Int8MaxK(a.isUnsigned, b.isUnsigned);
+	if (k > maxK) {
+		Napi::RangeError::New(env, "k = " + std::to_string(k) + ": сумма может переполнить int32, для этих типов k не больше " + std::to_string(maxK)).ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	const bool dequantize = info.Length() > 5 && !info[5].IsUndefined() && !info[5].IsNull();
+	if (!dequantize) {
+		// Оптимизация: пишем результат сразу в память Int32Array, без промежуточного буфера
+		Napi::Int32Array C = Napi::Int32Array::New(env, m * n);
+		DispatchInt8Matmul(a, b, m, k, n, C.Data());
+		return C;
+	}
+
+	if (!info[5].IsTypedArray() || info[5].As<Napi::TypedArray>().TypedArrayType() != napi_float32_array) {
+		Napi::TypeError::New(env, "rowScales должен быть Float32Array").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	Napi::Float32Array scales = info[5].As<Napi::Float32Array>();
+	if (scales.ElementLength() != m) {
+		Napi::Error::New(env, "Длина rowScales должна совпадать с числом строк A").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	std::vector<int32_t> acc(m * n);
+	DispatchInt8Matmul(a, b, m, k, n, acc.data());
+
+	Napi::Float32Array C = Napi::Float32Array::New(env, m * n);
+	DequantizeRows(acc.data(), scales.Data(), m, n, C.Data());
+	return C;
+}
@@ -0,0 +1,151 @@
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// SIMD детект
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+	#include <immintrin.h>
+	#if defined(__AVX2__)
+		#define USE_AVX2_INT8
+	#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#include <arm_neon.h>
+	#define USE_NEON_INT8
+	// sdot/udot есть начиная с armv8.2-a+dotprod (обязательны с armv8.4-a)
+	#if defined(__ARM_FEATURE_DOTPROD)
+		#define USE_NEON_DOTPROD
+	#endif
+#endif
+
+#ifdef USE_AVX2_INT8
+// 16 байт -> 16 x int16 (знаковое или беззнаковое расширение)
+static inline __m256i Widen16(const int8_t* p) {
+	return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+static inline __m256i Widen16(const uint8_t* p) {
+	return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+static inline int32_t HorizontalSumEpi32(__m256i v) {
+	__m128i lo = _mm256_castsi256_si128(v);
+	__m128i hi = _mm256_extracti128_si256(v, 1);
+	__m128i s = _mm_add_epi32(lo, hi);
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(s);
+}
+#endif
+
+#ifdef USE_NEON_INT8
+// 8 байт -> 8 x int16 (u8 влезает в s16 без потерь)
+static inline int16x8_t Widen8(const int8_t* p) {
+	return vmovl_s8(vld1_s8(p));
+}
+
+static inline int16x8_t Widen8(const uint8_t* p) {
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p)));
+}
+#endif
+
+// Скалярное произведение двух int8/uint8 строк длины k с накоплением в int32
+template <typename TA, typename TB>
+static inline int32_t Int8Dot(const TA* a, const TB* b, size_t k) {
+	size_t t = 0;
+	int32_t sum = 0;
+
+#if defined(USE_AVX2_INT8)
+	// Оптимизация: расширяем до int16 и считаем vpmaddwd - 16 умножений-сложений за инструкцию
+	// (vpmaddubsw не используем: u8*s8 пары насыщаются в int16 и дают неверный результат)
+	__m256i acc = _mm256_setzero_si256();
+	for (; t + 16 <= k; t += 16) {
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(Widen16(a + t), Widen16(b + t)));
+	}
+	sum = HorizontalSumEpi32(acc);
+
+#elif defined(USE_NEON_INT8)
+	#if defined(USE_NEON_DOTPROD)
+	// Оптимизация: sdot/udot - 16 умножений-сложений за инструкцию без расширения
+	if constexpr (std::is_same_v<TA, TB>) {
+		if constexpr (std::is_same_v<TA, int8_t>) {
+			int32x4_t acc = vdupq_n_s32(0);
+			for (; t + 16 <= k; t += 16) {
+				acc = vdotq_s32(acc, vld1q_s8(a + t), vld1q_s8(b + t));
+			}
+			sum = vaddvq_s32(acc);
+		} else {
+			uint32x4_t acc = vdupq_n_u32(0);
+			for (; t + 16 <= k; t += 16) {
+				acc = vdotq_u32(acc, vld1q_u8(a + t), vld1q_u8(b + t));
+			}
+			sum = static_cast<int32_t>(vaddvq_u32(acc));
+		}
+	}
+	#endif
+	// Смешанные знаки (или нет dotprod): расширяем до int16 и копим через vmlal
+	int32x4_t acc = vdupq_n_s32(0);
+	for (; t + 8 <= k; t += 8) {
+		int16x8_t va = Widen8(a + t);
+		int16x8_t vb = Widen8(b + t);
+		acc = vmlal_s16(acc, vget_low_s16(va), vget_low_s16(vb));
+		acc = vmlal_high_s16(acc, va, vb);
+	}
+	sum += vaddvq_s32(acc);
+#endif
+
+	// Хвост (и фоллбек без SIMD)
+	for (; t < k; ++t) {
+		sum += static_cast<int32_t>(a[t]) * static_cast<int32_t>(b[t]);
+	}
+	return sum;
+}
+
+// Наибольшая длина строки, при которой сумма k произведений гарантированно влезает в int32:
+// |a * b| не больше 128 * 128 (int8 x int8), 128 * 255 (смешанные) или 255 * 255 (uint8 x uint8)
+static size_t Int8MaxK(bool aUnsigned, bool bUnsigned) {
+	const int64_t maxA = aUnsigned ? 255 : 128;
+	const int64_t maxB = bUnsigned ? 255 : 128;
+	return (size_t)(INT32_MAX / (maxA * maxB));
+}
+
+// Ядро умножения: A(m x k) row-major, BT(n x k) row-major -> C(m x n) row-major, int32.
+// k не больше Int8MaxK для этих типов - проверяет вызывающий
+template <typename TA, typename TB>
+void Int8MatmulRowRow(
+	const TA* A, const TB* BT,
+	size_t m, size_t k, size_t n,
+	int32_t* C)
+{
+	for (size_t i = 0; i < m; ++i) {
+		const TA* aRow = A + i * k;
+		int32_t* cRow = C + i * n;
+		for (size_t j = 0; j < n; ++j) {
+			cRow[j] = Int8Dot(aRow, BT + j * k, k);
+		}
+	}
+}
+
+// Транспонирование row-major B(k x n) -> BT(n x k) для int8/uint8
+template <typename T>
+static void TransposeInt8(const T* B, size_t k, size_t n, std::vector<T>& BT) {
+	BT.resize(n * k);
+	for (size_t i = 0; i < k; ++i) {
+		const T* bRow = B + i * n;
+		for (size_t j = 0; j < n; ++j) {
+			BT[j * k + i] = bRow[j];
+		}
+	}
+}
+
+// Деквантование: out[i][j] = C[i][j] * rowScales[i]
+static void DequantizeRows(const int32_t* C, const float* rowScales, size_t m, size_t n, float* out) {
+	for (size_t i = 0; i < m; ++i) {
+		const float s = rowScales[i];
+		const int32_t* cRow = C + i * n;
+		float* oRow = out + i * n;
+		for (size_t j = 0; j < n; ++j) {
+			oRow[j] = static_cast<float>(cRow[j]) * s;
+		}
+	}
+}
@@ -0,0 +1,205 @@
+#include <napi.h>
+#include <vector>
+#include <string>
+
+enum class LinalgOp {
+	Lu,
+	Cholesky,
+	Solve,
+	Inverse
+};
+
+// Состояние одной задачи: входы сплющены на main thread, дальше работа только с плоскими буферами
+struct LinalgTask {
+	LinalgOp op;
+	size_t n = 0;
+	size_t nrhs = 0;
+	std::vector<double> a;   // A -> LU / L
+	std::vector<double> b;   // B -> X (solve, inverse)
+	std::vector<size_t> piv;
+	std::string error;
+};
+
+static bool RunLinalgTask(LinalgTask& task) {
+	if (task.op == LinalgOp::Cholesky) {
+		if (!CholeskyBlocked(task.a, task.n)) {
+			task.error = "Матрица не положительно определена";
+			return false;
+		}
+		return true;
+	}
+
+	if (!LuFactorBlocked(task.a, task.n, task.piv)) {
+		task.error = "Матрица вырождена";
+		return false;
+	}
+
+	if (task.op == LinalgOp::Inverse) {
+		// A^-1 = решение A * X = I
+		task.nrhs = task.n;
+		task.b.assign(task.n * task.n, 0.0);
+		for (size_t i = 0; i < task.n; ++i) {
+			task.b[i * task.n + i] = 1.0;
+		}
+	}
+
+	if (task.op == LinalgOp::Solve || task.op == LinalgOp::Inverse) {
+		LuSolveInPlace(task.a, task.n, task.piv, task.b, task.nrhs);
+	}
+	return true;
+}
+
+static Napi::Value LinalgResultToJs(Napi::Env env, const LinalgTask& task) {
+	const size_t n = task.n;
+
+	switch (task.op) {
+		case LinalgOp::Lu: {
+			std::vector<double> L(n * n, 0.0), U(n * n, 0.0);
+			for (size_t i = 0; i < n; ++i) {
+				for (size_t j = 0; j < n; ++j) {
+					if (j < i) {
+						L[i * n + j] = task.a[i * n + j];
+					} else {
+						U[i * n + j] = task.a[i * n + j];
+					}
+				}
+				L[i * n + i] = 1.0;
+			}
+
+			std::vector<size_t> perm = PivotsToPermutation(task.piv, n);
+			Napi::Int32Array pivots = Napi::Int32Array::New(env, n);
+			for (size_t i = 0; i < n; ++i) {
+				pivots[i] = (int32_t)perm[i];
+			}
+
+			Napi::Object result = Napi::Object::New(env);
+			result.Set("L", RowMajorToJs(env, L, n, n));
+			result.Set("U", RowMajorToJs(env, U, n, n));
+			result.Set("pivots", pivots);
+			return result;
+		}
+		case LinalgOp::Cholesky:
+			return RowMajorToJs(env, task.a, n, n);
+		case LinalgOp::Solve:
+		case LinalgOp::Inverse:
+			return RowMajorToJs(env, task.b, n, task.nrhs);
+	}
+	return env.Null();
+}
+
+// Разбор аргументов: A - квадратная number[][], для solve еще B(n x nrhs)
+static bool ReadLinalgArgs(const Napi::CallbackInfo& info, LinalgTask& task) {
+	Napi::Env env = info.Env();
+	const bool needsB = task.op == LinalgOp::Solve;
+	const size_t argc = needsB ? 2 : 1;
+
+	if (info.Length() < argc || !info[0].IsArray() || (needsB && !info[1].IsArray())) {
+		Napi::TypeError::New(env, needsB ? "Ожидается 2 матрицы: matrixA, matrixB" : "Ожидается матрица").ThrowAsJavaScriptException();
+		return false;
+	}
+
+	Napi::Array Ajs = info[0].As<Napi::Array>();
+	size_t rows, cols;
+	if (!ReadShape(Ajs, rows, cols) || rows == 0 || rows != cols) {
+		Napi::Error::New(env, "Ожидается квадратная матрица").ThrowAsJavaScriptException();
+		return false;
+	}
+	task.n = rows;
+	FlattenRowMajor(Ajs, rows, cols, task.a);
+
+	if (needsB) {
+		Napi::Array Bjs = info[1].As<Napi::Array>();
+		size_t bRows;
+		if (!ReadShape(Bjs, bRows, task.nrhs) || bRows != task.n || task.nrhs == 0) {
+			Napi::Error::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+			return false;
+		}
+		FlattenRowMajor(Bjs, bRows, task.nrhs, task.b);
+	}
+	return true;
+}
+
+static Napi::Value RunLinalgSync(const Napi::CallbackInfo& info, LinalgOp op) {
+	Napi::Env env = info.Env();
+
+	LinalgTask task;
+	task.op = op;
+	if (!ReadLinalgArgs(info, task)) {
+		return env.Null();
+	}
+
+	if (!RunLinalgTask(task)) {
+		Napi::Error::New(env, task.error).ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	return LinalgResultToJs(env, task);
+}
+
+class LinalgWorker : public Napi::AsyncWorker {
+public:
+	LinalgWorker(Napi::Function& cb, LinalgTask&& task)
+	: Napi::AsyncWorker(cb), task_(std::move(task)) {}
+
+	ThreadSlot& Slot() { return slot_; }
+
+	void Execute() override {
+		ThreadSlot::Hold hold(slot_);
+		if (!RunLinalgTask(task_)) {
+			SetError(task_.error);
+		}
+	}
+
+	void OnOK() override {
+		Napi::Env env = Env();
+		Napi::HandleScope scope(env);
+		Callback().Call({ env.Null(), LinalgResultToJs(env, task_) });
+	}
+
+	void OnError(const Napi::Error& e) override {
+		Napi::Env env = Env();
+		Callback().Call({ e.Value(), env.Undefined() });
+	}
+
+private:
+	LinalgTask task_;
+	ThreadSlot slot_;
+};
+
+static Napi::Value RunLinalgAsync(const Napi::CallbackInfo& info, LinalgOp op) {
+	Napi::Env env = info.Env();
+
+	const size_t cbIndex = op == LinalgOp::Solve ? 2 : 1;
+	if (info.Length() <= cbIndex || !info[cbIndex].IsFunction()) {
+		Napi::TypeError::New(env, "Последним аргументом ожидается callback").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	LinalgTask task;
+	task.op = op;
+	if (!ReadLinalgArgs(info, task)) {
+		return env.Null();
+	}
+
+	Napi::Function cb = info[cbIndex].As<Napi::Function>();
+	auto* worker = new LinalgWorker(cb, std::move(task));
+	// Trailing update идет на пул - занимаем все его потоки
+	QueueWithBudget(env, worker, GetComputePool()->ThreadCount());
+
+	return env.Undefined();
+}
+
+// lu(A) -> { L, U, pivots }, где P * A = L * U и строка i в P * A - это строка pivots[i] из A
+Napi::Value Lu(const Napi::CallbackInfo& info) { return RunLinalgSync(info, LinalgOp::Lu); }
+Napi::Value LuAsync(const Napi::CallbackInfo& info) { return RunLinalgAsync(info, LinalgOp::Lu); }
+
+// cholesky(A) -> L, где A = L * L^T
+Napi::Value Cholesky(const Napi::CallbackInfo& info) { return RunLinalgSync(info, LinalgOp::Cholesky); }
+Napi::Value CholeskyAsync(const Napi::CallbackInfo& info) { return RunLinalgAsync(info, LinalgOp::Cholesky); }
+
+// solve(A, B) -> X, где A * X = B
+Napi::Value Solve(const Napi::CallbackInfo& info) { return RunLinalgSync(info, LinalgOp::Solve); }
+Napi::Value SolveAsync(const Napi::CallbackInfo& info) { return RunLinalgAsync(info, LinalgOp::Solve); }
+
+// inverse(A) -> A^-1
+Napi::Value Inverse(const Napi::CallbackInfo& info) { return RunLinalgSync(info, LinalgOp::Inverse); }
+Napi::Value InverseAsync(const Napi::CallbackInfo& info) { return RunLinalgAsync(info, LinalgOp::Inverse); }
@@ -0,0 +1,215 @@
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+
+// Ширина панели блочных разложений: панель nb столбцов считается "в лоб",
+// а основная работа (trailing update) уходит в GEMM-ядро, разложенное по потокам пула (ParallelGemmAccumulate)
+static const size_t kLinalgBlock = 64;
+
+// Блочное LU-разложение с частичным выбором ведущего элемента (right-looking, как LAPACK getrf)
+// a(n x n) row-major перезаписывается на L\U (L с единичной диагональю), piv[j] - строка, с которой поменяли j
+// Возвращает false, если матрица вырождена
+bool LuFactorBlocked(std::vector<double>& a, size_t n, std::vector<size_t>& piv) {
+	piv.resize(n);
+	std::vector<double> U12T;
+
+	for (size_t j0 = 0; j0 < n; j0 += kLinalgBlock) {
+		const size_t jb = std::min(kLinalgBlock, n - j0);
+		const size_t jEnd = j0 + jb;
+
+		// 1. Факторизация панели: столбцы [j0, jEnd), строки [j0, n)
+		for (size_t j = j0; j < jEnd; ++j) {
+			size_t p = j;
+			double maxAbs = std::fabs(a[j * n + j]);
+			for (size_t i = j + 1; i < n; ++i) {
+				double v = std::fabs(a[i * n + j]);
+				if (v > maxAbs) {
+					maxAbs = v;
+					p = i;
+				}
+			}
+			if (maxAbs == 0.0) {
+				return false;
+			}
+
+			piv[j] = p;
+			if (p != j) {
+				// Меняем строки целиком: это сразу применяет перестановку и к L слева, и к A справа
+				std::swap_ranges(&a[j * n], &a[j * n] + n, &a[p * n]);
+			}
+
+			const double* rowJ = &a[j * n];
+			const double inv = 1.0 / rowJ[j];
+			for (size_t i = j + 1; i < n; ++i) {
+				double* rowI = &a[i * n];
+				const double l = rowI[j] * inv;
+				rowI[j] = l;
+				for (size_t c = j + 1; c < jEnd; ++c) {
+					rowI[c] -= l * rowJ[c];
+				}
+			}
+		}
+
+		if (jEnd == n) {
+			break;
+		}
+
+		// 2. U12 = L11^-1 * A12 (прямая подстановка с единичной диагональю)
+		for (size_t j = j0; j < jEnd; ++j) {
+			const double* rowJ = &a[j * n];
+			for (size_t i = j + 1; i < jEnd; ++i) {
+				double* rowI = &a[i * n];
+				const double l = rowI[j];
+				for (size_t c = jEnd; c < n; ++c) {
+					rowI[c] -= l * rowJ[c];
+				}
+			}
+		}
+
+		// 3. Trailing update: A22 -= L21 * U12 через GEMM-ядро
+		// U12 транспонируем в (n - jEnd) x jb, чтобы ядро читало обе матрицы по строкам
+		const size_t rest = n - jEnd;
+		U12T.resize(rest * jb);
+		for (size_t t = 0; t < jb; ++t) {
+			const double* uRow = &a[(j0 + t) * n + jEnd];
+			for (size_t c = 0; c < rest; ++c) {
+				U12T[c * jb + t] = uRow[c];
+			}
+		}
+
+		ParallelGemmAccumulate(
+			&a[jEnd * n + j0], n,
+			U12T.data(), jb,
+			rest, jb, rest,
+			-1.0,
+			&a[jEnd * n + jEnd], n);
+	}
+
+	return true;
+}
+
+// Блочное разложение Холецкого A = L * L^T (нижнетреугольное)
+// a(n x n) row-major перезаписывается на L, верхний треугольник обнуляется
+// Возвращает false, если матрица не положительно определена
+bool CholeskyBlocked(std::vector<double>& a, size_t n) {
+	for (size_t j0 = 0; j0 < n; j0 += kLinalgBlock) {
+		const size_t jb = std::min(kLinalgBlock, n - j0);
+		const size_t jEnd = j0 + jb;
+
+		// 1. Диагональный блок и панель под ним: столбцы [j0, jEnd)
+		// (вклад предыдущих панелей уже вычтен trailing update)
+		for (size_t j = j0; j < jEnd; ++j) {
+			const double* rowJ = &a[j * n];
+			double d = rowJ[j];
+			for (size_t t = j0; t < j; ++t) {
+				d -= rowJ[t] * rowJ[t];
+			}
+			if (!(d > 0.0)) {
+				return false;
+			}
+
+			const double l = std::sqrt(d);
+			a[j * n + j] = l;
+			const double inv = 1.0 / l;
+
+			for (size_t i = j + 1; i < n; ++i) {
+				double* rowI = &a[i * n];
+				double v = rowI[j];
+				for (size_t t = j0; t < j; ++t) {
+					v -= rowI[t] * rowJ[t];
+				}
+				rowI[j] = v * inv;
+			}
+		}
+
+		if (jEnd == n) {
+			break;
+		}
+
+		// 2. Trailing update: A22 -= L21 * L21^T через GEMM-ядро
+		// L21 уже лежит по строкам, поэтому служит и как A, и как BT без транспонирования
+		// Считаем только нижний треугольник: полосами по kLinalgBlock строк, полосы независимы
+		const size_t rest = n - jEnd;
+		const double* L21 = &a[jEnd * n + j0];
+		const size_t stripes = (rest + kLinalgBlock - 1) / kLinalgBlock;
+		auto updateStripes = [&](size_t, size_t sBegin, size_t sEnd) {
+			for (size_t s = sBegin; s < sEnd; ++s) {
+				const size_t r0 = s * kLinalgBlock;
+				const size_t rb = std::min(kLinalgBlock, rest - r0);
+				SimdGemmAccumulate(
+					L21 + r0 * n, n,
+					L21, n,
+					rb, jb, r0 + rb,
+					-1.0,
+					&a[(jEnd + r0) * n + jEnd], n);
+			}
+		};
+
+		// Полосы разной стоимости (треугольник), поэтому раздаем по одной: простаивающие потоки доберут остаток
+		if (stripes < 2 || rest * rest * jb < (size_t)1 << 19) {
+			updateStripes(0, 0, stripes);
+		} else {
+			std::shared_ptr<ComputePool> pool = GetComputePool();
+			pool->ParallelForNodes(pool->SplitByNodes(stripes), 1, updateStripes);
+		}
+	}
+
+	for (size_t i = 0; i < n; ++i) {
+		std::fill(&a[i * n] + i + 1, &a[i * n] + n, 0.0);
+	}
+	return true;
+}
+
+// Решение LU * X = P * B для B(n x nrhs) row-major, B перезаписывается на X
+void LuSolveInPlace(const std::vector<double>& lu, size_t n, const std::vector<size_t>& piv, std::vector<double>& b, size_t nrhs) {
+	for (size_t j = 0; j < n; ++j) {
+		if (piv[j] != j) {
+			std::swap_ranges(&b[j * nrhs], &b[j * nrhs] + nrhs, &b[piv[j] * nrhs]);
+		}
+	}
+
+	// Оптимизация: подстановки идут целыми строками B (axpy по nrhs), что векторизуется компилятором
+	// L * Y = P * B
+	for (size_t i = 0; i < n; ++i) {
+		double* bi = &b[i * nrhs];
+		const double* li = &lu[i * n];
+		for (size_t t = 0; t < i; ++t) {
+			const double l = li[t];
+			const double* bt = &b[t * nrhs];
+			for (size_t c = 0; c < nrhs; ++c) {
+				bi[c] -= l * bt[c];
+			}
+		}
+	}
+
+	// U * X = Y
+	for (size_t ii = n; ii-- > 0;) {
+		double* bi = &b[ii * nrhs];
+		const double* ui = &lu[ii * n];
+		for (size_t t = ii + 1; t < n; ++t) {
+			const double u = ui[t];
+			const double* bt = &b[t * nrhs];
+			for (size_t c = 0; c < nrhs; ++c) {
+				bi[c] -= u * bt[c];
+			}
+		}
+		const double inv = 1.0 / ui[ii];
+		for (size_t c = 0; c < nrhs; ++c) {
+			bi[c] *= inv;
+		}
+	}
+}
+
+// Перестановка строк из последовательности обменов piv: строка i в P*A - это строка perm[i] исходной A
+static std::vector<size_t> PivotsToPermutation(const std::vector<size_t>& piv, size_t n) {
+	std::vector<size_t> perm(n);
+	for (size_t i = 0; i < n; ++i) {
+		perm[i] = i;
+	}
+	for (size_t j = 0; j < n; ++j) {
+		std::swap(perm[j], perm[piv[j]]);
+	}
+	return perm;
+}
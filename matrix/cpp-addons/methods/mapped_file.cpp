@@ -0,0 +1,167 @@
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+#ifndef _WIN32
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+enum class MapAdvice { Sequential, WillNeed, DontNeed };
+
+// Файл, отображенный в память (mmap). Отображение снимается в деструкторе,
+// дескриптор закрывается сразу после mmap - он больше не нужен
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Весь файл на чтение. copyOnWrite - приватное отображение с правом записи:
+	// страницы общие с page cache, пока в них не пишут, запись не попадает ни в файл, ни в другие процессы
+	bool OpenRead(const std::string& path, std::string& error, bool copyOnWrite = false) {
+#ifndef _WIN32
+		Close();
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			error = "Не удалось открыть файл " + path + ": " + std::strerror(errno);
+			return false;
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+			error = "Пустой или недоступный файл " + path;
+			close(fd);
+			return false;
+		}
+		const bool ok = copyOnWrite
+			? Map(fd, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, path, error)
+			: Map(fd, (size_t)st.st_size, PROT_READ, MAP_SHARED, path, error);
+		close(fd);
+		return ok;
+#else
+		error = "Отображение файлов в память не поддерживается на Windows";
+		return false;
+#endif
+	}
+
+	// Создает (или обрезает) файл размера bytes и отображает его на запись. Новые страницы - нули
+	bool Create(const std::string& path, size_t bytes, std::string& error) {
+#ifndef _WIN32
+		Close();
+		int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) {
+			error = "Не удалось создать файл " + path + ": " + std::strerror(errno);
+			return false;
+		}
+		if (ftruncate(fd, (off_t)bytes) != 0) {
+			error = "Не удалось задать размер файла " + path + ": " + std::strerror(errno);
+			close(fd);
+			return false;
+		}
+		const bool ok = Map(fd, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, path, error);
+		close(fd);
+		return ok;
+#else
+		error = "Отображение файлов в память не поддерживается на Windows";
+		return false;
+#endif
+	}
+
+	void Close() {
+#ifndef _WIN32
+		if (data_) {
+			munmap(data_, size_);
+		}
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	uint8_t* Data() const { return data_; }
+	size_t Size() const { return size_; }
+
+	// Подсказка ядру для диапазона байт; границы расширяются до страниц
+	void Advise(size_t offset, size_t length, MapAdvice advice) const {
+#ifndef _WIN32
+		size_t begin, end;
+		if (!PageRange(offset, length, begin, end)) {
+			return;
+		}
+		int flag = MADV_NORMAL;
+		switch (advice) {
+			case MapAdvice::Sequential: flag = MADV_SEQUENTIAL; break;
+			case MapAdvice::WillNeed: flag = MADV_WILLNEED; break;
+			case MapAdvice::DontNeed: flag = MADV_DONTNEED; break;
+		}
+		madvise(data_ + begin, end - begin, flag);
+#endif
+	}
+
+	// Запустить запись измененных страниц диапазона на диск, не дожидаясь ее
+	void FlushAsync(size_t offset, size_t length) const {
+#ifndef _WIN32
+		size_t begin, end;
+		if (PageRange(offset, length, begin, end)) {
+			msync(data_ + begin, end - begin, MS_ASYNC);
+		}
+#endif
+	}
+
+private:
+#ifndef _WIN32
+	bool Map(int fd, size_t bytes, int prot, int flags, const std::string& path, std::string& error) {
+		void* data = mmap(nullptr, bytes, prot, flags, fd, 0);
+		if (data == MAP_FAILED) {
+			error = "Не удалось отобразить файл " + path + ": " + std::strerror(errno);
+			return false;
+		}
+		data_ = static_cast<uint8_t*>(data);
+		size_ = bytes;
+		return true;
+	}
+
+	bool PageRange(size_t offset, size_t length, size_t& begin, size_t& end) const {
+		if (!data_ || length == 0 || offset >= size_) {
+			return false;
+		}
+		const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+		begin = offset / page * page;
+		end = std::min(size_, offset + length);
+		return end > begin;
+	}
+#endif
+
+	uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+};
+
+// Временный файл рядом с path: запись идет в него, затем rename поверх path.
+// Процессы, уже отобразившие старый файл, продолжают видеть его целиком (старый inode),
+// а не обрезанный на полпути (SIGBUS при O_TRUNC файла, отображенного в другом месте)
+static std::string TempSiblingPath(const std::string& path) {
+	static std::atomic<uint64_t> counter{ 0 };
+#ifndef _WIN32
+	const long pid = (long)getpid();
+#else
+	const long pid = 0;
+#endif
+	return path + ".tmp-" + std::to_string(pid) + "-" + std::to_string(counter.fetch_add(1));
+}
+
+static bool ReplaceFile(const std::string& tmpPath, const std::string& path, std::string& error) {
+	if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+		error = "Не удалось переименовать " + tmpPath + " в " + path + ": " + std::strerror(errno);
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,171 @@
+#include <napi.h>
+#include <string>
+#include <memory>
+
+// save()/load() матриц в формате .nmat (см. matrix_file_base.cpp).
+// load не копирует данные: Matrix или Float64Array смотрят прямо в отображение файла,
+// поэтому большие операнды загружаются за время mmap, а страницы общие для всех процессов через page cache
+
+static bool ReadSaveLayout(Napi::Env env, const Napi::CallbackInfo& info, size_t index, MatrixLayout& layout) {
+	layout = MatrixLayout::RowMajor;
+	if (info.Length() <= index || info[index].IsUndefined()) {
+		return true;
+	}
+	if (!info[index].IsObject()) {
+		Napi::TypeError::New(env, "Ожидается объект { layout }").ThrowAsJavaScriptException();
+		return false;
+	}
+	Napi::Value value = info[index].As<Napi::Object>().Get("layout");
+	if (value.IsUndefined()) {
+		return true;
+	}
+	const std::string name = value.IsString() ? value.As<Napi::String>().Utf8Value() : "";
+	if (name == "row-major") {
+		layout = MatrixLayout::RowMajor;
+	} else if (name == "col-major") {
+		layout = MatrixLayout::ColMajor;
+	} else {
+		Napi::TypeError::New(env, "layout: 'row-major' или 'col-major'").ThrowAsJavaScriptException();
+		return false;
+	}
+	return true;
+}
+
+static bool ReadLoadVerify(Napi::Env env, const Napi::CallbackInfo& info, bool& verify) {
+	verify = false;
+	if (info.Length() < 2 || info[1].IsUndefined()) {
+		return true;
+	}
+	if (!info[1].IsObject()) {
+		Napi::TypeError::New(env, "Ожидается объект { verify }").ThrowAsJavaScriptException();
+		return false;
+	}
+	verify = info[1].As<Napi::Object>().Get("verify").ToBoolean().Value();
+	return true;
+}
+
+static Napi::Value SaveMatrixData(Napi::Env env, const std::string& path, const MatrixData& data, MatrixLayout layout) {
+	std::string error;
+	if (!WriteMatrixFile(path, data.Data(), data.rows, data.cols, layout, error)) {
+		Napi::Error::New(env, error).ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	return Napi::Number::New(env, (double)(kMatrixFileAlignment + data.Size() * sizeof(double)));
+}
+
+static std::shared_ptr<MappedFile> OpenMatrixFile(const std::string& path, bool copyOnWrite, bool verify, MatrixFileHeader& header, std::string& error) {
+	auto file = std::make_shared<MappedFile>();
+	if (!file->OpenRead(path, error, copyOnWrite) || !ParseMatrixFile(*file, header, error)) {
+		return nullptr;
+	}
+	if (verify && !VerifyMatrixFile(*file, header, error)) {
+		return nullptr;
+	}
+	return file;
+}
+
+// saveMatrix(path, Matrix | number[][][, { layout }]) -> размер файла в байтах
+Napi::Value SaveMatrix(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	ExprNodePtr node = info.Length() > 1 && info[0].IsString() ? ReadMatrixOperand(env, info[1]) : nullptr;
+	if (!node) {
+		Napi::TypeError::New(env, "Ожидается: path, Matrix или number[][]").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	MatrixLayout layout;
+	if (!ReadSaveLayout(env, info, 2, layout)) {
+		return env.Null();
+	}
+	return SaveMatrixData(env, info[0].As<Napi::String>().Utf8Value(), *EvaluateExpr(node), layout);
+}
+
+// matrix.save(path[, { layout }])
+Napi::Value MatrixObject::Save(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+	if (!CheckInitialized(env)) return env.Null();
+
+	if (info.Length() < 1 || !info[0].IsString()) {
+		Napi::TypeError::New(env, "Ожидается path").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	MatrixLayout layout;
+	if (!ReadSaveLayout(env, info, 1, layout)) {
+		return env.Null();
+	}
+	if (node_->op != ExprOp::Leaf) {
+		node_ = MakeLeafNode(EvaluateExpr(node_));
+	}
+	return SaveMatrixData(env, info[0].As<Napi::String>().Utf8Value(), *node_->leaf, layout);
+}
+
+// loadMatrix(path[, { verify }]) -> Matrix поверх отображения (только row-major).
+// Отображение только на чтение: Matrix неизменяема, а файл перезаписывается через rename
+Napi::Value LoadMatrix(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	bool verify;
+	if (info.Length() < 1 || !info[0].IsString()) {
+		Napi::TypeError::New(env, "Ожидается path").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	if (!ReadLoadVerify(env, info, verify)) {
+		return env.Null();
+	}
+
+	std::string error;
+	MatrixFileHeader header;
+	std::shared_ptr<MappedFile> file = OpenMatrixFile(info[0].As<Napi::String>().Utf8Value(), false, verify, header, error);
+	if (!file) {
+		Napi::Error::New(env, error).ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	if (header.layout != (uint32_t)MatrixLayout::RowMajor) {
+		Napi::Error::New(env, "Matrix хранит row-major; для col-major используйте loadMatrixData").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	auto data = std::make_shared<MatrixData>();
+	data->rows = header.rows;
+	data->cols = header.cols;
+	data->external = MatrixFileData(*file, header);
+	data->storage = std::move(file);
+	return MatrixObject::NewInstance(env, MakeLeafNode(std::move(data)));
+}
+
+// loadMatrixData(path[, { verify }]) -> { data: Float64Array, rows, cols, layout }.
+// Отображение приватное (copy-on-write): запись в массив не меняет файл и не видна другим процессам
+Napi::Value LoadMatrixData(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	bool verify;
+	if (info.Length() < 1 || !info[0].IsString()) {
+		Napi::TypeError::New(env, "Ожидается path").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	if (!ReadLoadVerify(env, info, verify)) {
+		return env.Null();
+	}
+
+	std::string error;
+	MatrixFileHeader header;
+	std::shared_ptr<MappedFile> file = OpenMatrixFile(info[0].As<Napi::String>().Utf8Value(), true, verify, header, error);
+	if (!file) {
+		Napi::Error::New(env, error).ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	const size_t count = header.rows * header.cols;
+	double* values = const_cast<double*>(MatrixFileData(*file, header));
+	// Отображение живет, пока жив ArrayBuffer: финализатор отпускает последнюю ссылку
+	auto* holder = new std::shared_ptr<MappedFile>(std::move(file));
+	Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, values, count * sizeof(double),
+		[](Napi::Env, void*, std::shared_ptr<MappedFile>* hint) { delete hint; }, holder);
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("data", Napi::Float64Array::New(env, count, buffer, 0));
+	result.Set("rows", Napi::Number::New(env, (double)header.rows));
+	result.Set("cols", Napi::Number::New(env, (double)header.cols));
+	result.Set("layout", Napi::String::New(env, header.layout == (uint32_t)MatrixLayout::ColMajor ? "col-major" : "row-major"));
+	return result;
+}
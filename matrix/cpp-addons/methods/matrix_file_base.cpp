@@ -0,0 +1,136 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+
+// Бинарный формат матрицы (.nmat), little-endian:
+//   0   magic "NMATRIX\0"
+//   8   version (1), dtype (1 = float64), layout (0 = row-major, 1 = column-major), alignment
+//   24  rows, cols, dataOffset, checksum (64 бита хеша данных), резерв
+//   64  данные с dataOffset, кратного alignment (64): из отображения можно сразу грузить AVX/NEON
+// Файл читается через mmap без копирования, поэтому заголовок - фиксированная структура, а не JSON
+static constexpr char kMatrixFileMagic[8] = { 'N', 'M', 'A', 'T', 'R', 'I', 'X', '\0' };
+static constexpr uint32_t kMatrixFileVersion = 1;
+static constexpr uint32_t kMatrixDtypeFloat64 = 1;
+static constexpr uint32_t kMatrixFileAlignment = 64;
+
+enum class MatrixLayout : uint32_t { RowMajor = 0, ColMajor = 1 };
+
+struct MatrixFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t dtype;
+	uint32_t layout;
+	uint32_t alignment;
+	uint64_t rows;
+	uint64_t cols;
+	uint64_t dataOffset;
+	uint64_t checksum;
+	uint64_t reserved;
+};
+static_assert(sizeof(MatrixFileHeader) == 64, "Заголовок .nmat занимает 64 байта");
+
+static uint64_t MatrixChecksum(const double* data, size_t count) {
+	return HashDoubles(data, count).lo;
+}
+
+static MatrixFileHeader MakeMatrixFileHeader(size_t rows, size_t cols, MatrixLayout layout) {
+	MatrixFileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, kMatrixFileMagic, sizeof(header.magic));
+	header.version = kMatrixFileVersion;
+	header.dtype = kMatrixDtypeFloat64;
+	header.layout = (uint32_t)layout;
+	header.alignment = kMatrixFileAlignment;
+	header.rows = rows;
+	header.cols = cols;
+	header.dataOffset = kMatrixFileAlignment;
+	return header;
+}
+
+static bool HasMatrixFileMagic(const MappedFile& file) {
+	return file.Size() >= sizeof(MatrixFileHeader) && std::memcmp(file.Data(), kMatrixFileMagic, sizeof(kMatrixFileMagic)) == 0;
+}
+
+// Проверка заголовка отображенного файла: O(1), данные не читаются
+static bool ParseMatrixFile(const MappedFile& file, MatrixFileHeader& header, std::string& error) {
+	if (!HasMatrixFileMagic(file)) {
+		error = "Не файл матрицы .nmat (неверная сигнатура)";
+		return false;
+	}
+	std::memcpy(&header, file.Data(), sizeof(header));
+
+	if (header.version != kMatrixFileVersion) {
+		error = "Неподдерживаемая версия формата .nmat: " + std::to_string(header.version);
+		return false;
+	}
+	if (header.dtype != kMatrixDtypeFloat64) {
+		error = "Поддерживается только dtype float64";
+		return false;
+	}
+	if (header.layout > (uint32_t)MatrixLayout::ColMajor) {
+		error = "Неизвестный layout матрицы";
+		return false;
+	}
+	if (header.alignment < sizeof(double) || (header.alignment & (header.alignment - 1)) != 0
+		|| header.dataOffset < sizeof(MatrixFileHeader) || header.dataOffset % header.alignment != 0) {
+		error = "Неверное выравнивание данных матрицы";
+		return false;
+	}
+	if (header.rows == 0 || header.cols == 0 || header.rows > SIZE_MAX / sizeof(double) / header.cols) {
+		error = "Неверные размеры матрицы";
+		return false;
+	}
+	const uint64_t bytes = header.rows * header.cols * sizeof(double);
+	if (header.dataOffset > file.Size() || file.Size() - header.dataOffset < bytes) {
+		error = "Файл матрицы обрезан";
+		return false;
+	}
+	return true;
+}
+
+static const double* MatrixFileData(const MappedFile& file, const MatrixFileHeader& header) {
+	return reinterpret_cast<const double*>(file.Data() + header.dataOffset);
+}
+
+// Полная проверка данных - один проход по файлу, поэтому только по запросу
+static bool VerifyMatrixFile(const MappedFile& file, const MatrixFileHeader& header, std::string& error) {
+	if (MatrixChecksum(MatrixFileData(file, header), header.rows * header.cols) != header.checksum) {
+		error = "Контрольная сумма файла матрицы не совпадает";
+		return false;
+	}
+	return true;
+}
+
+// Сохранение row-major данных в .nmat; для column-major данные транспонируются при записи
+static bool WriteMatrixFile(const std::string& path, const double* rowMajor, size_t rows, size_t cols, MatrixLayout layout, std::string& error) {
+	std::vector<double> transposed;
+	const double* data = rowMajor;
+	if (layout == MatrixLayout::ColMajor) {
+		TransposeRowMajor(rowMajor, rows, cols, transposed);
+		data = transposed.data();
+	}
+
+	MatrixFileHeader header = MakeMatrixFileHeader(rows, cols, layout);
+	header.checksum = MatrixChecksum(data, rows * cols);
+
+	const std::string tmpPath = TempSiblingPath(path);
+	FILE* file = std::fopen(tmpPath.c_str(), "wb");
+	if (!file) {
+		error = "Не удалось создать файл " + tmpPath + ": " + std::strerror(errno);
+		return false;
+	}
+
+	const size_t count = rows * cols;
+	bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	ok = ok && std::fwrite(data, sizeof(double), count, file) == count;
+	ok = std::fclose(file) == 0 && ok;
+	if (!ok) {
+		error = "Ошибка записи файла " + tmpPath;
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+	return ReplaceFile(tmpPath, path, error);
+}
@@ -0,0 +1,273 @@
+#include <napi.h>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// Данные аддона на экземпляр (env), а не в static-переменных: у каждого worker_thread свои
+struct MatrixAddonData {
+	Napi::FunctionReference matrixConstructor;
+	SimdFlightTable simdFlights;
+	// Ссылки на общие матрицы (id -> сколько раз взяты этим env): отпускаются, когда поток завершается
+	std::unordered_map<uint64_t, size_t> sharedRefs;
+	// Очередь допуска в бюджет потоков; создается при первой async-задаче, удаляется вместе со своим tsfn
+	BudgetDispatcher* budgetDispatcher = nullptr;
+
+	~MatrixAddonData() {
+		for (const auto& ref : sharedRefs) {
+			for (size_t i = 0; i < ref.second; ++i) {
+				GetSharedMatrixStore().Release(ref.first);
+			}
+		}
+	}
+};
+
+SimdFlightTable& GetSimdFlights(Napi::Env env) {
+	return env.GetInstanceData<MatrixAddonData>()->simdFlights;
+}
+
+BudgetDispatcher* GetBudgetDispatcher(Napi::Env env) {
+	MatrixAddonData* data = env.GetInstanceData<MatrixAddonData>();
+	if (data->budgetDispatcher == nullptr) {
+		data->budgetDispatcher = BudgetDispatcher::Create(env);
+	}
+	return data->budgetDispatcher;
+}
+
+// Нативная матрица с ленивыми операциями:
+// A.mul(B).add(C).scale(2).relu() строит дерево, eval()/evalAsync() считают его одним проходом
+class MatrixObject : public Napi::ObjectWrap<MatrixObject> {
+public:
+	static Napi::Function Init(Napi::Env env) {
+		return DefineClass(env, "Matrix", {
+			InstanceAccessor("rows", &MatrixObject::Rows, nullptr),
+			InstanceAccessor("cols", &MatrixObject::Cols, nullptr),
+			InstanceAccessor("lazy", &MatrixObject::IsLazy, nullptr),
+			InstanceMethod("mul", &MatrixObject::Mul),
+			InstanceMethod("add", &MatrixObject::Add),
+			InstanceMethod("scale", &MatrixObject::Scale),
+			InstanceMethod("relu", &MatrixObject::Relu),
+			InstanceMethod("eval", &MatrixObject::Eval),
+			InstanceMethod("evalAsync", &MatrixObject::EvalAsync),
+			InstanceMethod("get", &MatrixObject::Get),
+			InstanceMethod("toArray", &MatrixObject::ToArray),
+			InstanceMethod("save", &MatrixObject::Save),
+		});
+	}
+
+	static Napi::Object NewInstance(Napi::Env env, ExprNodePtr node) {
+		MatrixAddonData* data = env.GetInstanceData<MatrixAddonData>();
+		Napi::Object obj = data->matrixConstructor.New({});
+		MatrixObject::Unwrap(obj)->node_ = std::move(node);
+		return obj;
+	}
+
+	// Достать узел из JS-значения, если это Matrix
+	static ExprNodePtr NodeFromValue(Napi::Env env, const Napi::Value& value) {
+		MatrixAddonData* data = env.GetInstanceData<MatrixAddonData>();
+		if (!value.IsObject() || !value.As<Napi::Object>().InstanceOf(data->matrixConstructor.Value())) {
+			return nullptr;
+		}
+		return MatrixObject::Unwrap(value.As<Napi::Object>())->node_;
+	}
+
+	// new Matrix(number[][]) или new Matrix(Float64Array, rows, cols)
+	MatrixObject(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MatrixObject>(info) {
+		Napi::Env env = info.Env();
+
+		if (info.Length() == 0) {
+			return; // узел выставит NewInstance
+		}
+
+		auto data = std::make_shared<MatrixData>();
+
+		if (info[0].IsArray()) {
+			Napi::Array arr = info[0].As<Napi::Array>();
+			if (!ReadShape(arr, data->rows, data->cols) || data->rows == 0 || data->cols == 0) {
+				Napi::Error::New(env, "Неверные размеры матрицы").ThrowAsJavaScriptException();
+				return;
+			}
+			FlattenRowMajor(arr, data->rows, data->cols, data->values);
+		} else if (info[0].IsTypedArray()
+			&& info[0].As<Napi::TypedArray>().TypedArrayType() == napi_float64_array
+			&& info.Length() >= 3 && info[1].IsNumber() && info[2].IsNumber()) {
+			Napi::Float64Array flat = info[0].As<Napi::Float64Array>();
+			data->rows = info[1].As<Napi::Number>().Uint32Value();
+			data->cols = info[2].As<Napi::Number>().Uint32Value();
+			if (data->rows == 0 || data->cols == 0 || flat.ElementLength() != data->rows * data->cols) {
+				Napi::Error::New(env, "Неверные размеры матрицы").ThrowAsJavaScriptException();
+				return;
+			}
+			data->values.assign(flat.Data(), flat.Data() + flat.ElementLength());
+		} else {
+			Napi::TypeError::New(env, "Ожидается number[][] или Float64Array, rows, cols").ThrowAsJavaScriptException();
+			return;
+		}
+
+		node_ = MakeLeafNode(std::move(data));
+	}
+
+	const ExprNodePtr& Node() const { return node_; }
+
+private:
+	bool CheckInitialized(Napi::Env env) {
+		if (!node_) {
+			Napi::Error::New(env, "Матрица не инициализирована").ThrowAsJavaScriptException();
+			return false;
+		}
+		return true;
+	}
+
+	Napi::Value Rows(const Napi::CallbackInfo& info) {
+		if (!CheckInitialized(info.Env())) return info.Env().Null();
+		return Napi::Number::New(info.Env(), (double)node_->rows);
+	}
+
+	Napi::Value Cols(const Napi::CallbackInfo& info) {
+		if (!CheckInitialized(info.Env())) return info.Env().Null();
+		return Napi::Number::New(info.Env(), (double)node_->cols);
+	}
+
+	Napi::Value IsLazy(const Napi::CallbackInfo& info) {
+		if (!CheckInitialized(info.Env())) return info.Env().Null();
+		return Napi::Boolean::New(info.Env(), node_->op != ExprOp::Leaf);
+	}
+
+	Napi::Value Mul(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		if (!CheckInitialized(env)) return env.Null();
+
+		ExprNodePtr other = info.Length() > 0 ? NodeFromValue(env, info[0]) : nullptr;
+		if (!other) {
+			Napi::TypeError::New(env, "Ожидается Matrix").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		if (node_->cols != other->rows) {
+			Napi::Error::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		return NewInstance(env, MakeExprNode(ExprOp::MatMul, node_, other));
+	}
+
+	Napi::Value Add(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		if (!CheckInitialized(env)) return env.Null();
+
+		ExprNodePtr other = info.Length() > 0 ? NodeFromValue(env, info[0]) : nullptr;
+		if (!other) {
+			Napi::TypeError::New(env, "Ожидается Matrix").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		if (node_->rows != other->rows || node_->cols != other->cols) {
+			Napi::Error::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		return NewInstance(env, MakeExprNode(ExprOp::Add, node_, other));
+	}
+
+	Napi::Value Scale(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		if (!CheckInitialized(env)) return env.Null();
+
+		if (info.Length() < 1 || !info[0].IsNumber()) {
+			Napi::TypeError::New(env, "Ожидается число").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		double s = info[0].As<Napi::Number>().DoubleValue();
+		return NewInstance(env, MakeExprNode(ExprOp::Scale, node_, nullptr, s));
+	}
+
+	Napi::Value Relu(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		if (!CheckInitialized(env)) return env.Null();
+		return NewInstance(env, MakeExprNode(ExprOp::Relu, node_, nullptr));
+	}
+
+	Napi::Value Eval(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		if (!CheckInitialized(env)) return env.Null();
+		return NewInstance(env, MakeLeafNode(EvaluateExpr(node_)));
+	}
+
+	Napi::Value EvalAsync(const Napi::CallbackInfo& info);
+	Napi::Value Save(const Napi::CallbackInfo& info);
+
+	Napi::Value Get(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		if (!CheckInitialized(env)) return env.Null();
+
+		if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+			Napi::TypeError::New(env, "Ожидается: i, j").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		if (node_->op != ExprOp::Leaf) {
+			node_ = MakeLeafNode(EvaluateExpr(node_));
+		}
+
+		const size_t i = info[0].As<Napi::Number>().Uint32Value();
+		const size_t j = info[1].As<Napi::Number>().Uint32Value();
+		if (i >= node_->rows || j >= node_->cols) {
+			Napi::RangeError::New(env, "Индекс вне матрицы").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		return Napi::Number::New(env, node_->leaf->Data()[i * node_->cols + j]);
+	}
+
+	Napi::Value ToArray(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		if (!CheckInitialized(env)) return env.Null();
+
+		// Ленивое выражение вычисляется один раз, дальше объект хранит результат
+		if (node_->op != ExprOp::Leaf) {
+			node_ = MakeLeafNode(EvaluateExpr(node_));
+		}
+		return RowMajorToJs(env, node_->leaf->Data(), node_->rows, node_->cols);
+	}
+
+	ExprNodePtr node_;
+};
+
+class MatrixEvalWorker : public Napi::AsyncWorker {
+public:
+	MatrixEvalWorker(Napi::Function& cb, ExprNodePtr node)
+	: Napi::AsyncWorker(cb), node_(std::move(node)) {}
+
+	ThreadSlot& Slot() { return slot_; }
+
+	void Execute() override {
+		ThreadSlot::Hold hold(slot_);
+		// Дерево неизменяемо и держится через shared_ptr - можно считать вне main thread
+		result_ = EvaluateExpr(node_);
+	}
+
+	void OnOK() override {
+		Napi::Env env = Env();
+		Napi::HandleScope scope(env);
+		Callback().Call({ env.Null(), MatrixObject::NewInstance(env, MakeLeafNode(result_)) });
+	}
+
+	void OnError(const Napi::Error& e) override {
+		Napi::Env env = Env();
+		Callback().Call({ e.Value(), env.Undefined() });
+	}
+
+private:
+	ExprNodePtr node_;
+	MatrixDataPtr result_;
+	ThreadSlot slot_;
+};
+
+Napi::Value MatrixObject::EvalAsync(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+	if (!CheckInitialized(env)) return env.Null();
+
+	if (info.Length() < 1 || !info[0].IsFunction()) {
+		Napi::TypeError::New(env, "Ожидается callback").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	Napi::Function cb = info[0].As<Napi::Function>();
+	auto* worker = new MatrixEvalWorker(cb, node_);
+	QueueWithBudget(env, worker, 1);
+
+	return env.Undefined();
+}
@@ -0,0 +1,353 @@
+#include <napi.h>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+// Умножение матриц, которые не помещаются в память: A, B и C - файлы, отображенные через mmap.
+// Порядок обхода выбран под повторное использование данных:
+// 1. Внешний цикл - панели столбцов B (tileCols). Панель упаковывается в BT один раз
+//    и остается в памяти, пока через нее проходят все строки A. Если tileCols кратна 512 double
+//    (страница), каждая страница B читается с диска ровно один раз
+// 2. Внутренний цикл - полосы строк A (tileRows) читаются подряд, следующая полоса
+//    заранее запрашивается через MADV_WILLNEED, пока считается текущая
+// 3. Направление обхода полос A чередуется между панелями: последние прочитанные полосы A
+//    еще в page cache и нужны первыми в следующем проходе
+// 4. Полоса C пишется прямо в отображение выходного файла; после последнего прохода
+//    ее страницы отправляются на диск (MS_ASYNC), а страницы полосы A отпускаются
+struct OutOfCoreConfig {
+	size_t memoryBytes = 256 * 1024 * 1024;   // бюджет на панель BT и полосы A
+	size_t tileRows = 0;                      // 0 - из бюджета
+	size_t tileCols = 0;                      // 0 - из бюджета
+};
+
+struct OutOfCorePlan {
+	size_t tileRows = 0;
+	size_t tileCols = 0;
+	size_t rowPanels = 0;
+	size_t colPanels = 0;
+};
+
+static constexpr size_t kDoublesPerPage = 512;
+
+static OutOfCorePlan PlanOutOfCore(size_t m, size_t k, size_t n, const OutOfCoreConfig& config) {
+	OutOfCorePlan plan;
+	const size_t rowBytes = k * sizeof(double);
+
+	// Половина бюджета - панель BT (tileCols x k)
+	plan.tileCols = config.tileCols;
+	if (plan.tileCols == 0) {
+		plan.tileCols = std::max<size_t>(1, config.memoryBytes / 2 / rowBytes);
+		if (plan.tileCols < n && plan.tileCols >= kDoublesPerPage) {
+			plan.tileCols = plan.tileCols / kDoublesPerPage * kDoublesPerPage;
+		}
+	}
+	plan.tileCols = std::min(plan.tileCols, n);
+
+	// Четверть бюджета - полоса A, еще четверть - следующая полоса, запрошенная заранее
+	plan.tileRows = config.tileRows > 0 ? config.tileRows : std::max<size_t>(1, config.memoryBytes / 4 / rowBytes);
+	plan.tileRows = std::min(plan.tileRows, m);
+
+	plan.rowPanels = (m + plan.tileRows - 1) / plan.tileRows;
+	plan.colPanels = (n + plan.tileCols - 1) / plan.tileCols;
+	return plan;
+}
+
+// A(m x k), B(k x n) row-major по смещениям aOffset/bOffset в своих файлах -> C(m x n) по cOffset.
+// C должна быть заполнена нулями (новый файл). onTile(done, total) - после каждой полосы.
+// false - отменено по cancel между полосами, C посчитана не полностью
+static bool OutOfCoreGemm(
+	const MappedFile& aFile, size_t aOffset,
+	const MappedFile& bFile, size_t bOffset,
+	const MappedFile& cFile, size_t cOffset,
+	size_t m, size_t k, size_t n,
+	const OutOfCorePlan& plan,
+	const std::function<void(size_t, size_t)>& onTile,
+	const CancelToken* cancel = nullptr)
+{
+	const double* A = reinterpret_cast<const double*>(aFile.Data() + aOffset);
+	const double* B = reinterpret_cast<const double*>(bFile.Data() + bOffset);
+	double* C = reinterpret_cast<double*>(cFile.Data() + cOffset);
+
+	const size_t aRowBytes = k * sizeof(double);
+	const size_t total = plan.rowPanels * plan.colPanels;
+	size_t done = 0;
+
+	aFile.Advise(aOffset, m * aRowBytes, MapAdvice::Sequential);
+	bFile.Advise(bOffset, k * n * sizeof(double), MapAdvice::Sequential);
+
+	std::vector<double> BT(plan.tileCols * k);
+
+	for (size_t cp = 0; cp < plan.colPanels; ++cp) {
+		const size_t j0 = cp * plan.tileCols;
+		const size_t cols = std::min(plan.tileCols, n - j0);
+		const bool lastPass = cp + 1 == plan.colPanels;
+
+		// Упаковка панели B[:, j0:j0+cols] в BT(cols x k): B читается строками подряд
+		for (size_t t = 0; t < k; ++t) {
+			const double* bRow = B + t * n + j0;
+			for (size_t jj = 0; jj < cols; ++jj) {
+				BT[jj * k + t] = bRow[jj];
+			}
+		}
+		if (lastPass) {
+			bFile.Advise(bOffset, k * n * sizeof(double), MapAdvice::DontNeed);
+		}
+
+		const bool forward = cp % 2 == 0;
+		for (size_t step = 0; step < plan.rowPanels; ++step) {
+			if (IsCancelled(cancel)) {
+				return false;
+			}
+			const size_t rp = forward ? step : plan.rowPanels - 1 - step;
+			const size_t i0 = rp * plan.tileRows;
+			const size_t rows = std::min(plan.tileRows, m - i0);
+
+			if (step + 1 < plan.rowPanels) {
+				const size_t next = forward ? rp + 1 : rp - 1;
+				const size_t nextRows = std::min(plan.tileRows, m - next * plan.tileRows);
+				aFile.Advise(aOffset + next * plan.tileRows * aRowBytes, nextRows * aRowBytes, MapAdvice::WillNeed);
+			}
+
+			ParallelGemmAccumulate(A + i0 * k, k, BT.data(), k, rows, k, cols, 1.0, C + i0 * n + j0, n);
+
+			if (lastPass) {
+				cFile.FlushAsync(cOffset + i0 * n * sizeof(double), rows * n * sizeof(double));
+				aFile.Advise(aOffset + i0 * aRowBytes, rows * aRowBytes, MapAdvice::DontNeed);
+			}
+			onTile(++done, total);
+		}
+	}
+	return true;
+}
+
+struct OutOfCoreProgress {
+	size_t done;
+	size_t total;
+};
+
+class OutOfCoreWorker : public Napi::AsyncProgressWorker<OutOfCoreProgress> {
+public:
+	OutOfCoreWorker(
+		Napi::Env env,
+		std::string aPath, std::string bPath, std::string outPath,
+		size_t m, size_t k, size_t n,
+		bool withHeader,
+		const OutOfCoreConfig& config,
+		Napi::Function onProgress,
+		AbortBinding&& abort)
+	: Napi::AsyncProgressWorker<OutOfCoreProgress>(env),
+	deferred_(Napi::Promise::Deferred::New(env)),
+	abort_(std::move(abort)),
+	aPath_(std::move(aPath)), bPath_(std::move(bPath)), outPath_(std::move(outPath)),
+	m_(m), k_(k), k2_(k), n_(n),
+	withHeader_(withHeader),
+	config_(config) {
+		if (!onProgress.IsEmpty()) {
+			onProgress_ = Napi::Persistent(onProgress);
+		}
+	}
+
+	Napi::Promise Promise() const { return deferred_.Promise(); }
+	AbortBinding& Abort() { return abort_; }
+	void Reject(Napi::Value error) { deferred_.Reject(error); }
+	ThreadSlot& Slot() { return slot_; }
+
+	void Execute(const ExecutionProgress& progress) override {
+		ThreadSlot::Hold hold(slot_);
+		const CancelToken& cancel = *abort_.Token();
+		if (cancel.Cancelled()) {
+			SetError("cancelled");
+			return;
+		}
+		const auto start = std::chrono::steady_clock::now();
+		std::string error;
+
+		MappedFile aFile, bFile, cFile;
+		if (!aFile.OpenRead(aPath_, error) || !bFile.OpenRead(bPath_, error)) {
+			SetError(error);
+			return;
+		}
+
+		// Файлы .nmat задают размеры и смещение данных сами, сырые - только с явными m, k, n
+		size_t aOffset = 0, bOffset = 0;
+		if (!ReadOperand(aFile, aOffset, m_, k_, "A", error) || !ReadOperand(bFile, bOffset, k2_, n_, "B", error)) {
+			SetError(error);
+			return;
+		}
+		if (k_ != k2_) {
+			SetError("Неверные размеры матриц");
+			return;
+		}
+
+		// Результат - во временный файл рядом и rename в конце: читатели старого outPath не получат
+		// обрезанный файл, а совпадение outPath с входом не портит вход
+		const size_t cOffset = withHeader_ ? kMatrixFileAlignment : 0;
+		const std::string tmpPath = TempSiblingPath(outPath_);
+		if (!cFile.Create(tmpPath, cOffset + m_ * n_ * sizeof(double), error)) {
+			SetError(error);
+			return;
+		}
+
+		plan_ = PlanOutOfCore(m_, k_, n_, config_);
+		const bool completed = OutOfCoreGemm(aFile, aOffset, bFile, bOffset, cFile, cOffset, m_, k_, n_, plan_, [&progress](size_t done, size_t total) {
+			OutOfCoreProgress update{ done, total };
+			progress.Send(&update, 1);
+		}, &cancel);
+		if (!completed) {
+			// Недосчитанный результат не должен заменить outPath
+			cFile.Close();
+			std::remove(tmpPath.c_str());
+			SetError("cancelled");
+			return;
+		}
+
+		if (withHeader_) {
+			// Контрольная сумма - еще один последовательный проход по C, на фоне O(m*n*k) незаметен
+			MatrixFileHeader header = MakeMatrixFileHeader(m_, n_, MatrixLayout::RowMajor);
+			header.checksum = MatrixChecksum(reinterpret_cast<const double*>(cFile.Data() + cOffset), m_ * n_);
+			std::memcpy(cFile.Data(), &header, sizeof(header));
+		}
+		cFile.Close();
+		if (!ReplaceFile(tmpPath, outPath_, error)) {
+			SetError(error);
+			return;
+		}
+
+		ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void OnProgress(const OutOfCoreProgress* data, size_t count) override {
+		if (onProgress_.IsEmpty() || data == nullptr || count == 0) {
+			return;
+		}
+		Napi::Env env = Env();
+		Napi::HandleScope scope(env);
+		onProgress_.Call({ Napi::Number::New(env, (double)data->done), Napi::Number::New(env, (double)data->total) });
+	}
+
+	void OnOK() override {
+		Napi::Env env = Env();
+		Napi::HandleScope scope(env);
+
+		Napi::Object result = Napi::Object::New(env);
+		result.Set("path", Napi::String::New(env, outPath_));
+		result.Set("rows", Napi::Number::New(env, (double)m_));
+		result.Set("cols", Napi::Number::New(env, (double)n_));
+		result.Set("tileRows", Napi::Number::New(env, (double)plan_.tileRows));
+		result.Set("tileCols", Napi::Number::New(env, (double)plan_.tileCols));
+		result.Set("passes", Napi::Number::New(env, (double)plan_.colPanels));
+		result.Set("ms", Napi::Number::New(env, ms_));
+		abort_.Detach();
+		deferred_.Resolve(result);
+	}
+
+	void OnError(const Napi::Error& e) override {
+		abort_.Detach();
+		deferred_.Reject(abort_.Token()->Reason() != CancelReason::None ? abort_.Error(Env()) : e.Value());
+	}
+
+private:
+	bool ReadOperand(const MappedFile& file, size_t& offset, size_t& rows, size_t& cols, const char* name, std::string& error) {
+		if (!withHeader_) {
+			if (file.Size() != rows * cols * sizeof(double)) {
+				error = std::string("Размер файла ") + name + " не совпадает с размерами матрицы";
+				return false;
+			}
+			return true;
+		}
+
+		MatrixFileHeader header;
+		if (!ParseMatrixFile(file, header, error)) {
+			return false;
+		}
+		if (header.layout != (uint32_t)MatrixLayout::RowMajor) {
+			error = std::string("Матрица ") + name + ": out-of-core умножение поддерживает только row-major";
+			return false;
+		}
+		offset = header.dataOffset;
+		rows = header.rows;
+		cols = header.cols;
+		return true;
+	}
+
+	Napi::Promise::Deferred deferred_;
+	AbortBinding abort_;
+	std::string aPath_, bPath_, outPath_;
+	size_t m_, k_, k2_, n_;
+	bool withHeader_;
+	OutOfCoreConfig config_;
+	OutOfCorePlan plan_;
+	Napi::FunctionReference onProgress_;
+	double ms_ = 0.0;
+	ThreadSlot slot_;
+};
+
+// multiplyFilesAsync(aPath, bPath, outPath[, m, k, n][, { memoryBytes, tileRows, tileCols, onProgress, signal, timeout }])
+// С m, k, n - сырые row-major double без заголовка; без них - файлы .nmat (см. matrix_file_base.cpp),
+// размеры берутся из заголовков, результат тоже пишется в .nmat. Promise разрешается описанием результата
+Napi::Value MultiplyFilesAsync(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	if (info.Length() < 3 || !info[0].IsString() || !info[1].IsString() || !info[2].IsString()) {
+		Napi::TypeError::New(env, "Ожидается: aPath, bPath, outPath[, m, k, n][, options]").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	const bool withHeader = info.Length() < 4 || !info[3].IsNumber();
+	size_t m = 0, k = 0, n = 0;
+	size_t optionsIndex = 3;
+	if (!withHeader) {
+		if (info.Length() < 6 || !info[4].IsNumber() || !info[5].IsNumber()) {
+			Napi::TypeError::New(env, "Ожидается: aPath, bPath, outPath, m, k, n").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		m = info[3].As<Napi::Number>().Uint32Value();
+		k = info[4].As<Napi::Number>().Uint32Value();
+		n = info[5].As<Napi::Number>().Uint32Value();
+		if (m == 0 || k == 0 || n == 0) {
+			Napi::Error::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		optionsIndex = 6;
+	}
+
+	OutOfCoreConfig config;
+	Napi::Function onProgress;
+	AbortBinding abort;
+	if (info.Length() > optionsIndex && !info[optionsIndex].IsUndefined()) {
+		if (!info[optionsIndex].IsObject()) {
+			Napi::TypeError::New(env, "Ожидается объект { memoryBytes, tileRows, tileCols, onProgress, signal, timeout }").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		Napi::Object opts = info[optionsIndex].As<Napi::Object>();
+		if (opts.Has("memoryBytes") && opts.Get("memoryBytes").IsNumber()) {
+			config.memoryBytes = std::max<size_t>(1, (size_t)opts.Get("memoryBytes").As<Napi::Number>().DoubleValue());
+		}
+		if (opts.Has("tileRows") && opts.Get("tileRows").IsNumber()) {
+			config.tileRows = opts.Get("tileRows").As<Napi::Number>().Uint32Value();
+		}
+		if (opts.Has("tileCols") && opts.Get("tileCols").IsNumber()) {
+			config.tileCols = opts.Get("tileCols").As<Napi::Number>().Uint32Value();
+		}
+		if (opts.Has("onProgress") && opts.Get("onProgress").IsFunction()) {
+			onProgress = opts.Get("onProgress").As<Napi::Function>();
+		}
+		if (!abort.Read(env, opts)) {
+			return env.Null();
+		}
+	}
+	if (abort.AbortedAlready()) {
+		return RejectedPromise(env, abort.Error(env));
+	}
+
+	auto* worker = new OutOfCoreWorker(env,
+		info[0].As<Napi::String>().Utf8Value(),
+		info[1].As<Napi::String>().Utf8Value(),
+		info[2].As<Napi::String>().Utf8Value(),
+		m, k, n, withHeader, config, onProgress, std::move(abort));
+	return QueueAbortable(env, worker, GetComputePool()->ThreadCount());
+}
@@ -0,0 +1,217 @@
+#include <napi.h>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+// Умножение на пуле: A делится на полосы строк по NUMA-узлам, каждая полоса A, своя копия BT
+// и полоса C лежат в памяти своего узла и считаются потоками этого узла
+struct NumaMatmulResult {
+	std::vector<NumaBuffer> chunks;   // полоса C на каждый узел
+	std::vector<size_t> bounds;       // строки [bounds[i], bounds[i + 1]) лежат в chunks[i]
+};
+
+// cancel проверяется перед каждой полосой: после отмены оставшиеся полосы пропускаются, результат неполный
+static NumaMatmulResult NumaMatmul(ComputePool& pool, const double* A, const std::vector<double>& BT, size_t m, size_t k, size_t n, const CancelToken* cancel = nullptr, const KernelTuning& tuning = CurrentKernelTuning()) {
+	NumaMatmulResult result;
+	result.bounds = pool.SplitByNodes(m);
+	result.chunks.resize(pool.NodeCount());
+
+	std::vector<NumaBuffer> aPanels(pool.NodeCount()), btCopies(pool.NodeCount());
+
+	// 1. Выделяем и заполняем буферы на потоке узла: с libnuma память сразу на узле,
+	// без нее страницы достаются узлу потока, который первым их коснулся (first-touch)
+	pool.RunOnEachNode([&](size_t node) {
+		const size_t rowBegin = result.bounds[node];
+		const size_t rows = result.bounds[node + 1] - rowBegin;
+		if (rows == 0) {
+			return;
+		}
+		const int nodeId = pool.NodeId(node);
+		const bool useLibNuma = pool.UsesLibNuma();
+
+		aPanels[node].Allocate(rows * k, nodeId, useLibNuma);
+		std::copy(A + rowBegin * k, A + (rowBegin + rows) * k, aPanels[node].Data());
+
+		// BT читают все строки узла, поэтому на многосокетной машине дешевле держать копию на каждом узле
+		if (pool.NodeCount() > 1) {
+			btCopies[node].Allocate(n * k, nodeId, useLibNuma);
+			std::copy(BT.begin(), BT.end(), btCopies[node].Data());
+		}
+
+		// C тоже трогаем здесь: в шаге 2 полосу может украсть поток другого узла,
+		// и без этого страницы достались бы ему
+		result.chunks[node].Allocate(rows * n, nodeId, useLibNuma);
+		std::fill(result.chunks[node].Data(), result.chunks[node].Data() + rows * n, 0.0);
+	});
+
+	// 2. Считаем полосами по grain строк. Полосы берет в первую очередь свой узел, но простаивающие
+	// потоки других узлов их крадут: такая полоса читает и пишет удаленную память, зато узлы не ждут друг друга
+	const size_t grain = tuning.poolGrain > 0 ? tuning.poolGrain : std::max<size_t>(1, std::min<size_t>(64, m / (pool.ThreadCount() * 4)));
+	pool.ParallelForNodes(result.bounds, grain, [&](size_t node, size_t b, size_t e) {
+		if (IsCancelled(cancel)) {
+			return;
+		}
+		const size_t rowBegin = result.bounds[node];
+		const double* bt = pool.NodeCount() > 1 ? btCopies[node].Data() : BT.data();
+		SimdMatmulRowRange(aPanels[node].Data(), bt, k, n, b - rowBegin, e - rowBegin, result.chunks[node].Data(), tuning.blockCols);
+	});
+
+	return result;
+}
+
+// Полосы C по узлам -> number[][]
+static Napi::Array NumaResultToJs(Napi::Env env, const NumaMatmulResult& result, size_t m, size_t n) {
+	Napi::Array C = Napi::Array::New(env, m);
+	for (size_t node = 0; node < result.chunks.size(); ++node) {
+		const size_t rowBegin = result.bounds[node];
+		for (size_t i = rowBegin; i < result.bounds[node + 1]; ++i) {
+			const double* src = result.chunks[node].Data() + (i - rowBegin) * n;
+			Napi::Array row = Napi::Array::New(env, n);
+			for (size_t j = 0; j < n; ++j) {
+				row[j] = Napi::Number::New(env, src[j]);
+			}
+			C[i] = row;
+		}
+	}
+	return C;
+}
+
+class PoolMultiplyWorker : public Napi::AsyncWorker {
+public:
+	PoolMultiplyWorker(
+		Napi::Function& cb,
+		std::vector<double>&& A_rowMajor,
+		std::vector<double>&& BT_rowMajor,
+		size_t m, size_t k, size_t n,
+		const KernelTuning& tuning)
+	: Napi::AsyncWorker(cb),
+	A_(std::move(A_rowMajor)),
+	BT_(std::move(BT_rowMajor)),
+	m_(m), k_(k), n_(n),
+	tuning_(tuning) {}
+
+	ThreadSlot& Slot() { return slot_; }
+
+	void Execute() override {
+		ThreadSlot::Hold hold(slot_);
+		std::shared_ptr<ComputePool> pool = GetComputePool();
+		result_ = NumaMatmul(*pool, A_.data(), BT_, m_, k_, n_, nullptr, tuning_);
+	}
+
+	void OnOK() override {
+		Napi::Env env = Env();
+		Napi::HandleScope scope(env);
+		Callback().Call({ env.Null(), NumaResultToJs(env, result_, m_, n_) });
+	}
+
+	void OnError(const Napi::Error& e) override {
+		Napi::Env env = Env();
+		Callback().Call({ e.Value(), env.Undefined() });
+	}
+
+private:
+	std::vector<double> A_, BT_;
+	NumaMatmulResult result_;
+	size_t m_, k_, n_;
+	KernelTuning tuning_;
+	ThreadSlot slot_;
+};
+
+// multiplyPoolAsync(A, B[, { blockCols, poolGrain }], cb) - как multiplySimdAsync, но на всех потоках пула
+Napi::Value MultiplyPoolAsync(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	// callback последний: (A, B, cb) или (A, B, { blockCols, poolGrain }, cb)
+	const size_t cbIndex = info.Length() >= 4 ? 3 : 2;
+	if (info.Length() < 3 || !info[0].IsArray() || !info[1].IsArray() || !info[cbIndex].IsFunction()) {
+		Napi::TypeError::New(env, "Ожидается 2 матрицы: matrixA, matrixB и callback").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	KernelTuning tuning;
+	if (!ReadKernelTuning(cbIndex == 3 ? info[2] : env.Undefined(), tuning)) {
+		Napi::TypeError::New(env, "Ожидается объект { blockCols, poolGrain } с целыми неотрицательными числами").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	Napi::Array Ajs = info[0].As<Napi::Array>();
+	Napi::Array Bjs = info[1].As<Napi::Array>();
+	Napi::Function cb = info[cbIndex].As<Napi::Function>();
+
+	size_t m, k, k2, n;
+	if (!ReadShape(Ajs, m, k) || !ReadShape(Bjs, k2, n) || k == 0 || n == 0 || k2 != k) {
+		Napi::TypeError::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	std::vector<double> A_rm, B_rm, BT_rm;
+	FlattenRowMajor(Ajs, m, k, A_rm);
+	FlattenRowMajor(Bjs, k, n, B_rm);
+	TransposeRowMajor(B_rm, k, n, BT_rm);
+
+	auto* worker = new PoolMultiplyWorker(cb, std::move(A_rm), std::move(BT_rm), m, k, n, tuning);
+	QueueWithBudget(env, worker, GetComputePool()->ThreadCount());
+
+	return env.Undefined();
+}
+
+// configureComputePool({ threads, pin, numa }) - пересоздает пул с новыми настройками
+Napi::Value ConfigureComputePoolJs(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	PoolConfig config;
+	if (info.Length() > 0 && !info[0].IsUndefined()) {
+		if (!info[0].IsObject()) {
+			Napi::TypeError::New(env, "Ожидается объект { threads, pin, numa }").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		Napi::Object opts = info[0].As<Napi::Object>();
+		if (opts.Has("threads") && opts.Get("threads").IsNumber()) {
+			config.threads = opts.Get("threads").As<Napi::Number>().Uint32Value();
+		}
+		if (opts.Has("pin")) {
+			config.pin = opts.Get("pin").ToBoolean().Value();
+		}
+		if (opts.Has("numa")) {
+			config.numa = opts.Get("numa").ToBoolean().Value();
+		}
+	}
+
+	ConfigureComputePool(config);
+	return env.Undefined();
+}
+
+// getComputeTopology() -> { nodes: [{ id, cpus, threads }], threads, pin, numa, libnuma }
+Napi::Value GetComputeTopology(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+	std::shared_ptr<ComputePool> pool = GetComputePool();
+
+	Napi::Array nodes = Napi::Array::New(env, pool->NodeCount());
+	for (size_t i = 0; i < pool->NodeCount(); ++i) {
+		const NumaNodeInfo& node = pool->Topology()[i];
+		Napi::Array cpus = Napi::Array::New(env, node.cpus.size());
+		for (size_t c = 0; c < node.cpus.size(); ++c) {
+			cpus[c] = Napi::Number::New(env, node.cpus[c]);
+		}
+
+		Napi::Object obj = Napi::Object::New(env);
+		obj.Set("id", Napi::Number::New(env, node.id));
+		obj.Set("cpus", cpus);
+		obj.Set("threads", Napi::Number::New(env, (double)pool->WorkersOnNode(i)));
+		nodes[i] = obj;
+	}
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("nodes", nodes);
+	result.Set("threads", Napi::Number::New(env, (double)pool->ThreadCount()));
+	result.Set("pin", Napi::Boolean::New(env, pool->Config().pin));
+	result.Set("pinFailures", Napi::Number::New(env, (double)pool->PinFailures()));
+	if (pool->PinErrno() != 0) {
+		result.Set("pinError", Napi::String::New(env, std::strerror(pool->PinErrno())));
+	}
+	result.Set("numa", Napi::Boolean::New(env, pool->Config().numa));
+	result.Set("libnuma", Napi::Boolean::New(env, GetLibNuma().loaded));
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,419 @@
+#include <napi.h>
+#include <vector>
+#include <memory>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+
+// Кеш результатов умножения по содержимому операндов.
+// Ключ - 128-битные хеши A и B, размеры и алгоритм; значение - готовая нативная матрица.
+// Хеш не криптографический и коллизию можно подобрать, поэтому запись хранит и сами операнды:
+// попадание подтверждается совпадением указателей или memcmp данных (линейно, на фоне O(mkn) умножения дешево).
+// Данные MatrixData неизменяемы, поэтому инвалидация не нужна.
+// Попадание отдает Matrix, разделяющую буфер с кешем, без вычисления и без конвертации в JS-массивы
+
+enum class CacheAlgorithm { Simd, Pool, Accelerate };
+
+struct ResultCacheKey {
+	ContentHash a;
+	ContentHash b;
+	size_t m = 0;
+	size_t k = 0;
+	size_t n = 0;
+	CacheAlgorithm algorithm = CacheAlgorithm::Simd;
+
+	bool operator==(const ResultCacheKey& other) const {
+		return a == other.a && b == other.b && m == other.m && k == other.k && n == other.n && algorithm == other.algorithm;
+	}
+};
+
+struct ResultCacheKeyHash {
+	size_t operator()(const ResultCacheKey& key) const {
+		uint64_t h = key.a.lo ^ HashRotl(key.b.lo, 17) ^ HashRotl(key.a.hi, 29) ^ HashRotl(key.b.hi, 43);
+		h = HashRound(h, (uint64_t)key.m ^ ((uint64_t)key.n << 32));
+		h = HashRound(h, (uint64_t)key.k ^ ((uint64_t)key.algorithm << 56));
+		return (size_t)h;
+	}
+};
+
+// LRU с ограничением по байтам; общий для процесса, поэтому результаты видны всем worker_threads
+class ResultCache {
+public:
+	struct Stats {
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t insertions;
+		uint64_t evictions;
+		uint64_t rejected;   // результат больше лимита - не кешируется
+		uint64_t collisions; // совпал хеш, но не данные операндов
+		size_t entries;
+		size_t bytes;
+		size_t maxBytes;
+	};
+
+	// countMiss = false - предварительная проверка на main thread, промах досчитает воркер
+	MatrixDataPtr Lookup(const ResultCacheKey& key, const MatrixDataPtr& a, const MatrixDataPtr& b, bool countMiss = true) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = index_.find(key);
+		if (it != index_.end() && !(SameData(it->second->a, a) && SameData(it->second->b, b))) {
+			++collisions_;
+			it = index_.end();
+		}
+		if (it == index_.end()) {
+			if (countMiss) {
+				++misses_;
+			}
+			return nullptr;
+		}
+		lru_.splice(lru_.begin(), lru_, it->second);
+		++hits_;
+		return it->second->result;
+	}
+
+	// Операнды хранятся вместе с результатом и учитываются в лимите байт
+	void Insert(const ResultCacheKey& key, MatrixDataPtr a, MatrixDataPtr b, MatrixDataPtr result) {
+		const size_t bytes = (result->Size() + a->Size() + b->Size()) * sizeof(double);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (bytes > maxBytes_) {
+			++rejected_;
+			return;
+		}
+
+		auto it = index_.find(key);
+		if (it != index_.end()) {
+			// Тот же результат уже посчитал параллельный запрос (или ключ занят коллизией - оставляем прежнюю запись)
+			lru_.splice(lru_.begin(), lru_, it->second);
+			return;
+		}
+
+		lru_.push_front({ key, std::move(a), std::move(b), std::move(result), bytes });
+		index_.emplace(key, lru_.begin());
+		bytes_ += bytes;
+		++insertions_;
+		EvictLocked(maxBytes_);
+	}
+
+	void SetMaxBytes(size_t maxBytes) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		maxBytes_ = maxBytes;
+		EvictLocked(maxBytes_);
+	}
+
+	size_t Clear() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		const size_t entries = lru_.size();
+		lru_.clear();
+		index_.clear();
+		bytes_ = 0;
+		return entries;
+	}
+
+	Stats GetStats() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return { hits_, misses_, insertions_, evictions_, rejected_, collisions_, lru_.size(), bytes_, maxBytes_ };
+	}
+
+private:
+	struct Entry {
+		ResultCacheKey key;
+		MatrixDataPtr a, b;     // операнды - для проверки попадания
+		MatrixDataPtr result;   // Matrix-объекты, выданные из кеша, держат буфер и после вытеснения
+		size_t bytes;
+	};
+
+	// Размеры уже совпали в ключе; тот же объект MatrixData - без сравнения
+	static bool SameData(const MatrixDataPtr& cached, const MatrixDataPtr& operand) {
+		return cached == operand || cached->Data() == operand->Data()
+			|| std::memcmp(cached->Data(), operand->Data(), operand->Size() * sizeof(double)) == 0;
+	}
+
+	void EvictLocked(size_t maxBytes) {
+		while (bytes_ > maxBytes && !lru_.empty()) {
+			Entry& victim = lru_.back();
+			bytes_ -= victim.bytes;
+			index_.erase(victim.key);
+			lru_.pop_back();
+			++evictions_;
+		}
+	}
+
+	std::mutex mutex_;
+	std::list<Entry> lru_;
+	std::unordered_map<ResultCacheKey, std::list<Entry>::iterator, ResultCacheKeyHash> index_;
+	size_t bytes_ = 0;
+	size_t maxBytes_ = 256 * 1024 * 1024;
+	uint64_t hits_ = 0;
+	uint64_t misses_ = 0;
+	uint64_t insertions_ = 0;
+	uint64_t evictions_ = 0;
+	uint64_t rejected_ = 0;
+	uint64_t collisions_ = 0;
+};
+
+static ResultCache& GetResultCache() {
+	static ResultCache* cache = new ResultCache();
+	return *cache;
+}
+
+static ResultCacheKey MakeResultCacheKey(const MatrixData& a, const MatrixData& b, CacheAlgorithm algorithm) {
+	ResultCacheKey key;
+	key.a = MatrixContentHash(a);
+	key.b = MatrixContentHash(b);
+	key.m = a.rows;
+	key.k = a.cols;
+	key.n = b.cols;
+	key.algorithm = algorithm;
+	return key;
+}
+
+// Сколько потоков займет ComputeProduct - для бюджета потоков
+static size_t CacheAlgorithmThreads(CacheAlgorithm algorithm) {
+	switch (algorithm) {
+		case CacheAlgorithm::Pool: return GetComputePool()->ThreadCount();
+		case CacheAlgorithm::Accelerate: return BlasThreads();
+		default: return 1;
+	}
+}
+
+static bool ComputeProduct(const MatrixData& a, const MatrixData& b, CacheAlgorithm algorithm, MatrixData& result, std::string& error) {
+	const size_t m = a.rows, k = a.cols, n = b.cols;
+	result.rows = m;
+	result.cols = n;
+	result.values.resize(m * n);
+
+	if (algorithm == CacheAlgorithm::Accelerate) {
+#ifdef ACCELERATE_AVAILABLE
+		// Row-major BLAS напрямую, без перекладки в column-major
+		cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+					(int)m, (int)n, (int)k,
+					1.0,
+					a.Data(), (int)k,
+					b.Data(), (int)n,
+					0.0,
+					result.values.data(), (int)n);
+		return true;
+#else
+		error = "Accelerate framework доступен только на macOS.";
+		return false;
+#endif
+	}
+
+	std::vector<double> BT;
+	TransposeRowMajor(b.Data(), k, n, BT);
+
+	if (algorithm == CacheAlgorithm::Pool) {
+		std::shared_ptr<ComputePool> pool = GetComputePool();
+		NumaMatmulResult chunks = NumaMatmul(*pool, a.Data(), BT, m, k, n);
+		for (size_t node = 0; node < chunks.chunks.size(); ++node) {
+			const size_t rowBegin = chunks.bounds[node];
+			const size_t rows = chunks.bounds[node + 1] - rowBegin;
+			if (rows > 0) {
+				std::copy(chunks.chunks[node].Data(), chunks.chunks[node].Data() + rows * n, result.values.begin() + rowBegin * n);
+			}
+		}
+		return true;
+	}
+
+	SimdMatmulRowRange(a.Data(), BT.data(), k, n, 0, m, result.values.data());
+	return true;
+}
+
+// Результат из кеша или посчитанный и положенный в кеш; nullptr и error при ошибке
+static MatrixDataPtr CachedProduct(const MatrixDataPtr& a, const MatrixDataPtr& b, CacheAlgorithm algorithm, std::string& error) {
+	const ResultCacheKey key = MakeResultCacheKey(*a, *b, algorithm);
+	ResultCache& cache = GetResultCache();
+
+	if (MatrixDataPtr hit = cache.Lookup(key, a, b)) {
+		return hit;
+	}
+
+	auto result = std::make_shared<MatrixData>();
+	if (!ComputeProduct(*a, *b, algorithm, *result, error)) {
+		return nullptr;
+	}
+	cache.Insert(key, a, b, result);
+	return result;
+}
+
+// Операнд: Matrix (в том числе ленивая) или number[][]
+static ExprNodePtr ReadMatrixOperand(Napi::Env env, const Napi::Value& value) {
+	if (ExprNodePtr node = MatrixObject::NodeFromValue(env, value)) {
+		return node;
+	}
+	if (!value.IsArray()) {
+		return nullptr;
+	}
+
+	Napi::Array arr = value.As<Napi::Array>();
+	auto data = std::make_shared<MatrixData>();
+	if (!ReadShape(arr, data->rows, data->cols) || data->rows == 0 || data->cols == 0) {
+		return nullptr;
+	}
+	FlattenRowMajor(arr, data->rows, data->cols, data->values);
+	return MakeLeafNode(std::move(data));
+}
+
+static bool ReadCacheArgs(const Napi::CallbackInfo& info, ExprNodePtr& a, ExprNodePtr& b, CacheAlgorithm& algorithm) {
+	Napi::Env env = info.Env();
+
+	a = info.Length() > 0 ? ReadMatrixOperand(env, info[0]) : nullptr;
+	b = info.Length() > 1 ? ReadMatrixOperand(env, info[1]) : nullptr;
+	if (!a || !b) {
+		Napi::TypeError::New(env, "Ожидается 2 матрицы (Matrix или number[][]): matrixA, matrixB").ThrowAsJavaScriptException();
+		return false;
+	}
+	if (a->cols != b->rows) {
+		Napi::Error::New(env, "Неверные размеры матриц").ThrowAsJavaScriptException();
+		return false;
+	}
+
+	algorithm = CacheAlgorithm::Simd;
+	if (info.Length() > 2 && !info[2].IsUndefined()) {
+		const std::string name = info[2].IsString() ? info[2].As<Napi::String>().Utf8Value() : "";
+		if (name == "simd") {
+			algorithm = CacheAlgorithm::Simd;
+		} else if (name == "pool") {
+			algorithm = CacheAlgorithm::Pool;
+		} else if (name == "accelerate") {
+			algorithm = CacheAlgorithm::Accelerate;
+		} else {
+			Napi::TypeError::New(env, "Алгоритм: 'simd', 'pool' или 'accelerate'").ThrowAsJavaScriptException();
+			return false;
+		}
+	}
+	return true;
+}
+
+Napi::Value MultiplyCached(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	ExprNodePtr a, b;
+	CacheAlgorithm algorithm;
+	if (!ReadCacheArgs(info, a, b, algorithm)) {
+		return env.Null();
+	}
+
+	std::string error;
+	MatrixDataPtr result = CachedProduct(EvaluateExpr(a), EvaluateExpr(b), algorithm, error);
+	if (!result) {
+		Napi::Error::New(env, error).ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	return MatrixObject::NewInstance(env, MakeLeafNode(std::move(result)));
+}
+
+class CachedMultiplyWorker : public Napi::AsyncWorker {
+public:
+	CachedMultiplyWorker(Napi::Env env, ExprNodePtr a, ExprNodePtr b, CacheAlgorithm algorithm)
+	: Napi::AsyncWorker(env),
+	deferred_(Napi::Promise::Deferred::New(env)),
+	a_(std::move(a)), b_(std::move(b)),
+	algorithm_(algorithm) {}
+
+	Napi::Promise Promise() const { return deferred_.Promise(); }
+
+	ThreadSlot& Slot() { return slot_; }
+
+	void Execute() override {
+		ThreadSlot::Hold hold(slot_);
+		// Ленивые операнды и хеширование тоже вне main thread
+		std::string error;
+		result_ = CachedProduct(EvaluateExpr(a_), EvaluateExpr(b_), algorithm_, error);
+		if (!result_) {
+			SetError(error);
+		}
+	}
+
+	void OnOK() override {
+		Napi::Env env = Env();
+		Napi::HandleScope scope(env);
+		deferred_.Resolve(MatrixObject::NewInstance(env, MakeLeafNode(result_)));
+	}
+
+	void OnError(const Napi::Error& e) override {
+		deferred_.Reject(e.Value());
+	}
+
+private:
+	Napi::Promise::Deferred deferred_;
+	ExprNodePtr a_, b_;
+	CacheAlgorithm algorithm_;
+	MatrixDataPtr result_;
+	ThreadSlot slot_;
+};
+
+// Promise<Matrix>. Если операнды уже готовые матрицы с посчитанными хешами и результат в кеше,
+// промис разрешается сразу - без очереди libuv
+Napi::Value MultiplyCachedAsync(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	ExprNodePtr a, b;
+	CacheAlgorithm algorithm;
+	if (!ReadCacheArgs(info, a, b, algorithm)) {
+		return env.Null();
+	}
+
+	if (a->op == ExprOp::Leaf && b->op == ExprOp::Leaf
+		&& a->leaf->hashReady.load(std::memory_order_acquire)
+		&& b->leaf->hashReady.load(std::memory_order_acquire)) {
+		const ResultCacheKey key = MakeResultCacheKey(*a->leaf, *b->leaf, algorithm);
+		if (MatrixDataPtr hit = GetResultCache().Lookup(key, a->leaf, b->leaf, false)) {
+			Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+			deferred.Resolve(MatrixObject::NewInstance(env, MakeLeafNode(std::move(hit))));
+			return deferred.Promise();
+		}
+	}
+
+	auto* worker = new CachedMultiplyWorker(env, std::move(a), std::move(b), algorithm);
+	Napi::Promise promise = worker->Promise();
+	QueueWithBudget(env, worker, CacheAlgorithmThreads(algorithm));
+	return promise;
+}
+
+Napi::Value GetResultCacheStats(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+	const ResultCache::Stats stats = GetResultCache().GetStats();
+	const uint64_t lookups = stats.hits + stats.misses;
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("hits", Napi::Number::New(env, (double)stats.hits));
+	result.Set("misses", Napi::Number::New(env, (double)stats.misses));
+	result.Set("hitRate", Napi::Number::New(env, lookups > 0 ? (double)stats.hits / (double)lookups : 0.0));
+	result.Set("insertions", Napi::Number::New(env, (double)stats.insertions));
+	result.Set("evictions", Napi::Number::New(env, (double)stats.evictions));
+	result.Set("rejected", Napi::Number::New(env, (double)stats.rejected));
+	result.Set("collisions", Napi::Number::New(env, (double)stats.collisions));
+	result.Set("entries", Napi::Number::New(env, (double)stats.entries));
+	result.Set("bytes", Napi::Number::New(env, (double)stats.bytes));
+	result.Set("maxBytes", Napi::Number::New(env, (double)stats.maxBytes));
+	return result;
+}
+
+// configureResultCache({ maxBytes }) - уменьшение лимита сразу вытесняет старые записи
+Napi::Value ConfigureResultCache(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	if (info.Length() < 1 || !info[0].IsObject()) {
+		Napi::TypeError::New(env, "Ожидается объект { maxBytes }").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	Napi::Object options = info[0].As<Napi::Object>();
+	Napi::Value maxBytes = options.Get("maxBytes");
+	if (!maxBytes.IsNumber() || maxBytes.As<Napi::Number>().DoubleValue() < 0) {
+		Napi::TypeError::New(env, "maxBytes должен быть неотрицательным числом").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	GetResultCache().SetMaxBytes((size_t)maxBytes.As<Napi::Number>().DoubleValue());
+	return GetResultCacheStats(info);
+}
+
+Napi::Value ClearResultCache(const Napi::CallbackInfo& info) {
+	return Napi::Number::New(info.Env(), (double)GetResultCache().Clear());
+}
@@ -0,0 +1,76 @@
+#include <napi.h>
+
+// shareMatrix/getSharedMatrix: одна копия большого операнда на процесс для всех worker_threads (см. shared_store_base.cpp).
+// id - обычное число, его можно передать через postMessage или workerData
+
+static bool ReadSharedId(Napi::Env env, const Napi::CallbackInfo& info, uint64_t& id) {
+	if (info.Length() < 1 || !info[0].IsNumber() || info[0].As<Napi::Number>().DoubleValue() < 1) {
+		Napi::TypeError::New(env, "Ожидается id общей матрицы").ThrowAsJavaScriptException();
+		return false;
+	}
+	id = (uint64_t)info[0].As<Napi::Number>().Int64Value();
+	return true;
+}
+
+// shareMatrix(Matrix | number[][]) -> id. Ссылка принадлежит текущему потоку:
+// releaseSharedMatrix(id) из него же или автоматически при завершении потока
+Napi::Value ShareMatrix(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	ExprNodePtr node = info.Length() > 0 ? ReadMatrixOperand(env, info[0]) : nullptr;
+	if (!node) {
+		Napi::TypeError::New(env, "Ожидается Matrix или number[][]").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	const uint64_t id = GetSharedMatrixStore().Share(EvaluateExpr(node));
+	++env.GetInstanceData<MatrixAddonData>()->sharedRefs[id];
+	return Napi::Number::New(env, (double)id);
+}
+
+// getSharedMatrix(id) -> Matrix над теми же данными, без копирования
+Napi::Value GetSharedMatrix(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	uint64_t id;
+	if (!ReadSharedId(env, info, id)) {
+		return env.Null();
+	}
+	MatrixDataPtr data = GetSharedMatrixStore().Get(id);
+	if (!data) {
+		Napi::Error::New(env, "Нет общей матрицы с id " + std::to_string(id)).ThrowAsJavaScriptException();
+		return env.Null();
+	}
+	return MatrixObject::NewInstance(env, MakeLeafNode(std::move(data)));
+}
+
+// releaseSharedMatrix(id) -> false, если текущий поток не держит ссылку на id
+Napi::Value ReleaseSharedMatrix(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	uint64_t id;
+	if (!ReadSharedId(env, info, id)) {
+		return env.Null();
+	}
+	auto& refs = env.GetInstanceData<MatrixAddonData>()->sharedRefs;
+	auto it = refs.find(id);
+	if (it == refs.end()) {
+		return Napi::Boolean::New(env, false);
+	}
+	if (--it->second == 0) {
+		refs.erase(it);
+	}
+	return Napi::Boolean::New(env, GetSharedMatrixStore().Release(id));
+}
+
+// getSharedMatrixStats() -> { matrices, refs, bytes } по всему процессу
+Napi::Value GetSharedMatrixStats(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+	const SharedMatrixStore::Stats stats = GetSharedMatrixStore().GetStats();
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("matrices", Napi::Number::New(env, (double)stats.matrices));
+	result.Set("refs", Napi::Number::New(env, (double)stats.refs));
+	result.Set("bytes", Napi::Number::New(env, (double)stats.bytes));
+	return result;
+}
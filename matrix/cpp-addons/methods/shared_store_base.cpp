@@ -0,0 +1,76 @@
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+// Общее на процесс хранилище готовых матриц для worker_threads.
+// Матрица регистрируется один раз и получает id; другой поток по id получает Matrix над тем же буфером,
+// без копирования и без передачи ArrayBuffer. MatrixData после создания неизменяема (хеш - через call_once),
+// поэтому один операнд можно умножать из всех потоков одновременно.
+// Записи считают ссылки: повторный share той же матрицы возвращает тот же id, запись удаляется на последнем release.
+// Уже выданные Matrix держат данные сами через shared_ptr и переживают удаление записи
+class SharedMatrixStore {
+public:
+	struct Stats {
+		size_t matrices;
+		size_t refs;
+		size_t bytes;
+	};
+
+	uint64_t Share(MatrixDataPtr data) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = ids_.find(data.get());
+		if (it != ids_.end()) {
+			++entries_[it->second].refs;
+			return it->second;
+		}
+		const uint64_t id = nextId_++;
+		ids_.emplace(data.get(), id);
+		entries_.emplace(id, Entry{ std::move(data), 1 });
+		return id;
+	}
+
+	MatrixDataPtr Get(uint64_t id) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = entries_.find(id);
+		return it != entries_.end() ? it->second.data : nullptr;
+	}
+
+	bool Release(uint64_t id) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = entries_.find(id);
+		if (it == entries_.end()) {
+			return false;
+		}
+		if (--it->second.refs == 0) {
+			ids_.erase(it->second.data.get());
+			entries_.erase(it);
+		}
+		return true;
+	}
+
+	Stats GetStats() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		Stats stats{ entries_.size(), 0, 0 };
+		for (const auto& entry : entries_) {
+			stats.refs += entry.second.refs;
+			stats.bytes += entry.second.data->Size() * sizeof(double);
+		}
+		return stats;
+	}
+
+private:
+	struct Entry {
+		MatrixDataPtr data;
+		size_t refs;
+	};
+
+	std::mutex mutex_;
+	std::unordered_map<uint64_t, Entry> entries_;
+	std::unordered_map<const MatrixData*, uint64_t> ids_;
+	uint64_t nextId_ = 1;
+};
+
+static SharedMatrixStore& GetSharedMatrixStore() {
+	static SharedMatrixStore* store = new SharedMatrixStore();
+	return *store;
+}
@@ -1,6 +1,7 @@
 #include <napi.h>
 #include <vector>
 
+// multiplySimd(A, B[, { blockCols }]) - настройка только для этого вызова, по умолчанию setKernelTuning
 Napi::Value MultiplySimd(const Napi::CallbackInfo& info) {
 	Napi::Env env = info.Env();
 
@@ -18,6 +19,12 @@ Napi::Value MultiplySimd(const Napi::CallbackInfo& info) {
 		return env.Null();
 	}
 
+	KernelTuning tuning;
+	if (!ReadKernelTuning(info[2], tuning)) {
+		Napi::TypeError::New(env, "Ожидается объект { blockCols, poolGrain } с целыми неотрицательными числами").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
 	// A -> row-major, B -> row-major -> B Transpose
 	std::vector<double> A_rm, B_rm, BT_rm, C_rm;
 	A_rm.reserve(m * k);
@@ -34,7 +41,7 @@ Napi::Value MultiplySimd(const Napi::CallbackInfo& info) {
 	FlattenRowMajor(Bjs, k, n, B_rm);
 	TransposeRowMajor(B_rm, k, n, BT_rm); // n x k
 
-	SimdMatmulRowRow(A_rm, BT_rm, m, k, n, C_rm);
+	SimdMatmulRowRow(A_rm, BT_rm, m, k, n, C_rm, tuning);
 
 	return RowMajorToJs(env, C_rm, m, n);
 }
\ No newline at end of file
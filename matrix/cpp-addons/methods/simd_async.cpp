@@ -1,5 +1,54 @@
 #include <napi.h>
 #include <vector>
+#include <unordered_map>
+#include <cstring>
+
+class SimdMultiplyWorker;
+
+// Ключ одинаковой задачи: содержимое A и B и размеры
+struct SimdFlightKey {
+	ContentHash a;
+	ContentHash b;
+	size_t m = 0;
+	size_t k = 0;
+	size_t n = 0;
+
+	bool operator==(const SimdFlightKey& other) const {
+		return a == other.a && b == other.b && m == other.m && k == other.k && n == other.n;
+	}
+};
+
+struct SimdFlightKeyHash {
+	size_t operator()(const SimdFlightKey& key) const {
+		uint64_t h = key.a.lo ^ HashRotl(key.b.lo, 17) ^ HashRotl(key.a.hi, 29) ^ HashRotl(key.b.hi, 43);
+		h = HashRound(h, (uint64_t)key.m ^ ((uint64_t)key.n << 32));
+		return (size_t)HashRound(h, (uint64_t)key.k);
+	}
+};
+
+// Задачи в очереди или в работе на этом env. Трогается только с main thread:
+// постановка в MultiplySimdAsync, снятие в OnOK/OnError
+struct SimdFlightTable {
+	std::unordered_map<SimdFlightKey, SimdMultiplyWorker*, SimdFlightKeyHash> inFlight;
+	uint64_t scheduled = 0;   // поставлено воркеров
+	uint64_t coalesced = 0;   // вызовов, присоединенных к уже идущей задаче
+	uint64_t collisions = 0;  // ключ совпал, а данные нет - посчитано отдельно
+};
+
+// Определена в matrix_object.cpp, рядом с MatrixAddonData
+SimdFlightTable& GetSimdFlights(Napi::Env env);
+
+// Callback одного из ожидающих. С NAPI_DISABLE_CPP_EXCEPTIONS брошенное в нем исключение остается pending,
+// и все следующие Call не выполнятся: снимаем его, запоминаем первое и идем дальше
+static void CallWaiter(Napi::Env env, Napi::FunctionReference& callback, const std::vector<napi_value>& args, Napi::Error& firstError) {
+	callback.Call(args);
+	if (env.IsExceptionPending()) {
+		Napi::Error error = env.GetAndClearPendingException();
+		if (firstError.IsEmpty()) {
+			firstError = std::move(error);
+		}
+	}
+}
 
 class SimdMultiplyWorker : public Napi::AsyncWorker {
 public:
@@ -7,44 +56,117 @@ public:
 		Napi::Function& cb,
 		std::vector<double>&& A_rowMajor,
 		std::vector<double>&& BT_rowMajor,
-		size_t m, size_t k, size_t n)
+		size_t m, size_t k, size_t n,
+		const SimdFlightKey& key,
+		const KernelTuning& tuning)
 	: Napi::AsyncWorker(cb),
 	A_(std::move(A_rowMajor)),
 	BT_(std::move(BT_rowMajor)),
 	C_(m * n),
-	m_(m), k_(k), n_(n) {}
+	m_(m), k_(k), n_(n),
+	key_(key),
+	tuning_(tuning) {}
+
+	// Вызов с тем же ключом, пока задача не завершилась: получит тот же результат.
+	// Настройка ядра на результат не влияет, поэтому в ключ не входит
+	void AddWaiter(const Napi::Function& cb) {
+		waiters_.push_back(Napi::Persistent(cb));
+	}
+
+	// Хеш в ключе можно подобрать, поэтому перед склейкой сверяем сами данные (побитово, как хеш):
+	// A - memcmp, B - с транспонированной BT. Размеры уже совпали в ключе. Execute эти буферы только читает
+	bool SameOperands(const std::vector<double>& A_rowMajor, const std::vector<double>& B_rowMajor) const {
+		if (std::memcmp(A_.data(), A_rowMajor.data(), A_.size() * sizeof(double)) != 0) {
+			return false;
+		}
+		for (size_t p = 0; p < k_; ++p) {
+			for (size_t j = 0; j < n_; ++j) {
+				if (std::memcmp(&BT_[j * k_ + p], &B_rowMajor[p * n_ + j], sizeof(double)) != 0) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	ThreadSlot& Slot() { return slot_; }
 
 	void Execute() override {
-		SimdMatmulRowRow(A_, BT_, m_, k_, n_, C_);
+		ThreadSlot::Hold hold(slot_);
+		SimdMatmulRowRow(A_, BT_, m_, k_, n_, C_, tuning_);
 	}
 
 	void OnOK() override {
 		Napi::Env env = Env();
 		Napi::HandleScope scope(env);
-		Callback().Call({ env.Null(), RowMajorToJs(env, C_, m_, n_) });
+		// Снимаем до callback-ов: новый вызов из callback-а должен запустить новую задачу
+		Unregister(env);
+
+		// Каждому ожидающему - свой массив: вызывающие могут менять результат независимо
+		Napi::Error firstError;
+		CallWaiter(env, Callback(), { env.Null(), RowMajorToJs(env, C_, m_, n_) }, firstError);
+		for (Napi::FunctionReference& waiter : waiters_) {
+			CallWaiter(env, waiter, { env.Null(), RowMajorToJs(env, C_, m_, n_) }, firstError);
+		}
+		// Исключение из callback-а уходит в uncaughtException, как без склейки, но уже после всех callback-ов
+		if (!firstError.IsEmpty()) {
+			firstError.ThrowAsJavaScriptException();
+		}
 	}
 
 	void OnError(const Napi::Error& e) override {
 		Napi::Env env = Env();
-		Callback().Call({ e.Value(), env.Undefined() });
+		Napi::HandleScope scope(env);
+		Unregister(env);
+
+		Napi::Error firstError;
+		CallWaiter(env, Callback(), { e.Value(), env.Undefined() }, firstError);
+		for (Napi::FunctionReference& waiter : waiters_) {
+			CallWaiter(env, waiter, { e.Value(), env.Undefined() }, firstError);
+		}
+		if (!firstError.IsEmpty()) {
+			firstError.ThrowAsJavaScriptException();
+		}
 	}
 
 private:
+	// При коллизии ключа в таблице числится другой воркер - его не трогаем
+	void Unregister(Napi::Env env) {
+		SimdFlightTable& flights = GetSimdFlights(env);
+		auto it = flights.inFlight.find(key_);
+		if (it != flights.inFlight.end() && it->second == this) {
+			flights.inFlight.erase(it);
+		}
+	}
+
 	std::vector<double> A_, BT_, C_;
 	size_t m_, k_, n_;
+	SimdFlightKey key_;
+	KernelTuning tuning_;
+	std::vector<Napi::FunctionReference> waiters_;
+	ThreadSlot slot_;
 };
 
+// multiplySimdAsync(A, B[, { blockCols }], cb)
 Napi::Value MultiplySimdAsync(const Napi::CallbackInfo& info) {
 	Napi::Env env = info.Env();
 
-	if (info.Length() < 3 || !info[0].IsArray() || !info[1].IsArray() || !info[2].IsFunction()) {
+	// callback последний: (A, B, cb) или (A, B, { blockCols, poolGrain }, cb)
+	const size_t cbIndex = info.Length() >= 4 ? 3 : 2;
+	if (info.Length() < 3 || !info[0].IsArray() || !info[1].IsArray() || !info[cbIndex].IsFunction()) {
 		Napi::TypeError::New(env, "Ожидается 2 матрицы: matrixA, matrixB и callback").ThrowAsJavaScriptException();
 		return env.Null();
 	}
 
+	KernelTuning tuning;
+	if (!ReadKernelTuning(cbIndex == 3 ? info[2] : env.Undefined(), tuning)) {
+		Napi::TypeError::New(env, "Ожидается объект { blockCols, poolGrain } с целыми неотрицательными числами").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
 	Napi::Array Ajs = info[0].As<Napi::Array>();
 	Napi::Array Bjs = info[1].As<Napi::Array>();
-	Napi::Function cb = info[2].As<Napi::Function>();
+	Napi::Function cb = info[cbIndex].As<Napi::Function>();
 
 	size_t m, k, k2, n;
 	if (!ReadShape(Ajs, m, k) || !ReadShape(Bjs, k2, n) || k == 0 || n == 0 || k2 != k) {
@@ -58,15 +180,51 @@ Napi::Value MultiplySimdAsync(const Napi::CallbackInfo& info) {
 
 	// Оптимизации
 	// 1. Сплющиваем A и B в row-major
-	// 2. Транспонируем B в BT
-	// 3. Передаем воркеру плоские буферы по move
+	// 2. Одинаковая задача уже в очереди или считается - присоединяемся к ней (single-flight)
+	// 3. Транспонируем B в BT
+	// 4. Передаем воркеру плоские буферы по move
 
 	FlattenRowMajor(Ajs, m, k, A_rm);
 	FlattenRowMajor(Bjs, k, n, B_rm);
+
+	// Хеш - один проход по уже плоским данным, на фоне конвертации из JS почти бесплатен
+	SimdFlightKey key;
+	key.a = HashDoubles(A_rm.data(), A_rm.size());
+	key.b = HashDoubles(B_rm.data(), B_rm.size());
+	key.m = m;
+	key.k = k;
+	key.n = n;
+
+	SimdFlightTable& flights = GetSimdFlights(env);
+	auto it = flights.inFlight.find(key);
+	if (it != flights.inFlight.end()) {
+		if (it->second->SameOperands(A_rm, B_rm)) {
+			it->second->AddWaiter(cb);
+			++flights.coalesced;
+			return env.Undefined();
+		}
+		// Коллизия хеша: считаем отдельно, в таблице остается первая задача
+		++flights.collisions;
+	}
+
 	TransposeRowMajor(B_rm, k, n, BT_rm);
 
-	auto* worker = new SimdMultiplyWorker(cb, std::move(A_rm), std::move(BT_rm), m, k, n);
-	worker->Queue();
+	auto* worker = new SimdMultiplyWorker(cb, std::move(A_rm), std::move(BT_rm), m, k, n, key, tuning);
+	flights.inFlight.emplace(key, worker);
+	++flights.scheduled;
+	QueueWithBudget(env, worker, 1);
 
 	return env.Undefined();
-}
\ No newline at end of file
+}
+
+Napi::Value GetSimdAsyncStats(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+	const SimdFlightTable& flights = GetSimdFlights(env);
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("scheduled", Napi::Number::New(env, (double)flights.scheduled));
+	result.Set("coalesced", Napi::Number::New(env, (double)flights.coalesced));
+	result.Set("collisions", Napi::Number::New(env, (double)flights.collisions));
+	result.Set("inFlight", Napi::Number::New(env, (double)flights.inFlight.size()));
+	return result;
+}
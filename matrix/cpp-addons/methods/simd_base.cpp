@@ -1,5 +1,8 @@
 #include <vector>
 #include <cstddef>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
 
 // SIMD детект
 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
@@ -14,81 +17,169 @@
 	#define USE_NEON
 #endif
 
-// Ядро умножения: A(m x k) row-major, BT(n x k) row-major -> C(m x n) row-major
-void SimdMatmulRowRow(
-	const std::vector<double>& A, const std::vector<double>& BT,
-    size_t m, size_t k, size_t n,
-	std::vector<double>& C)
-{
+// Скалярное произведение двух строк длины k
+static inline double SimdDot(const double* aRow, const double* btRow, size_t k) {
 #ifdef USE_AVX
 	const size_t w = 4;
-	for (size_t i = 0; i < m; ++i) {
-		const double* aRow = &A[i * k];
-		for (size_t j = 0; j < n; ++j) {
-			const double* btRow = &BT[j * k];
-			__m256d acc = _mm256_setzero_pd();
-
-			size_t t = 0;
-			for (; t + w <= k; t += w) {
-			// Оптимизация: Загружаем по 4 double сразу из aRow и btRow
-			__m256d va = _mm256_loadu_pd(aRow + t);
-			__m256d vb = _mm256_loadu_pd(btRow + t);
-			#ifdef USE_AVX_FMA
-				// Оптимизация: acc = acc + va * vb одной инструкцией FMA
-				acc = _mm256_fmadd_pd(va, vb, acc);
-			#else
-				acc = _mm256_add_pd(acc, _mm256_mul_pd(va, vb));
-			#endif
-			}
+	__m256d acc = _mm256_setzero_pd();
 
-			alignas(32) double tmp[4];
-			_mm256_store_pd(tmp, acc);
-			double sum = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+	size_t t = 0;
+	for (; t + w <= k; t += w) {
+		// Оптимизация: Загружаем по 4 double сразу из aRow и btRow
+		__m256d va = _mm256_loadu_pd(aRow + t);
+		__m256d vb = _mm256_loadu_pd(btRow + t);
+	#ifdef USE_AVX_FMA
+		// Оптимизация: acc = acc + va * vb одной инструкцией FMA
+		acc = _mm256_fmadd_pd(va, vb, acc);
+	#else
+		acc = _mm256_add_pd(acc, _mm256_mul_pd(va, vb));
+	#endif
+	}
 
-			// Хвост
-			for (; t < k; ++t) {
-			sum += aRow[t] * btRow[t];
-			}
-			C[i * n + j] = sum;
-		}
+	alignas(32) double tmp[4];
+	_mm256_store_pd(tmp, acc);
+	double sum = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+
+	// Хвост
+	for (; t < k; ++t) {
+		sum += aRow[t] * btRow[t];
 	}
+	return sum;
 
 #elif defined(USE_NEON)
 	const size_t w = 2;
-	for (size_t i = 0; i < m; ++i) {
-		const double* aRow = &A[i * k];
-		for (size_t j = 0; j < n; ++j) {
-			const double* btRow = &BT[j * k];
-			float64x2_t acc = vdupq_n_f64(0.0);
-			
-			size_t t = 0;
-			for (; t + w <= k; t += w) {
-				// Оптимизация: Загружаем по 2 double сразу из aRow и btRow
-				float64x2_t va = vld1q_f64(aRow + t);
-				float64x2_t vb = vld1q_f64(btRow + t);
-				acc = vaddq_f64(acc, vmulq_f64(va, vb));
-			}
-			double sum = vgetq_lane_f64(acc, 0) + vgetq_lane_f64(acc, 1);
+	float64x2_t acc = vdupq_n_f64(0.0);
 
-			for (; t < k; ++t) {
-				sum += aRow[t] * btRow[t];
-			}
-			C[i * n + j] = sum;
-		}
+	size_t t = 0;
+	for (; t + w <= k; t += w) {
+		// Оптимизация: Загружаем по 2 double сразу из aRow и btRow
+		float64x2_t va = vld1q_f64(aRow + t);
+		float64x2_t vb = vld1q_f64(btRow + t);
+		acc = vaddq_f64(acc, vmulq_f64(va, vb));
 	}
+	double sum = vgetq_lane_f64(acc, 0) + vgetq_lane_f64(acc, 1);
+
+	for (; t < k; ++t) {
+		sum += aRow[t] * btRow[t];
+	}
+	return sum;
 
 #else
 	// Фоллбек без SIMD
-	for (size_t i = 0; i < m; ++i) {
-		const double* aRow = &A[i * k];
-		for (size_t j = 0; j < n; ++j) {
-			const double* btRow = &BT[j * k];
-			double sum = 0.0;
-			for (size_t t = 0; t < k; ++t) {
-				sum += aRow[t] * btRow[t];
+	double sum = 0.0;
+	for (size_t t = 0; t < k; ++t) {
+		sum += aRow[t] * btRow[t];
+	}
+	return sum;
+#endif
+}
+
+// Параметры ядер, которые подбирает autotune() под кеши машины. Влияют только на скорость
+struct KernelTuning {
+	size_t blockCols = 0;   // ширина блока столбцов C (строк BT), 0 - без блокировки
+	size_t poolGrain = 0;   // строк A на задачу пула, 0 - автоматически (примерно 4 задачи на поток)
+};
+
+// Значения по умолчанию на процесс (setKernelTuning). Вызов может передать свои - тогда
+// воркер запоминает их при постановке, и параллельные вызовы с разной настройкой не мешают друг другу
+static std::atomic<size_t> gSimdBlockCols{ 0 };
+static std::atomic<size_t> gPoolGrain{ 0 };
+
+static KernelTuning CurrentKernelTuning() {
+	KernelTuning tuning;
+	tuning.blockCols = gSimdBlockCols.load(std::memory_order_relaxed);
+	tuning.poolGrain = gPoolGrain.load(std::memory_order_relaxed);
+	return tuning;
+}
+
+// Необязательный объект { blockCols, poolGrain } вызова поверх настроек процесса.
+// false - не объект или поле не целое неотрицательное число
+static bool ReadKernelTuning(const Napi::Value& value, KernelTuning& tuning) {
+	tuning = CurrentKernelTuning();
+	if (value.IsUndefined()) {
+		return true;
+	}
+	if (!value.IsObject()) {
+		return false;
+	}
+	Napi::Object opts = value.As<Napi::Object>();
+	size_t* fields[] = { &tuning.blockCols, &tuning.poolGrain };
+	const char* names[] = { "blockCols", "poolGrain" };
+	for (size_t i = 0; i < 2; ++i) {
+		Napi::Value field = opts.Get(names[i]);
+		if (field.IsUndefined()) {
+			continue;
+		}
+		if (!field.IsNumber()) {
+			return false;
+		}
+		const double number = field.As<Napi::Number>().DoubleValue();
+		if (!(number >= 0 && number <= 4294967295.0) || number != std::floor(number)) {
+			return false;
+		}
+		*fields[i] = (size_t)number;
+	}
+	return true;
+}
+
+// Ядро умножения для строк [rowBegin, rowEnd): A(m x k) row-major, BT(n x k) row-major -> C(m x n) row-major
+// Позволяет считать C по частям (эпилоги, разбиение по потокам)
+void SimdMatmulRowRange(
+	const double* A, const double* BT,
+	size_t k, size_t n,
+	size_t rowBegin, size_t rowEnd,
+	double* C,
+	size_t blockCols)
+{
+	// Оптимизация: блок из blockCols строк BT остается в кеше, пока по нему проходят все строки A
+	const size_t step = blockCols == 0 ? n : std::min(blockCols, n);
+
+	for (size_t j0 = 0; j0 < n; j0 += step) {
+		const size_t jEnd = std::min(n, j0 + step);
+		for (size_t i = rowBegin; i < rowEnd; ++i) {
+			const double* aRow = &A[i * k];
+			for (size_t j = j0; j < jEnd; ++j) {
+				C[i * n + j] = SimdDot(aRow, &BT[j * k], k);
 			}
-			C[i * n + j] = sum;
 		}
 	}
-#endif
+}
+
+// То же с настройкой процесса
+void SimdMatmulRowRange(
+	const double* A, const double* BT,
+	size_t k, size_t n,
+	size_t rowBegin, size_t rowEnd,
+	double* C)
+{
+	SimdMatmulRowRange(A, BT, k, n, rowBegin, rowEnd, C, gSimdBlockCols.load(std::memory_order_relaxed));
+}
+
+// Обновление подматрицы: C(rows x n) += alpha * A(rows x k) * BT(n x k)^T
+// Все матрицы - окна внутри бОльших row-major матриц с ведущими размерностями lda/ldb/ldc
+// (нужно для trailing update в блочных LU/Cholesky)
+void SimdGemmAccumulate(
+	const double* A, size_t lda,
+	const double* BT, size_t ldb,
+	size_t rows, size_t k, size_t n,
+	double alpha,
+	double* C, size_t ldc)
+{
+	for (size_t i = 0; i < rows; ++i) {
+		const double* aRow = A + i * lda;
+		double* cRow = C + i * ldc;
+		for (size_t j = 0; j < n; ++j) {
+			cRow[j] += alpha * SimdDot(aRow, BT + j * ldb, k);
+		}
+	}
+}
+
+// Ядро умножения: A(m x k) row-major, BT(n x k) row-major -> C(m x n) row-major
+void SimdMatmulRowRow(
+	const std::vector<double>& A, const std::vector<double>& BT,
+	size_t m, size_t k, size_t n,
+	std::vector<double>& C,
+	const KernelTuning& tuning)
+{
+	SimdMatmulRowRange(A.data(), BT.data(), k, n, 0, m, C.data(), tuning.blockCols);
 }
\ No newline at end of file
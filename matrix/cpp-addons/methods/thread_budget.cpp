@@ -0,0 +1,100 @@
+#include <napi.h>
+#include <string>
+#include <algorithm>
+#include <cmath>
+
+// setThreadBudget/getThreadConfig: одна настройка вместо UV_THREADPOOL_SIZE, VECLIB_MAXIMUM_THREADS
+// и configureComputePool по отдельности. Бэкенды делят один бюджет потоков (см. thread_budget_base.cpp):
+// пул берет до threads потоков, каждый вызов BLAS - blasThreads, одновременно считается не больше asyncJobs задач
+
+static bool ReadBudgetOption(Napi::Env env, const Napi::Object& opts, const char* name, size_t& value) {
+	Napi::Value v = opts.Get(name);
+	if (v.IsUndefined()) {
+		return true;
+	}
+	// NaN, Infinity, дробные и слишком большие не проходят: Uint32Value превратил бы их в 0,
+	// а 0 потоков - деление на ноль при раскладке бюджета
+	const double number = v.IsNumber() ? v.As<Napi::Number>().DoubleValue() : 0;
+	if (!(number >= 1 && number <= 2147483647.0) || number != std::floor(number)) {
+		Napi::TypeError::New(env, std::string(name) + ": ожидается целое число от 1 до 2147483647").ThrowAsJavaScriptException();
+		return false;
+	}
+	value = (size_t)number;
+	return true;
+}
+
+// getThreadConfig() -> { cores, budget, pool, blas, asyncJobs, uvThreadpoolSize }
+Napi::Value GetThreadConfig(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+	const ThreadGate::Stats gate = GetThreadGate().GetStats();
+	const BlasControl& blasControl = GetBlasControl();
+	const size_t poolThreads = GetComputePool()->ThreadCount();
+	const size_t blasThreads = BlasThreads();
+
+	Napi::Object pool = Napi::Object::New(env);
+	pool.Set("threads", Napi::Number::New(env, (double)poolThreads));
+
+	Napi::Object blas = Napi::Object::New(env);
+	blas.Set("library", Napi::String::New(env, blasControl.library));
+	blas.Set("threads", Napi::Number::New(env, (double)blasThreads));
+	// false - число потоков задается только переменной окружения библиотеки (vecLib) и действует до инициализации BLAS
+	blas.Set("runtime", Napi::Boolean::New(env, blasControl.setThreads != nullptr));
+
+	Napi::Object jobs = Napi::Object::New(env);
+	jobs.Set("limit", Napi::Number::New(env, (double)gate.jobLimit));
+	jobs.Set("active", Napi::Number::New(env, (double)gate.activeJobs));
+	jobs.Set("waiting", Napi::Number::New(env, (double)gate.waiting));
+	jobs.Set("admitted", Napi::Number::New(env, (double)gate.admitted));
+	jobs.Set("delayed", Napi::Number::New(env, (double)gate.delayed));
+	// Потоков вычислений сейчас занято async-задачами, всегда <= budget
+	jobs.Set("activeThreads", Napi::Number::New(env, (double)gate.activeUnits));
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("cores", Napi::Number::New(env, (double)HardwareThreads()));
+	result.Set("budget", Napi::Number::New(env, (double)gate.capacity));
+	result.Set("pool", pool);
+	result.Set("blas", blas);
+	result.Set("asyncJobs", jobs);
+	result.Set("uvThreadpoolSize", Napi::Number::New(env, (double)UvThreadpoolSize()));
+	return result;
+}
+
+// setThreadBudget({ threads, poolThreads, blasThreads, asyncJobs }) -> getThreadConfig().
+// threads - общий бюджет (по умолчанию число ядер), остальное по умолчанию делится так,
+// чтобы asyncJobs * blasThreads <= threads: много независимых задач - BLAS однопоточный, одна задача - BLAS на все ядра
+Napi::Value SetThreadBudget(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	size_t threads = HardwareThreads();
+	size_t poolThreads = 0, blasThreads = 0, asyncJobs = 0;
+	if (info.Length() > 0 && !info[0].IsUndefined()) {
+		if (!info[0].IsObject()) {
+			Napi::TypeError::New(env, "Ожидается объект { threads, poolThreads, blasThreads, asyncJobs }").ThrowAsJavaScriptException();
+			return env.Null();
+		}
+		Napi::Object opts = info[0].As<Napi::Object>();
+		if (!ReadBudgetOption(env, opts, "threads", threads)
+			|| !ReadBudgetOption(env, opts, "poolThreads", poolThreads)
+			|| !ReadBudgetOption(env, opts, "blasThreads", blasThreads)
+			|| !ReadBudgetOption(env, opts, "asyncJobs", asyncJobs)) {
+			return env.Null();
+		}
+	}
+
+	// Больше бюджета не бывает: лишнее просто ждало бы в очереди
+	asyncJobs = std::min(threads, asyncJobs ? asyncJobs : threads);
+	poolThreads = std::min(threads, poolThreads ? poolThreads : threads);
+	blasThreads = std::min(threads, blasThreads ? blasThreads : std::max<size_t>(1, threads / asyncJobs));
+
+	std::shared_ptr<ComputePool> pool = GetComputePool();
+	if (pool->ThreadCount() != poolThreads) {
+		PoolConfig config = pool->Config();
+		config.threads = poolThreads;
+		pool.reset();
+		ConfigureComputePool(config);
+	}
+	SetBlasThreads(blasThreads);
+	GetThreadGate().Configure(threads, asyncJobs);
+
+	return GetThreadConfig(info);
+}
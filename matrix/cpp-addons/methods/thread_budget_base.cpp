@@ -0,0 +1,426 @@
+#include <napi.h>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <deque>
+#include <functional>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__linux__) || defined(__APPLE__)
+	#include <dlfcn.h>
+#endif
+
+static size_t HardwareThreads() {
+	const unsigned n = std::thread::hardware_concurrency();
+	return n > 0 ? n : 1;
+}
+
+class BudgetDispatcher;
+
+// Определена в matrix_object.cpp, рядом с MatrixAddonData. nullptr - очередь допуска не создалась
+BudgetDispatcher* GetBudgetDispatcher(Napi::Env env);
+
+// Единицы бюджета одной async-задачи (воркер держит его полем). Берутся на main thread до Queue():
+// если единиц не хватает, задача ждет в очереди гейта, а не на потоке libuv, и уходит в libuv,
+// когда Release освободит место. Отдаются в конце Execute (ThreadSlot::Hold) или при разрушении воркера
+class ThreadSlot {
+public:
+	ThreadSlot() = default;
+	~ThreadSlot();
+
+	// main thread. start - Queue() воркера: сразу, если единицы есть, иначе позже на main thread этого env
+	void Admit(Napi::Env env, size_t units, std::function<void()> start);
+
+	// Отмена на main thread: задача, которая еще ждет бюджета, уходит в libuv без единиц
+	// (Execute увидит флаг отмены и выйдет, а napi_cancel_async_work снимет ее раньше). false - уже допущена
+	bool CancelWait();
+
+	// Отдать единицы гейту; с любого потока, повторный вызов ничего не делает
+	void Release();
+
+	bool Acquired() const { return units_.load(std::memory_order_acquire) > 0; }
+
+	// На время Execute: единицы отдаются при выходе из него, в том числе по раннему return
+	class Hold {
+	public:
+		explicit Hold(ThreadSlot& slot) : slot_(slot) {}
+		~Hold() { slot_.Release(); }
+
+		Hold(const Hold&) = delete;
+		Hold& operator=(const Hold&) = delete;
+
+	private:
+		ThreadSlot& slot_;
+	};
+
+	ThreadSlot(const ThreadSlot&) = delete;
+	ThreadSlot& operator=(const ThreadSlot&) = delete;
+
+private:
+	friend class ThreadGate;
+	friend class BudgetDispatcher;
+
+	// Допущена из очереди (Release на любом потоке) - старт на main thread
+	void Start();
+
+	size_t wanted_ = 0;
+	std::atomic<size_t> units_{ 0 };
+	bool waiting_ = false;   // в очереди гейта; под mutex гейта
+	napi_env env_ = nullptr;
+	BudgetDispatcher* dispatcher_ = nullptr;
+	std::function<void()> start_;
+};
+
+// Переход на main thread env: задачу, допущенную из Release на чужом потоке, ставит в libuv поток
+// ее env (napi_queue_async_work можно звать только с него). Один на env, удаляется при закрытии tsfn
+class BudgetDispatcher {
+public:
+	static BudgetDispatcher* Create(Napi::Env env) {
+		auto* dispatcher = new BudgetDispatcher();
+		napi_value name;
+		napi_create_string_utf8(env, "matrixThreadBudget", NAPI_AUTO_LENGTH, &name);
+		if (napi_create_threadsafe_function(env, nullptr, nullptr, name, 0, 1, dispatcher, Finalize, dispatcher, CallJs, &dispatcher->tsfn_) != napi_ok) {
+			delete dispatcher;
+			return nullptr;
+		}
+		// Пустая очередь не держит event loop
+		napi_unref_threadsafe_function(env, dispatcher->tsfn_);
+		return dispatcher;
+	}
+
+	// Под mutex гейта: после Finalize в очереди гейта нет задач этого env, и сюда никто не придет.
+	// false - env уже закрывается
+	bool Post(ThreadSlot* slot) {
+		return napi_call_threadsafe_function(tsfn_, slot, napi_tsfn_nonblocking) == napi_ok;
+	}
+
+	// main thread: пока задачи env ждут бюджета, его event loop не завершается
+	void AddWaiting(napi_env env) {
+		if (waiting_++ == 0) {
+			napi_ref_threadsafe_function(env, tsfn_);
+		}
+	}
+
+	void RemoveWaiting(napi_env env) {
+		if (--waiting_ == 0) {
+			napi_unref_threadsafe_function(env, tsfn_);
+		}
+	}
+
+private:
+	static void CallJs(napi_env env, napi_value, void* context, void* data);
+	static void Finalize(napi_env env, void* data, void* hint);
+
+	napi_threadsafe_function tsfn_ = nullptr;
+	size_t waiting_ = 0;
+};
+
+// Бюджет потоков на весь процесс (общий для всех worker_threads).
+// Async-задача перед постановкой в очередь libuv берет столько единиц, сколько потоков займет:
+// SIMD - 1, BLAS - blasThreads, задачи на пуле - размер пула. Пока единиц не хватает, задача ждет
+// в очереди гейта (FIFO) и не занимает ни CPU, ни поток libuv - fs, dns и zlib не стоят за ней в очереди.
+// Активных потоков вычислений не больше бюджета, сколько бы задач ни было поставлено
+class ThreadGate {
+public:
+	struct Stats {
+		size_t capacity;
+		size_t jobLimit;
+		size_t activeUnits;
+		size_t activeJobs;
+		size_t waiting;
+		uint64_t admitted;
+		uint64_t delayed;   // сколько задач ждали свободных единиц
+	};
+
+	void Configure(size_t capacity, size_t jobLimit) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		capacity_ = std::max<size_t>(1, capacity);
+		jobLimit_ = std::max<size_t>(1, jobLimit);
+		// Бюджет мог вырасти - пускаем ждущих
+		DrainLocked();
+	}
+
+	// main thread. true - единицы взяты (slot->units_). false - slot встал в очередь: ждущих не обгоняем,
+	// иначе поток мелких задач не пустил бы крупную никогда
+	bool Admit(ThreadSlot* slot, size_t units) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		slot->wanted_ = units;
+		if (queue_.empty() && CanAdmit(units)) {
+			Take(slot);
+			return true;
+		}
+		++delayed_;
+		slot->waiting_ = true;
+		queue_.push_back(slot);
+		return false;
+	}
+
+	// false - задачу уже допустили
+	bool Withdraw(ThreadSlot* slot) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!slot->waiting_) {
+			return false;
+		}
+		slot->waiting_ = false;
+		queue_.erase(std::find(queue_.begin(), queue_.end(), slot));
+		return true;
+	}
+
+	// env выгружается: его задачи уже не запустятся
+	void WithdrawAll(const BudgetDispatcher* dispatcher) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		queue_.erase(std::remove_if(queue_.begin(), queue_.end(), [dispatcher](ThreadSlot* slot) {
+			if (slot->dispatcher_ != dispatcher) {
+				return false;
+			}
+			slot->waiting_ = false;
+			return true;
+		}), queue_.end());
+	}
+
+	void Release(size_t units) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		activeUnits_ -= units;
+		--activeJobs_;
+		DrainLocked();
+	}
+
+	Stats GetStats() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return { capacity_, jobLimit_, activeUnits_, activeJobs_, queue_.size(), admitted_, delayed_ };
+	}
+
+private:
+	size_t Clamp(size_t units) const {
+		return std::max<size_t>(1, std::min(units, capacity_));
+	}
+
+	bool CanAdmit(size_t units) const {
+		return activeJobs_ < jobLimit_ && activeUnits_ + Clamp(units) <= capacity_;
+	}
+
+	// Задача дороже всего бюджета берет весь бюджет
+	void Take(ThreadSlot* slot) {
+		const size_t taken = Clamp(slot->wanted_);
+		activeUnits_ += taken;
+		++activeJobs_;
+		++admitted_;
+		slot->units_.store(taken, std::memory_order_release);
+	}
+
+	// Голова очереди, пока помещается; старт - на main thread env задачи
+	void DrainLocked() {
+		while (!queue_.empty() && CanAdmit(queue_.front()->wanted_)) {
+			ThreadSlot* slot = queue_.front();
+			queue_.pop_front();
+			slot->waiting_ = false;
+			Take(slot);
+			if (!slot->dispatcher_->Post(slot)) {
+				// env закрывается - задача не запустится, единицы сразу обратно
+				activeUnits_ -= slot->units_.exchange(0);
+				--activeJobs_;
+			}
+		}
+	}
+
+	std::mutex mutex_;
+	size_t capacity_ = HardwareThreads();
+	size_t jobLimit_ = HardwareThreads();
+	size_t activeUnits_ = 0;
+	size_t activeJobs_ = 0;
+	std::deque<ThreadSlot*> queue_;
+	uint64_t admitted_ = 0;
+	uint64_t delayed_ = 0;
+};
+
+static ThreadGate& GetThreadGate() {
+	static ThreadGate* gate = new ThreadGate();
+	return *gate;
+}
+
+inline ThreadSlot::~ThreadSlot() {
+	// Воркер удаляется на main thread; ждущим он быть не должен, но очередь гейта не может держать висячий указатель
+	if (dispatcher_ != nullptr && GetThreadGate().Withdraw(this)) {
+		dispatcher_->RemoveWaiting(env_);
+	}
+	Release();
+}
+
+inline void ThreadSlot::Admit(Napi::Env env, size_t units, std::function<void()> start) {
+	env_ = env;
+	start_ = std::move(start);
+	dispatcher_ = GetBudgetDispatcher(env);
+	// Без очереди допуска задача идет в libuv без бюджета, как до setThreadBudget
+	if (dispatcher_ == nullptr || GetThreadGate().Admit(this, units)) {
+		start_();
+		return;
+	}
+	// Release с другого потока мог уже допустить задачу, но ее CallJs выполнится на этом потоке позже
+	dispatcher_->AddWaiting(env_);
+}
+
+inline bool ThreadSlot::CancelWait() {
+	if (dispatcher_ == nullptr || !GetThreadGate().Withdraw(this)) {
+		return false;
+	}
+	dispatcher_->RemoveWaiting(env_);
+	start_();
+	return true;
+}
+
+inline void ThreadSlot::Release() {
+	if (const size_t units = units_.exchange(0)) {
+		GetThreadGate().Release(units);
+	}
+}
+
+inline void ThreadSlot::Start() {
+	start_();
+}
+
+// Постановка воркера через бюджет вместо worker->Queue(); у Worker - Slot() и Queue()
+template <typename Worker>
+static void QueueWithBudget(Napi::Env env, Worker* worker, size_t units) {
+	worker->Slot().Admit(env, units, [worker] { worker->Queue(); });
+}
+
+inline void BudgetDispatcher::CallJs(napi_env env, napi_value, void* context, void* data) {
+	ThreadSlot* slot = static_cast<ThreadSlot*>(data);
+	if (env == nullptr) {
+		// tsfn закрыт вместе с env: задача не запустится, а единицы нужны остальным
+		slot->Release();
+		return;
+	}
+	static_cast<BudgetDispatcher*>(context)->RemoveWaiting(env);
+	slot->Start();
+}
+
+inline void BudgetDispatcher::Finalize(napi_env, void* data, void*) {
+	BudgetDispatcher* dispatcher = static_cast<BudgetDispatcher*>(data);
+	GetThreadGate().WithdrawAll(dispatcher);
+	delete dispatcher;
+}
+
+// Управление потоками BLAS. Аддон сам BLAS не линкует (кроме Accelerate на macOS),
+// поэтому ищем уже загруженную в процесс библиотеку: dlopen с RTLD_NOLOAD ничего не грузит
+struct BlasControl {
+	std::string library = "none";
+	const char* threadEnv = nullptr;   // переменная окружения с числом потоков этой библиотеки
+	void (*setThreads)(int) = nullptr;
+	int (*getThreads)() = nullptr;
+};
+
+#if defined(__linux__)
+template <typename Fn>
+static Fn FindBlasSymbol(const char* const* sonames, const char* name) {
+	if (void* symbol = dlsym(RTLD_DEFAULT, name)) {
+		return reinterpret_cast<Fn>(symbol);
+	}
+	for (const char* const* soname = sonames; *soname; ++soname) {
+		if (void* handle = dlopen(*soname, RTLD_NOW | RTLD_NOLOAD)) {
+			void* symbol = dlsym(handle, name);
+			dlclose(handle);
+			if (symbol) {
+				return reinterpret_cast<Fn>(symbol);
+			}
+		}
+	}
+	return nullptr;
+}
+
+// У BLIS число потоков - dim_t (int64)
+static void (*gBlisSetThreads)(int64_t) = nullptr;
+static int64_t (*gBlisGetThreads)() = nullptr;
+#endif
+
+static const BlasControl& GetBlasControl() {
+	static const BlasControl control = [] {
+		BlasControl c;
+#if defined(__APPLE__)
+		// У vecLib нет публичного API числа потоков - только VECLIB_MAXIMUM_THREADS до первого вызова
+		c.library = "veclib";
+		c.threadEnv = "VECLIB_MAXIMUM_THREADS";
+#elif defined(__linux__)
+		static const char* const openblas[] = { "libopenblas.so.0", "libopenblas.so", "libopenblasp.so.0", nullptr };
+		static const char* const blis[] = { "libblis.so.4", "libblis.so", "libblis-mt.so.4", nullptr };
+		static const char* const mkl[] = { "libmkl_rt.so.2", "libmkl_rt.so", nullptr };
+
+		if ((c.setThreads = FindBlasSymbol<void (*)(int)>(openblas, "openblas_set_num_threads"))) {
+			c.library = "openblas";
+			c.threadEnv = "OPENBLAS_NUM_THREADS";
+			c.getThreads = FindBlasSymbol<int (*)()>(openblas, "openblas_get_num_threads");
+		} else if ((gBlisSetThreads = FindBlasSymbol<void (*)(int64_t)>(blis, "bli_thread_set_num_threads"))) {
+			c.library = "blis";
+			c.threadEnv = "BLIS_NUM_THREADS";
+			gBlisGetThreads = FindBlasSymbol<int64_t (*)()>(blis, "bli_thread_get_num_threads");
+			c.setThreads = [](int threads) { gBlisSetThreads(threads); };
+			if (gBlisGetThreads) {
+				c.getThreads = []() { return (int)gBlisGetThreads(); };
+			}
+		} else if ((c.setThreads = FindBlasSymbol<void (*)(int)>(mkl, "MKL_Set_Num_Threads"))) {
+			c.library = "mkl";
+			c.threadEnv = "MKL_NUM_THREADS";
+			c.getThreads = FindBlasSymbol<int (*)()>(mkl, "MKL_Get_Max_Threads");
+		}
+#endif
+		return c;
+	}();
+	return control;
+}
+
+static const char* const kBlasThreadEnv[] = {
+	"VECLIB_MAXIMUM_THREADS", "OPENBLAS_NUM_THREADS", "BLIS_NUM_THREADS", "MKL_NUM_THREADS", "OMP_NUM_THREADS"
+};
+
+static size_t ReadEnvThreads(const char* name) {
+	const char* value = std::getenv(name);
+	const long threads = value ? std::strtol(value, nullptr, 10) : 0;
+	return threads > 0 ? (size_t)threads : 0;
+}
+
+// 0 - еще не задано через setThreadBudget
+static std::atomic<size_t> gBlasThreads{ 0 };
+
+// Сколько потоков займет один вызов BLAS: заданное значение, иначе библиотека, переменные окружения
+// (как в скриптах start:mac-cpp:*), иначе BLAS по умолчанию занимает все ядра
+static size_t BlasThreads() {
+	if (const size_t threads = gBlasThreads.load(std::memory_order_relaxed)) {
+		return threads;
+	}
+	const BlasControl& control = GetBlasControl();
+	if (control.getThreads) {
+		return (size_t)std::max(1, control.getThreads());
+	}
+	for (const char* name : kBlasThreadEnv) {
+		if (const size_t threads = ReadEnvThreads(name)) {
+			return threads;
+		}
+	}
+	return HardwareThreads();
+}
+
+// Возвращает true, если число потоков применено сразу (через API библиотеки).
+// setenv меняет окружение всего процесса и гоняется с getenv из других потоков, поэтому окружение
+// трогаем только без API (vecLib) и только переменную найденной библиотеки - не OMP_NUM_THREADS и не чужие
+static bool SetBlasThreads(size_t threads) {
+	gBlasThreads.store(threads, std::memory_order_relaxed);
+	const BlasControl& control = GetBlasControl();
+	if (control.setThreads) {
+		control.setThreads((int)threads);
+		return true;
+	}
+#ifndef _WIN32
+	if (control.threadEnv) {
+		setenv(control.threadEnv, std::to_string(threads).c_str(), 1);
+	}
+#endif
+	return false;
+}
+
+static size_t UvThreadpoolSize() {
+	const size_t size = ReadEnvThreads("UV_THREADPOOL_SIZE");
+	return size > 0 ? std::min<size_t>(size, 1024) : 4;
+}
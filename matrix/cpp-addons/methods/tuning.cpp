@@ -0,0 +1,32 @@
+#include <napi.h>
+
+// setKernelTuning({ blockCols, poolGrain }) - параметры ядер по умолчанию на процесс.
+// Влияют только на скорость. autotune() их не трогает: он передает настройку в каждый вызов
+// (multiplySimd(A, B, opts), multiplySimdAsync/multiplyPoolAsync(A, B, opts, cb))
+Napi::Value SetKernelTuning(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	if (info.Length() < 1 || !info[0].IsObject()) {
+		Napi::TypeError::New(env, "Ожидается объект { blockCols, poolGrain }").ThrowAsJavaScriptException();
+		return env.Null();
+	}
+
+	Napi::Object opts = info[0].As<Napi::Object>();
+	if (opts.Has("blockCols") && opts.Get("blockCols").IsNumber()) {
+		gSimdBlockCols.store(opts.Get("blockCols").As<Napi::Number>().Uint32Value(), std::memory_order_relaxed);
+	}
+	if (opts.Has("poolGrain") && opts.Get("poolGrain").IsNumber()) {
+		gPoolGrain.store(opts.Get("poolGrain").As<Napi::Number>().Uint32Value(), std::memory_order_relaxed);
+	}
+	return env.Undefined();
+}
+
+// getKernelTuning() -> { blockCols, poolGrain }
+Napi::Value GetKernelTuning(const Napi::CallbackInfo& info) {
+	Napi::Env env = info.Env();
+
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("blockCols", Napi::Number::New(env, (double)gSimdBlockCols.load(std::memory_order_relaxed)));
+	result.Set("poolGrain", Napi::Number::New(env, (double)gPoolGrain.load(std::memory_order_relaxed)));
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <napi.h>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/syscall.h>
+	#include <sys/ioctl.h>
+	#include <unistd.h>
+	#include <dirent.h>
+	#include <cstdlib>
+#else
+	// Без perf_event счетчики не открываются, ioctl - заглушки
+	#define PERF_EVENT_IOC_ENABLE 0
+	#define PERF_EVENT_IOC_DISABLE 0
+	#define PERF_EVENT_IOC_RESET 0
+#endif
+
+// Аппаратные счетчики для isolated бенчмарков через perf_event_open
+// Считаем все потоки процесса (main thread + libuv пул + пул аддона), только user space
+// Если PMU недоступен (macOS, контейнер, perf_event_paranoid) - счетчик просто отсутствует в available
+
+struct PerfEventSpec {
+	const char* name;
+	uint32_t type;
+	uint64_t config;
+};
+
+#ifdef __linux__
+static const PerfEventSpec kPerfEvents[] = {
+	{ "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ "branchMisses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+	{ "l1dMisses", PERF_TYPE_HW_CACHE,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+	{ "llcMisses", PERF_TYPE_HW_CACHE,
+		PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+};
+
+static int OpenPerfEvent(const PerfEventSpec& spec, pid_t tid) {
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = spec.type;
+	attr.config = spec.config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	// Счетчиков больше, чем регистров PMU - ядро мультиплексирует, время нужно для масштабирования
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return (int)syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0);
+}
+
+static std::vector<pid_t> ListThreads() {
+	std::vector<pid_t> tids;
+	if (DIR* dir = opendir("/proc/self/task")) {
+		while (dirent* entry = readdir(dir)) {
+			if (entry->d_name[0] >= '0' && entry->d_name[0] <= '9') {
+				tids.push_back((pid_t)std::atoi(entry->d_name));
+			}
+		}
+		closedir(dir);
+	}
+	return tids;
+}
+#else
+static const PerfEventSpec kPerfEvents[] = {
+	{ "cycles", 0, 0 },
+	{ "instructions", 0, 0 },
+	{ "branchMisses", 0, 0 },
+	{ "l1dMisses", 0, 0 },
+	{ "llcMisses", 0, 0 },
+};
+#endif
+
+static const size_t kPerfEventCount = sizeof(kPerfEvents) / sizeof(kPerfEvents[0]);
+
+// new PerfCounters() - открывает счетчики на всех текущих потоках процесса (выключенными)
+// Потоки, созданные позже, не учитываются - создавать после разогрева
+class PerfCounters : public Napi::ObjectWrap<PerfCounters> {
+public:
+	static Napi::Function Init(Napi::Env env) {
+		return DefineClass(env, "PerfCounters", {
+			InstanceAccessor("available", &PerfCounters::Available, nullptr),
+			InstanceMethod("enable", &PerfCounters::Enable),
+			InstanceMethod("disable", &PerfCounters::Disable),
+			InstanceMethod("reset", &PerfCounters::Reset),
+			InstanceMethod("read", &PerfCounters::Read),
+			InstanceMethod("close", &PerfCounters::Close),
+		});
+	}
+
+	PerfCounters(const Napi::CallbackInfo& info) : Napi::ObjectWrap<PerfCounters>(info) {
+		fds_.resize(kPerfEventCount);
+#ifdef __linux__
+		for (pid_t tid : ListThreads()) {
+			for (size_t e = 0; e < kPerfEventCount; ++e) {
+				int fd = OpenPerfEvent(kPerfEvents[e], tid);
+				if (fd >= 0) {
+					fds_[e].push_back(fd);
+				}
+			}
+		}
+#endif
+	}
+
+	~PerfCounters() { CloseAll(); }
+
+private:
+	Napi::Value Available(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		Napi::Array names = Napi::Array::New(env);
+		for (size_t e = 0; e < kPerfEventCount; ++e) {
+			if (!fds_[e].empty()) {
+				names[names.Length()] = Napi::String::New(env, kPerfEvents[e].name);
+			}
+		}
+		return names;
+	}
+
+	// enable/disable дешевые (ioctl) - их можно звать вокруг каждой итерации
+	Napi::Value Enable(const Napi::CallbackInfo& info) {
+		Ioctl(PERF_EVENT_IOC_ENABLE);
+		return info.Env().Undefined();
+	}
+
+	Napi::Value Disable(const Napi::CallbackInfo& info) {
+		Ioctl(PERF_EVENT_IOC_DISABLE);
+		return info.Env().Undefined();
+	}
+
+	Napi::Value Reset(const Napi::CallbackInfo& info) {
+		Ioctl(PERF_EVENT_IOC_RESET);
+		return info.Env().Undefined();
+	}
+
+	// read() -> { cycles, instructions, ... } - сумма по потокам, null для недоступных счетчиков
+	Napi::Value Read(const Napi::CallbackInfo& info) {
+		Napi::Env env = info.Env();
+		Napi::Object result = Napi::Object::New(env);
+
+		for (size_t e = 0; e < kPerfEventCount; ++e) {
+			if (fds_[e].empty()) {
+				result.Set(kPerfEvents[e].name, env.Null());
+				continue;
+			}
+
+			double total = 0.0;
+#ifdef __linux__
+			for (int fd : fds_[e]) {
+				uint64_t values[3] = { 0, 0, 0 }; // value, time_enabled, time_running
+				if (::read(fd, values, sizeof(values)) != (ssize_t)sizeof(values) || values[2] == 0) {
+					continue;
+				}
+				total += (double)values[0] * ((double)values[1] / (double)values[2]);
+			}
+#endif
+			result.Set(kPerfEvents[e].name, Napi::Number::New(env, total));
+		}
+		return result;
+	}
+
+	Napi::Value Close(const Napi::CallbackInfo& info) {
+		CloseAll();
+		return info.Env().Undefined();
+	}
+
+#ifdef __linux__
+	void Ioctl(unsigned long request) {
+		for (const std::vector<int>& fds : fds_) {
+			for (int fd : fds) {
+				ioctl(fd, request, 0);
+			}
+		}
+	}
+#else
+	void Ioctl(unsigned long) {}
+#endif
+
+	void CloseAll() {
+#ifdef __linux__
+		for (const std::vector<int>& fds : fds_) {
+			for (int fd : fds) {
+				::close(fd);
+			}
+		}
+#endif
+		for (std::vector<int>& fds : fds_) {
+			fds.clear();
+		}
+	}
+
+	std::vector<std::vector<int>> fds_; // fds_[event][thread]
+};
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+	exports.Set("PerfCounters", PerfCounters::Init(env));
+	return exports;
+}
+
+NODE_API_MODULE(perf_counters, Init)
\ No newline at end of file
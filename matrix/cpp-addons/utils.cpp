@@ -92,8 +92,8 @@ static void FlattenRowMajor(const Napi::Array& mat, size_t rows, size_t cols, st
     }
 }
 
-// vector row-major -> JS number[][] (по аналогии с unflatten2D из js-native/worker)
-static Napi::Array RowMajorToJs(const Napi::Env& env, const std::vector<double>& C, size_t rows, size_t cols) {
+// row-major -> JS number[][] (по аналогии с unflatten2D из js-native/worker)
+static Napi::Array RowMajorToJs(const Napi::Env& env, const double* C, size_t rows, size_t cols) {
     Napi::Array jsRes = Napi::Array::New(env, rows);
     for (size_t i = 0; i < rows; ++i) {
         Napi::Array row = Napi::Array::New(env, cols);
@@ -106,8 +106,12 @@ static Napi::Array RowMajorToJs(const Napi::Env& env, const std::vector<double>&
     return jsRes;
 }
 
+static Napi::Array RowMajorToJs(const Napi::Env& env, const std::vector<double>& C, size_t rows, size_t cols) {
+    return RowMajorToJs(env, C.data(), rows, cols);
+}
+
 // Транспонирование row-major B(k x n) -> BT(n x k)
-static void TransposeRowMajor(const std::vector<double>& B, size_t k, size_t n, std::vector<double>& BT) {
+static void TransposeRowMajor(const double* B, size_t k, size_t n, std::vector<double>& BT) {
     BT.resize(n * k);
     for (size_t i = 0; i < k; ++i) {
         const size_t ib = i * n;
@@ -116,4 +120,8 @@ static void TransposeRowMajor(const std::vector<double>& B, size_t k, size_t n,
             BT[j * k + i] = B[ib + j];
         }
     }
-}
\ No newline at end of file
+}
+
+static void TransposeRowMajor(const std::vector<double>& B, size_t k, size_t n, std::vector<double>& BT) {
+    TransposeRowMajor(B.data(), k, n, BT);
+}
@@ -1,4 +1,7 @@
 const http = require('http');
+const fs = require('fs');
+const nodePath = require('path');
+const { monitorEventLoopDelay } = require('perf_hooks');
 
 const { generateMatrix } = require('./utils/generate-matrix');
 const { ENDPOINTS } = require('./utils/endpoints');
@@ -12,6 +15,61 @@ let N = 10;
 let A = generateMatrix(N);
 let B = generateMatrix(N);
 
+// Нативные копии A и B для кеша результатов: хеш содержимого считается один раз на матрицу
+let cppA = new cppMatrix.Matrix(A);
+let cppB = new cppMatrix.Matrix(B);
+
+// Общий бюджет потоков для пула, BLAS и async-задач (npm run start:budget)
+if (process.env.MATRIX_THREAD_BUDGET) {
+    const threads = Number(process.env.MATRIX_THREAD_BUDGET);
+    if (!Number.isInteger(threads) || threads < 1 || threads > 2 ** 31 - 1) {
+        console.error(`MATRIX_THREAD_BUDGET: ожидается целое число от 1 до 2147483647, получено "${process.env.MATRIX_THREAD_BUDGET}"`);
+        process.exit(1);
+    }
+    const config = cppMatrix.setThreadBudget({ threads });
+    console.log(`Thread budget: ${config.budget} (pool ${config.pool.threads}, BLAS ${config.blas.threads} [${config.blas.library}], async jobs ${config.asyncJobs.limit})`);
+}
+
+// Каталог, из которого POST /update-matrix загружает .nmat. Путь приходит из тела запроса, поэтому без
+// MATRIX_DATA_DIR загрузка из файлов выключена, а с ним - только файлы внутри каталога (после symlink тоже)
+const DATA_DIR = process.env.MATRIX_DATA_DIR ? fs.realpathSync(nodePath.resolve(process.env.MATRIX_DATA_DIR)) : null;
+
+function resolveDataPath(file) {
+    if (!DATA_DIR) {
+        throw new Error('загрузка из файлов выключена: задайте MATRIX_DATA_DIR');
+    }
+    if (typeof file !== 'string') {
+        throw new Error('ожидается путь к файлу .nmat');
+    }
+    const prefix = DATA_DIR.endsWith(nodePath.sep) ? DATA_DIR : DATA_DIR + nodePath.sep;
+    const resolved = nodePath.resolve(DATA_DIR, file);
+    // Сначала сам путь (../), потом куда ведут symlink-и: realpath трогает диск только для путей внутри каталога
+    const real = resolved.startsWith(prefix) ? fs.realpathSync(resolved) : resolved;
+    if (!real.startsWith(prefix)) {
+        throw new Error(`путь вне MATRIX_DATA_DIR: ${file}`);
+    }
+    return real;
+}
+
+// Гистограмма задержек event loop: показывает, насколько синхронные вызовы задерживают остальные запросы
+const eventLoopDelay = monitorEventLoopDelay({ resolution: 10 });
+eventLoopDelay.enable();
+
+// Значения гистограммы в наносекундах -> миллисекунды
+function getEventLoopStats() {
+    const toMs = (ns) => ns / 1e6;
+    return {
+        min: toMs(eventLoopDelay.min),
+        max: toMs(eventLoopDelay.max),
+        mean: toMs(eventLoopDelay.mean),
+        stddev: toMs(eventLoopDelay.stddev),
+        p50: toMs(eventLoopDelay.percentile(50)),
+        p90: toMs(eventLoopDelay.percentile(90)),
+        p99: toMs(eventLoopDelay.percentile(99)),
+        p99_9: toMs(eventLoopDelay.percentile(99.9))
+    };
+}
+
 wasmMatrix.initWasm().then(() => {
     console.log('WASM module initialized');
 
@@ -24,10 +82,23 @@ wasmMatrix.initWasm().then(() => {
             req.on('data', chunk => body += chunk);
             req.on('end', async () => {
                 try {
-                    const { size } = JSON.parse(body);
-                    N = size;
-                    A = generateMatrix(N);
-                    B = generateMatrix(N);
+                    const { size, aPath, bPath } = JSON.parse(body);
+                    if (aPath && bPath) {
+                        // Операнды из файлов .nmat: mmap без разбора JSON, number[][] - для JS/WASM/Rust эндпоинтов
+                        const aFile = resolveDataPath(aPath);
+                        const bFile = resolveDataPath(bPath);
+                        cppA = cppMatrix.loadMatrix(aFile);
+                        cppB = cppMatrix.loadMatrix(bFile);
+                        A = cppA.toArray();
+                        B = cppB.toArray();
+                        N = A.length;
+                    } else {
+                        N = size;
+                        A = generateMatrix(N);
+                        B = generateMatrix(N);
+                        cppA = new cppMatrix.Matrix(A);
+                        cppB = new cppMatrix.Matrix(B);
+                    }
                     
                     // GC после обновления
                     if (global.gc) {
@@ -43,6 +114,30 @@ wasmMatrix.initWasm().then(() => {
             return;
         }
 
+        if (path === ENDPOINTS.EVENT_LOOP_STATS) {
+            res.writeHead(200, { 'Content-Type': 'application/json' });
+            res.end(JSON.stringify(getEventLoopStats()));
+            return;
+        }
+
+        if (path === ENDPOINTS.EVENT_LOOP_RESET && req.method === 'POST') {
+            eventLoopDelay.reset();
+            res.end('Event loop stats reset\n');
+            return;
+        }
+
+        if (path === ENDPOINTS.CACHE_STATS) {
+            res.writeHead(200, { 'Content-Type': 'application/json' });
+            res.end(JSON.stringify(cppMatrix.getResultCacheStats()));
+            return;
+        }
+
+        if (path === ENDPOINTS.THREAD_CONFIG) {
+            res.writeHead(200, { 'Content-Type': 'application/json' });
+            res.end(JSON.stringify(cppMatrix.getThreadConfig()));
+            return;
+        }
+
         if (path === ENDPOINTS.SIMPLE) {
             const C = A.length * B.length;
             const ms = performance.now() - start;
@@ -179,6 +274,35 @@ wasmMatrix.initWasm().then(() => {
             return;
         }
 
+        if (path === ENDPOINTS.CPP.CACHED) {
+            cppMatrix.multiplyCachedAsync(cppA, cppB).then((C) => {
+                const ms = performance.now() - start;
+                res.end(`Cpp Cached: C[0][0] = ${C.get(0, 0)} (${ms}ms)\n`);
+            }).catch((err) => {
+                res.end(`Error: ${err.message}\n`);
+            });
+            return;
+        }
+
+        if (path === ENDPOINTS.CPP.SIMD_ABORTABLE) {
+            // Клиент отключился до ответа - задача снимается из очереди или останавливается между полосами
+            const controller = new AbortController();
+            res.on('close', () => {
+                if (!res.writableFinished) {
+                    controller.abort();
+                }
+            });
+            cppMatrix.multiplySimdPromise(A, B, { signal: controller.signal }).then((C) => {
+                const ms = performance.now() - start;
+                res.end(`Cpp SIMD Abortable: C[0][0] = ${C[0][0]} (${ms}ms)\n`);
+            }).catch((err) => {
+                if (err.name !== 'AbortError') {
+                    res.end(`Error: ${err.message}\n`);
+                }
+            });
+            return;
+        }
+
         // ========================== WASM ==========================
 
         if (path === ENDPOINTS.WASM.BASE) {
@@ -1,6 +1,10 @@
 const cppMatrix = require('bindings')('matrix');
-const { generateMatrix } = require('../utils/generate-matrix');
-const { isMatrixEqual, promisifyCallback } = require('./helper');
+const { generateMatrix, quantizeMatrixInt8 } = require('../utils/generate-matrix');
+const { isMatrixEqual, promisifyCallback, makeHashCollision } = require('./helper');
+const os = require('os');
+const path = require('path');
+const { Worker } = require('worker_threads');
+const { promisify } = require('util');
 
 async function testCppAddons() {
     console.log('⚙️ Тест C++ аддонов...\n');
@@ -30,6 +34,442 @@ async function testCppAddons() {
         }
         console.log('✅ C++ SIMD async - OK');
 
+        // Одинаковые вызовы в одном тике склеиваются в один воркер, каждый получает свою копию результата
+        const flightsBefore = cppMatrix.getSimdAsyncStats();
+        const coalescedResults = await Promise.all([
+            promisifyCallback(cppMatrix.multiplySimdAsync)(matrixA, matrixB),
+            promisifyCallback(cppMatrix.multiplySimdAsync)(matrixA.map(row => row.slice()), matrixB),
+            promisifyCallback(cppMatrix.multiplySimdAsync)(matrixA, matrixB)
+        ]);
+        const flightsAfter = cppMatrix.getSimdAsyncStats();
+        if (coalescedResults.some(result => !isMatrixEqual(reference, result)) || coalescedResults[0] === coalescedResults[1]) {
+            throw new Error('Coalesced SIMD async result mismatch');
+        }
+        if (flightsAfter.scheduled !== flightsBefore.scheduled + 1 || flightsAfter.coalesced !== flightsBefore.coalesced + 2 || flightsAfter.inFlight !== 0) {
+            throw new Error('SIMD async coalescing stats mismatch');
+        }
+        // Подобранная коллизия хеша: задачи с одним ключом, но разными данными не склеиваются
+        const simdCollisionRow = [1, 2, 3, 4, 5, 6, 7, 8];
+        const simdForgedRow = makeHashCollision(simdCollisionRow, 1.5);
+        const simdIdentity = [[1, 0, 0, 0], [0, 1, 0, 0], [0, 0, 1, 0], [0, 0, 0, 1]];
+        const simdOriginalA = [simdCollisionRow.slice(0, 4), simdCollisionRow.slice(4)];
+        const simdForgedA = [simdForgedRow.slice(0, 4), simdForgedRow.slice(4)];
+        const collisionsBefore = cppMatrix.getSimdAsyncStats().collisions;
+        const [originalProduct, forgedProduct] = await Promise.all([
+            promisifyCallback(cppMatrix.multiplySimdAsync)(simdOriginalA, simdIdentity),
+            promisifyCallback(cppMatrix.multiplySimdAsync)(simdForgedA, simdIdentity)
+        ]);
+        if (!isMatrixEqual(simdOriginalA, originalProduct) || !isMatrixEqual(simdForgedA, forgedProduct)
+            || cppMatrix.getSimdAsyncStats().collisions !== collisionsBefore + 1) {
+            throw new Error('SIMD async coalesced colliding operands');
+        }
+        console.log('✅ C++ SIMD async coalescing - OK');
+
+        // Исключение в одном callback-е не отменяет остальные склеенные: они получают результат,
+        // а исключение после них уходит в uncaughtException
+        const waiterFailure = new Error('waiter failure');
+        const uncaught = new Promise(resolve => process.once('uncaughtException', resolve));
+        cppMatrix.multiplySimdAsync(matrixA, matrixB, () => { throw waiterFailure; });
+        let lostTimer;
+        const survivors = await Promise.race([
+            Promise.all([
+                promisifyCallback(cppMatrix.multiplySimdAsync)(matrixA, matrixB),
+                promisifyCallback(cppMatrix.multiplySimdAsync)(matrixA, matrixB)
+            ]),
+            new Promise((_, reject) => {
+                lostTimer = setTimeout(() => reject(new Error('Coalesced callbacks lost after a throwing callback')), 5000);
+            })
+        ]).finally(() => clearTimeout(lostTimer));
+        if (survivors.some(result => !isMatrixEqual(reference, result)) || (await uncaught) !== waiterFailure) {
+            throw new Error('SIMD async throwing callback mismatch');
+        }
+        console.log('✅ C++ SIMD async throwing callback - OK');
+
+        cppMatrix.configureComputePool({ threads: 3, pin: true });
+        const topology = cppMatrix.getComputeTopology();
+        if (topology.threads !== 3 || topology.nodes.reduce((sum, node) => sum + node.threads, 0) !== 3) {
+            throw new Error('Compute pool topology mismatch');
+        }
+        // Доля узла - пропорционально числу его ядер с точностью до округления
+        const topologyCpus = topology.nodes.reduce((sum, node) => sum + node.cpus.length, 0);
+        if (topology.nodes.some(node => Math.abs(node.threads - 3 * node.cpus.length / topologyCpus) >= 1) || typeof topology.pinFailures !== 'number') {
+            throw new Error('Compute pool thread placement mismatch');
+        }
+        const poolResult = await promisifyCallback(cppMatrix.multiplyPoolAsync)(matrixA, matrixB);
+        if (!isMatrixEqual(reference, poolResult)) {
+            throw new Error('Pool async result mismatch');
+        }
+        cppMatrix.configureComputePool();
+        console.log('✅ C++ Pool async - OK');
+
+        // Бюджет потоков: пул, BLAS и async-задачи делят threads; лишние задачи ждут, а не вытесняют друг друга
+        const budget = cppMatrix.setThreadBudget({ threads: 2 });
+        if (budget.budget !== 2 || budget.pool.threads !== 2 || budget.blas.threads !== 1 || budget.asyncJobs.limit !== 2) {
+            throw new Error('Thread budget config mismatch');
+        }
+        const budgetResults = await Promise.all([1, 2, 3, 4].map(scale =>
+            promisifyCallback(cppMatrix.multiplySimdAsync)(matrixA.map(row => row.map(v => v * scale)), matrixB)
+        ));
+        if (budgetResults.some((result, i) => !isMatrixEqual(reference.map(row => row.map(v => v * (i + 1))), result))) {
+            throw new Error('Thread budget result mismatch');
+        }
+        const budgetAfter = cppMatrix.getThreadConfig();
+        if (budgetAfter.asyncJobs.admitted < budget.asyncJobs.admitted + 4 || budgetAfter.asyncJobs.active !== 0 || budgetAfter.asyncJobs.activeThreads !== 0) {
+            throw new Error('Thread budget stats mismatch');
+        }
+        // Допуск на main thread: лишние задачи ждут в очереди бюджета, а не на потоках libuv,
+        // поэтому fs не стоит за ними. Ждущую задачу abort снимает сразу
+        cppMatrix.setThreadBudget({ threads: 1 });
+        const heavyMatrix = generateMatrix(400);
+        const gated = [
+            promisifyCallback(cppMatrix.multiplySimdAsync)(heavyMatrix, heavyMatrix),
+            ...[2, 3].map(scale => promisifyCallback(cppMatrix.multiplySimdAsync)(matrixA.map(row => row.map(v => v * scale + 1)), matrixB))
+        ];
+        const abortWaiting = new AbortController();
+        const waitingRun = cppMatrix.multiplySimdPromise(matrixA, matrixB, { signal: abortWaiting.signal }).then(() => 'resolved', (e) => e.name);
+        const waitingBefore = cppMatrix.getThreadConfig().asyncJobs.waiting;
+        abortWaiting.abort();
+        const waitingAfter = cppMatrix.getThreadConfig().asyncJobs.waiting;
+        await require('fs').promises.readFile(__filename);
+        if (waitingBefore !== 3 || waitingAfter !== 2 || await waitingRun !== 'AbortError') {
+            throw new Error(`Thread budget queue mismatch: ${waitingBefore} -> ${waitingAfter}`);
+        }
+        await Promise.all(gated);
+        if (cppMatrix.getThreadConfig().asyncJobs.waiting !== 0) {
+            throw new Error('Thread budget queue was not drained');
+        }
+        cppMatrix.setThreadBudget();
+        // NaN/Infinity/дробные отклоняются TypeError, а не превращаются в 0 потоков
+        for (const threads of [NaN, Infinity, 2 ** 32, 1.5, 0]) {
+            let rejected = false;
+            try {
+                cppMatrix.setThreadBudget({ threads });
+            } catch (e) {
+                rejected = e instanceof TypeError;
+            }
+            if (!rejected) {
+                throw new Error(`Thread budget accepted threads: ${threads}`);
+            }
+        }
+        console.log('✅ C++ Thread budget - OK');
+
+        // Promise-варианты с AbortSignal и дедлайном: отмена до старта, во время счета и по timeout
+        const rejectionName = (promise) => promise.then(() => 'resolved', (e) => e.name);
+        if (!isMatrixEqual(reference, await cppMatrix.multiplySimdPromise(matrixA, matrixB))
+            || !isMatrixEqual(reference, await cppMatrix.multiplyPoolPromise(matrixA, matrixB, { signal: new AbortController().signal }))) {
+            throw new Error('Abortable multiply result mismatch');
+        }
+        const abortedBefore = new AbortController();
+        abortedBefore.abort();
+        if (await rejectionName(cppMatrix.multiplySimdPromise(matrixA, matrixB, { signal: abortedBefore.signal })) !== 'AbortError') {
+            throw new Error('Pre-aborted multiply was not rejected');
+        }
+        const bigMatrix = generateMatrix(600);
+        const abortDuring = new AbortController();
+        const abortedRun = rejectionName(cppMatrix.multiplySimdPromise(bigMatrix, bigMatrix, { signal: abortDuring.signal }));
+        setTimeout(() => abortDuring.abort(), 5);
+        if (await abortedRun !== 'AbortError') {
+            throw new Error('Running multiply was not aborted');
+        }
+        if (await rejectionName(cppMatrix.multiplyPoolPromise(bigMatrix, bigMatrix, { timeout: 1 })) !== 'TimeoutError') {
+            throw new Error('Multiply deadline was not applied');
+        }
+        // Infinity - без дедлайна; NaN и больше 2^31-1 мс (setTimeout сработал бы сразу) - ошибка аргумента
+        if (!isMatrixEqual(reference, await cppMatrix.multiplySimdPromise(matrixA, matrixB, { timeout: Infinity }))) {
+            throw new Error('Infinite timeout did not resolve');
+        }
+        for (const timeout of [NaN, -1, 2 ** 31]) {
+            let rejected = false;
+            try {
+                cppMatrix.multiplySimdPromise(matrixA, matrixB, { timeout });
+            } catch (e) {
+                rejected = e instanceof TypeError;
+            }
+            if (!rejected) {
+                throw new Error(`Abortable multiply accepted timeout: ${timeout}`);
+            }
+        }
+        console.log('✅ C++ Abortable multiply - OK');
+
+        const autotuneFile = path.join(os.tmpdir(), `matrix-autotune-${process.pid}.json`);
+        const autotune = require('../cpp-addons/autotune');
+        const table = await autotune.autotune({ sizes: [8, 16], repeats: 1, file: autotuneFile });
+        if (table.entries.length !== 2 || !autotune.loadTable(autotuneFile)) {
+            throw new Error('Autotune table mismatch');
+        }
+        if (!isMatrixEqual(reference, await autotune.multiply(matrixA, matrixB))) {
+            throw new Error('Autotune multiply result mismatch');
+        }
+        // Таблица по формам: высокая и широкая задачи - разные корзины
+        const shapeTable = await autotune.autotune({ shapes: [[8, 64, 8], [64, 8, 64]], kernels: ['simd', 'pool-async'], repeats: 1, file: autotuneFile });
+        const tall = autotune.selectEntry(8, 60, 8);
+        const wide = autotune.selectEntry(50, 8, 64);
+        if (shapeTable.entries.length !== 2 || tall.k !== 64 || tall.m !== 8 || wide.m !== 64 || wide.k !== 8) {
+            throw new Error('Autotune shape buckets mismatch');
+        }
+        // Настройка идет в вызов, а не в глобальное состояние: параллельные вызовы с разной настройкой
+        const tuningBefore = cppMatrix.getKernelTuning();
+        const tuned = await Promise.all([
+            promisify(cppMatrix.multiplyPoolAsync)(matrixA, matrixB, { blockCols: 3, poolGrain: 1 }),
+            promisify(cppMatrix.multiplySimdAsync)(matrixA, matrixB, { blockCols: 7 }),
+            autotune.multiply(matrixA, matrixB)
+        ]);
+        if (!tuned.every(result => isMatrixEqual(reference, result)) || !isMatrixEqual(reference, cppMatrix.multiplySimd(matrixA, matrixB, { blockCols: 4 }))) {
+            throw new Error('Per-call tuning result mismatch');
+        }
+        const tuningAfter = cppMatrix.getKernelTuning();
+        if (tuningAfter.blockCols !== tuningBefore.blockCols || tuningAfter.poolGrain !== tuningBefore.poolGrain) {
+            throw new Error('Per-call tuning changed process tuning');
+        }
+        let badTuningRejected = false;
+        try {
+            cppMatrix.multiplySimd(matrixA, matrixB, { blockCols: -1 });
+        } catch (e) {
+            badTuningRejected = e instanceof TypeError;
+        }
+        if (!badTuningRejected) {
+            throw new Error('Negative blockCols accepted');
+        }
+        require('fs').unlinkSync(autotuneFile);
+        console.log('✅ C++ Autotune - OK');
+
+        const qA = quantizeMatrixInt8(matrixA);
+        const qB = quantizeMatrixInt8(matrixB);
+        const int8Result = cppMatrix.multiplyInt8(qA.data, qB.data, 10, 10, 10);
+        for (let i = 0; i < 10; i++) {
+            for (let j = 0; j < 10; j++) {
+                let acc = 0;
+                for (let t = 0; t < 10; t++) {
+                    acc += qA.data[i * 10 + t] * qB.data[t * 10 + j];
+                }
+                if (int8Result[i * 10 + j] !== acc) {
+                    throw new Error('Int8 result mismatch');
+                }
+            }
+        }
+
+        const rowScales = new Float32Array(10).fill(qA.scale * qB.scale);
+        const dequantized = cppMatrix.multiplyInt8(qA.data, qB.data, 10, 10, 10, rowScales);
+        for (let i = 0; i < 10; i++) {
+            for (let j = 0; j < 10; j++) {
+                if (Math.abs(dequantized[i * 10 + j] - reference[i][j]) > 0.1) {
+                    throw new Error('Int8 dequantized result mismatch');
+                }
+            }
+        }
+
+        // uint8 x uint8: k = 33026 уже может переполнить int32-накопитель
+        const kOverflow = 33026;
+        let overflowRejected = false;
+        try {
+            cppMatrix.multiplyInt8(new Uint8Array(kOverflow).fill(255), new Uint8Array(kOverflow).fill(255), 1, kOverflow, 1);
+        } catch (e) {
+            overflowRejected = e instanceof RangeError;
+        }
+        if (!overflowRejected) {
+            throw new Error('Int8 overflow k was not rejected');
+        }
+        const kMax = kOverflow - 1;
+        const maxResult = cppMatrix.multiplyInt8(new Uint8Array(kMax).fill(255), new Uint8Array(kMax).fill(255), 1, kMax, 1);
+        if (maxResult[0] !== kMax * 255 * 255) {
+            throw new Error('Int8 result mismatch at max k');
+        }
+        console.log('✅ C++ Int8 - OK');
+
+        const matrixC = generateMatrix(10, () => Math.random() - 3);
+        const expected = reference.map((row, i) => row.map((v, j) => Math.max((v + matrixC[i][j]) * 2, 0)));
+        const expr = new cppMatrix.Matrix(matrixA)
+            .mul(new cppMatrix.Matrix(matrixB))
+            .add(new cppMatrix.Matrix(matrixC))
+            .scale(2)
+            .relu();
+        if (!expr.lazy || !isMatrixEqual(expected, expr.eval().toArray())) {
+            throw new Error('Lazy expression result mismatch');
+        }
+        const exprAsync = await new Promise((resolve, reject) => {
+            expr.evalAsync((err, result) => err ? reject(err) : resolve(result));
+        });
+        if (exprAsync.lazy || !isMatrixEqual(expected, exprAsync.toArray())) {
+            throw new Error('Lazy expression async result mismatch');
+        }
+        console.log('✅ C++ Lazy expressions - OK');
+
+        cppMatrix.clearResultCache();
+        const cacheA = new cppMatrix.Matrix(matrixA);
+        const cacheB = new cppMatrix.Matrix(matrixB);
+        const statsBefore = cppMatrix.getResultCacheStats();
+        if (!isMatrixEqual(reference, cppMatrix.multiplyCached(cacheA, cacheB).toArray())) {
+            throw new Error('Cached result mismatch');
+        }
+        // Тот же контент из number[][] - попадание по хешу, а не по идентичности объектов
+        const cachedAgain = await cppMatrix.multiplyCachedAsync(matrixA, cacheB);
+        const statsAfter = cppMatrix.getResultCacheStats();
+        if (!isMatrixEqual(reference, cachedAgain.toArray())) {
+            throw new Error('Cached async result mismatch');
+        }
+        if (statsAfter.hits !== statsBefore.hits + 1 || statsAfter.misses !== statsBefore.misses + 1 || statsAfter.entries !== 1) {
+            throw new Error('Result cache stats mismatch');
+        }
+        // Подобранная коллизия хеша: другие данные с тем же ключом получают свой результат, а не закешированный
+        const collisionRow = [1, 2, 3, 4, 5, 6, 7, 8];
+        const forgedRow = makeHashCollision(collisionRow, 1.5);
+        const identity4 = [[1, 0, 0, 0], [0, 1, 0, 0], [0, 0, 1, 0], [0, 0, 0, 1]];
+        const forgedA = [forgedRow.slice(0, 4), forgedRow.slice(4)];
+        cppMatrix.multiplyCached([collisionRow.slice(0, 4), collisionRow.slice(4)], identity4);
+        if (!isMatrixEqual(forgedA, cppMatrix.multiplyCached(forgedA, identity4).toArray()) || cppMatrix.getResultCacheStats().collisions !== 1) {
+            throw new Error('Result cache served a colliding entry');
+        }
+        cppMatrix.configureResultCache({ maxBytes: 0 });
+        if (cppMatrix.getResultCacheStats().entries !== 0) {
+            throw new Error('Result cache eviction mismatch');
+        }
+        cppMatrix.configureResultCache({ maxBytes: 256 * 1024 * 1024 });
+        console.log('✅ C++ Result cache - OK');
+
+        // Out-of-core: операнды и результат - файлы; мелкие плитки, чтобы было несколько проходов
+        const fs = require('fs');
+        const filePrefix = path.join(os.tmpdir(), `matrix-ooc-${process.pid}`);
+        const writeRaw = (file, matrix) => fs.writeFileSync(file, Buffer.from(new Float64Array(matrix.flat()).buffer));
+        writeRaw(`${filePrefix}-a.bin`, matrixA);
+        writeRaw(`${filePrefix}-b.bin`, matrixB);
+        const progress = [];
+        const fileResult = await cppMatrix.multiplyFilesAsync(`${filePrefix}-a.bin`, `${filePrefix}-b.bin`, `${filePrefix}-c.bin`, 10, 10, 10, {
+            tileRows: 3,
+            tileCols: 4,
+            onProgress: (done, total) => progress.push([done, total])
+        });
+        // Buffer из readFileSync может лежать в общем пуле со смещением: копируем ровно байты файла
+        const rawC = fs.readFileSync(`${filePrefix}-c.bin`);
+        const fileC = new Float64Array(Uint8Array.prototype.slice.call(rawC).buffer);
+        const fileMatrix = Array.from({ length: 10 }, (_, i) => Array.from(fileC.subarray(i * 10, i * 10 + 10)));
+        for (const suffix of ['a', 'b', 'c']) {
+            fs.unlinkSync(`${filePrefix}-${suffix}.bin`);
+        }
+        if (!isMatrixEqual(reference, fileMatrix) || fileResult.passes !== 3) {
+            throw new Error('Out-of-core result mismatch');
+        }
+        // Промежуточные отметки могут склеиваться, поэтому проверяем только диапазон
+        if (progress.length === 0 || progress.some(([done, total]) => total !== 12 || done < 1 || done > 12)) {
+            throw new Error('Out-of-core progress mismatch');
+        }
+        console.log('✅ C++ Out-of-core files - OK');
+
+        // Формат .nmat: save/load без копирования, col-major и проверка контрольной суммы
+        const nmatA = `${filePrefix}-a.nmat`;
+        const nmatB = `${filePrefix}-b.nmat`;
+        const nmatC = `${filePrefix}-c.nmat`;
+        cppMatrix.saveMatrix(nmatA, matrixA);
+        new cppMatrix.Matrix(matrixB).save(nmatB);
+        const loadedA = cppMatrix.loadMatrix(nmatA, { verify: true });
+        if (loadedA.rows !== 10 || !isMatrixEqual(matrixA, loadedA.toArray()) || !isMatrixEqual(reference, loadedA.mul(cppMatrix.loadMatrix(nmatB)).eval().toArray())) {
+            throw new Error('Matrix file load mismatch');
+        }
+        cppMatrix.saveMatrix(nmatC, matrixA, { layout: 'col-major' });
+        const colMajor = cppMatrix.loadMatrixData(nmatC);
+        if (colMajor.layout !== 'col-major' || colMajor.data[1] !== matrixA[1][0] || colMajor.data[10] !== matrixA[0][1]) {
+            throw new Error('Matrix file col-major mismatch');
+        }
+        // Запись в Float64Array не должна попадать в файл (copy-on-write)
+        const rowMajor = cppMatrix.loadMatrixData(nmatA);
+        rowMajor.data[0] = 12345;
+        if (cppMatrix.loadMatrixData(nmatA).data[0] !== matrixA[0][0]) {
+            throw new Error('Matrix file copy-on-write mismatch');
+        }
+        // Out-of-core по .nmat: размеры из заголовков, результат тоже .nmat
+        await cppMatrix.multiplyFilesAsync(nmatA, nmatB, nmatC, { tileRows: 4 });
+        if (!isMatrixEqual(reference, cppMatrix.loadMatrix(nmatC, { verify: true }).toArray())) {
+            throw new Error('Out-of-core .nmat result mismatch');
+        }
+        const corrupted = fs.readFileSync(nmatA);
+        corrupted.writeDoubleLE(corrupted.readDoubleLE(64) + 1, 64);
+        fs.writeFileSync(nmatA, corrupted);
+        let checksumError = null;
+        try {
+            cppMatrix.loadMatrix(nmatA, { verify: true });
+        } catch (e) {
+            checksumError = e;
+        }
+        for (const file of [nmatA, nmatB, nmatC]) {
+            fs.unlinkSync(file);
+        }
+        if (!checksumError) {
+            throw new Error('Matrix file checksum was not verified');
+        }
+        console.log('✅ C++ Matrix files (.nmat) - OK');
+
+        // Общая матрица: один буфер на процесс, worker_threads получают ее по id и умножают одновременно
+        const sharedA = new cppMatrix.Matrix(matrixA);
+        const sharedId = cppMatrix.shareMatrix(sharedA);
+        if (cppMatrix.shareMatrix(sharedA) !== sharedId || cppMatrix.getSharedMatrixStats().refs < 2) {
+            throw new Error('Shared matrix refcount mismatch');
+        }
+        const sharedWorkerCode = `
+            const { parentPort, workerData } = require('worker_threads');
+            const cppMatrix = require(workerData.bindings)({ bindings: 'matrix', module_root: workerData.root });
+            const A = cppMatrix.getSharedMatrix(workerData.id);
+            parentPort.postMessage(A.mul(new cppMatrix.Matrix(workerData.B)).eval().toArray());
+        `;
+        const sharedResults = await Promise.all([0, 1].map(() => new Promise((resolve, reject) => {
+            const worker = new Worker(sharedWorkerCode, {
+                eval: true,
+                workerData: { id: sharedId, B: matrixB, bindings: require.resolve('bindings'), root: path.join(__dirname, '..') }
+            });
+            worker.once('message', resolve);
+            worker.once('error', reject);
+        })));
+        if (sharedResults.some(result => !isMatrixEqual(reference, result))) {
+            throw new Error('Shared matrix worker result mismatch');
+        }
+        if (!cppMatrix.releaseSharedMatrix(sharedId) || !cppMatrix.releaseSharedMatrix(sharedId) || cppMatrix.releaseSharedMatrix(sharedId)) {
+            throw new Error('Shared matrix release mismatch');
+        }
+        try {
+            cppMatrix.getSharedMatrix(sharedId);
+            throw new Error('Released shared matrix still available');
+        } catch (e) {
+            if (e.message === 'Released shared matrix still available') {
+                throw e;
+            }
+        }
+        console.log('✅ C++ Shared matrix (worker_threads) - OK');
+
+        // Диагональное преобладание: A гарантированно невырождена, A * A^T + n*I - положительно определена
+        const n = 100;
+        const sysA = generateMatrix(n);
+        sysA.forEach((row, i) => { row[i] += n; });
+        const sysX = generateMatrix(n).map(row => row.slice(0, 3));
+        const sysB = cppMatrix.multiplyBase(sysA, sysX);
+
+        if (!isMatrixEqual(sysX, cppMatrix.solve(sysA, sysB))) {
+            throw new Error('Solve result mismatch');
+        }
+        const solveAsyncResult = await promisifyCallback(cppMatrix.solveAsync)(sysA, sysB);
+        if (!isMatrixEqual(sysX, solveAsyncResult)) {
+            throw new Error('Solve async result mismatch');
+        }
+
+        const { L, U, pivots } = cppMatrix.lu(sysA);
+        const permutedA = Array.from(pivots, (p) => sysA[p]);
+        if (!isMatrixEqual(permutedA, cppMatrix.multiplyBase(L, U))) {
+            throw new Error('LU result mismatch');
+        }
+
+        const identity = sysA.map((row, i) => row.map((_, j) => (i === j ? 1 : 0)));
+        const inv = await new Promise((resolve, reject) => {
+            cppMatrix.inverseAsync(sysA, (err, result) => err ? reject(err) : resolve(result));
+        });
+        if (!isMatrixEqual(identity, cppMatrix.multiplyBase(sysA, inv))) {
+            throw new Error('Inverse result mismatch');
+        }
+
+        const spd = cppMatrix.multiplyBase(sysA, sysA.map((_, i) => sysA.map(row => row[i])));
+        const chol = cppMatrix.cholesky(spd);
+        const cholT = chol.map((_, i) => chol.map(row => row[i]));
+        if (!isMatrixEqual(spd, cppMatrix.multiplyBase(chol, cholT), 1e-6 * n * n)) {
+            throw new Error('Cholesky result mismatch');
+        }
+        console.log('✅ C++ LU / Cholesky / solve / inverse - OK');
+
         if (process.platform === 'darwin') {
             try {
                 const accelerateResult = cppMatrix.multiplyAccelerate(matrixA, matrixB);
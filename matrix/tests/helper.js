@@ -27,7 +27,38 @@ function promisifyCallback(func) {
     };
   }
 
+// Две разные строки по 8 чисел с одинаковым HashDoubles (content_hash.cpp): раунд xxHash64 обратим,
+// поэтому после замены values[0] подбираем values[4] (та же полоса), возвращающий полосу в прежнее состояние.
+// Нужна тестам, проверяющим, что кеш и склейка задач сравнивают данные, а не только хеш
+function makeHashCollision(values, replacement) {
+    const mask = (1n << 64n) - 1n;
+    const prime1 = 0x9E3779B185EBCA87n;
+    const prime2 = 0xC2B2AE3D27D4EB4Fn;
+    const rotl = (x, r) => ((x << BigInt(r)) | (x >> BigInt(64 - r))) & mask;
+    const round = (acc, word) => (rotl((acc + word * prime2) & mask, 31) * prime1) & mask;
+    const view = new DataView(new ArrayBuffer(8));
+    const toBits = (value) => { view.setFloat64(0, value, true); return view.getBigUint64(0, true); };
+    const fromBits = (bits) => { view.setBigUint64(0, bits, true); return view.getFloat64(0, true); };
+
+    // prime2 нечетное - обратный по модулю 2^64 методом Ньютона
+    let inverse = prime2;
+    for (let i = 0; i < 6; i++) {
+        inverse = (inverse * (2n - prime2 * inverse)) & mask;
+    }
+
+    const lane0 = (prime1 + prime2) & mask;
+    const original = round(lane0, toBits(values[0]));
+    const replaced = round(lane0, toBits(replacement));
+    const word4 = ((((original + toBits(values[4]) * prime2) & mask) - replaced) & mask) * inverse & mask;
+
+    const result = values.slice();
+    result[0] = replacement;
+    result[4] = fromBits(word4);
+    return result;
+}
+
 module.exports = {
     isMatrixEqual,
-    promisifyCallback
+    promisifyCallback,
+    makeHashCollision
 }
\ No newline at end of file
@@ -33,6 +33,41 @@ async function testWasmAddons() {
         }
         console.log('✅ WASM SIMD async - OK');
 
+        // matrix.wasm без *_ptr функций - устаревший артефакт, это ошибка, а не пропуск
+        if (!matrix.hasHeapExports()) {
+            throw new Error('matrix.wasm собран без *_ptr функций, пересоберите: npm run build:wasm');
+        }
+        // Прямоугольные матрицы с хвостами по строкам и столбцам (embind версии умеют только n x n)
+        const rectA = generateMatrix(13).slice(0, 7);
+        const rectB = generateMatrix(13);
+        const rectReference = rectA.map(row => rectB[0].map((_, j) => row.reduce((sum, a, p) => sum + a * rectB[p][j], 0)));
+
+        if (!isMatrixEqual(rectReference, matrix.multiplyBaseHeap(rectA, rectB))) {
+            throw new Error('Heap base result mismatch');
+        }
+        if (!isMatrixEqual(rectReference, matrix.multiplySimdHeap(rectA, rectB))) {
+            throw new Error('Heap SIMD result mismatch');
+        }
+        console.log('✅ WASM heap (base + SIMD) - OK');
+
+        if (!matrix.hasThreadsBuild()) {
+            throw new Error('Нет matrix-threads.mjs, пересоберите: npm run build:wasm');
+        }
+        // 70 строк: несколько полос по потокам и хвост микроядра у последней
+        const bigA = generateMatrix(70);
+        const bigB = generateMatrix(70);
+        const bigReference = matrix.multiplyBase(bigA, bigB);
+
+        const [first, second] = await Promise.all([
+            matrix.multiplyThreads(bigA, bigB),
+            matrix.multiplyThreads(bigA, bigB, 2)
+        ]);
+        if (!isMatrixEqual(bigReference, first) || !isMatrixEqual(bigReference, second)) {
+            throw new Error('Threads result mismatch');
+        }
+        await matrix.terminateThreads();
+        console.log('✅ WASM threads - OK');
+
         console.log('🎉 WASM тесты пройдены!\n');
         return true;
     } catch (error) {
@@ -1,6 +1,10 @@
 const ENDPOINTS = {
     SIMPLE: '/simple',
     UPDATE_MATRIX: '/update-matrix',
+    EVENT_LOOP_STATS: '/event-loop-stats',
+    EVENT_LOOP_RESET: '/event-loop-reset',
+    CACHE_STATS: '/cpp-cache-stats',
+    THREAD_CONFIG: '/cpp-thread-config',
 
     JS: {
         BASE: '/js-base',
@@ -16,6 +20,8 @@ const ENDPOINTS = {
         SIMD_ASYNC: '/cpp-simd-async',
         ACCELERATE: '/cpp-accelerate',
         ACCELERATE_ASYNC: '/cpp-accelerate-async',
+        CACHED: '/cpp-cached',
+        SIMD_ABORTABLE: '/cpp-simd-abortable',
     },
     WASM: {
         BASE: '/wasm-base',
@@ -46,6 +52,8 @@ const multiplyEndpoints = [
     ENDPOINTS.CPP.SIMD_ASYNC,
     ENDPOINTS.CPP.ACCELERATE,
     ENDPOINTS.CPP.ACCELERATE_ASYNC,
+    ENDPOINTS.CPP.CACHED,
+    ENDPOINTS.CPP.SIMD_ABORTABLE,
 
     ENDPOINTS.WASM.BASE,
     ENDPOINTS.WASM.WORKER,
@@ -4,4 +4,27 @@ function generateMatrix(n, filler = () => Math.random()) {
     );
 }
 
-module.exports = { generateMatrix };
\ No newline at end of file
+// number[][] -> Int8Array row-major с симметричным масштабом (x ≈ q * scale)
+function quantizeMatrixInt8(matrix) {
+    const rows = matrix.length;
+    const cols = matrix[0].length;
+
+    let maxAbs = 0;
+    for (let i = 0; i < rows; i++) {
+        for (let j = 0; j < cols; j++) {
+            maxAbs = Math.max(maxAbs, Math.abs(matrix[i][j]));
+        }
+    }
+
+    const scale = maxAbs > 0 ? maxAbs / 127 : 1;
+    const data = new Int8Array(rows * cols);
+    for (let i = 0; i < rows; i++) {
+        for (let j = 0; j < cols; j++) {
+            data[i * cols + j] = Math.round(matrix[i][j] / scale);
+        }
+    }
+
+    return { data, rows, cols, scale };
+}
+
+module.exports = { generateMatrix, quantizeMatrixInt8 };
\ No newline at end of file
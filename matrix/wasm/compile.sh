@@ -1,11 +1,52 @@
 #!/bin/bash
+set -e
 
+# Собранный модуль должен экспортировать все перечисленные имена: иначе это устаревший артефакт
+require_exports() {
+	local file=$1
+	shift
+	for name in "$@"; do
+		if ! grep -q "$name" "$file"; then
+			echo "$file: нет экспорта $name, сборка не годится для коммита" >&2
+			exit 1
+		fi
+	done
+}
+
+# _malloc/_free и HEAPF64 нужны для *_ptr функций: JS пишет матрицы прямо в память модуля
+em++ matrix.cpp -O3 \
+-s WASM=1 \
+-s MODULARIZE=1 \
+-s EXPORT_ES6=1 \
+-s ENVIRONMENT=node \
+-s ALLOW_MEMORY_GROWTH=1 \
+-s EXPORTED_FUNCTIONS=_malloc,_free,_multiply_base_ptr,_multiply_simd_ptr \
+-s EXPORTED_RUNTIME_METHODS=HEAPF64 \
+-msimd128 \
+-mrelaxed-simd \
+-lembind \
+-o matrix.mjs
+
+require_exports matrix.mjs _malloc _free _multiply_base_ptr _multiply_simd_ptr HEAPF64
+
+# Многопоточная сборка: память модуля - SharedArrayBuffer, воркеры пула создаются при загрузке модуля
+# (пока вызывающий поток ждет join, новый воркер загрузиться не успеет). Используется из worker-matrix/worker-threads.js
 em++ matrix.cpp -O3 \
+-pthread \
 -s WASM=1 \
 -s MODULARIZE=1 \
 -s EXPORT_ES6=1 \
 -s ENVIRONMENT=node \
+-s PTHREAD_POOL_SIZE=navigator.hardwareConcurrency \
+-s ALLOW_MEMORY_GROWTH=1 \
+-s MAXIMUM_MEMORY=4GB \
+-s EXPORTED_FUNCTIONS=_malloc,_free,_multiply_simd_ptr,_multiply_threads_ptr \
+-s EXPORTED_RUNTIME_METHODS=HEAPF64 \
 -msimd128 \
 -mrelaxed-simd \
 -lembind \
--o matrix.mjs
\ No newline at end of file
+-o matrix-threads.mjs
+
+require_exports matrix-threads.mjs _malloc _free _multiply_simd_ptr _multiply_threads_ptr HEAPF64
+# Воркеры пула pthreads грузят matrix-threads.wasm рядом с .mjs: без него модуль не загрузится
+test -f matrix-threads.wasm
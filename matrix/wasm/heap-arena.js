@@ -0,0 +1,42 @@
+// Постоянный буфер в памяти WASM модуля для *_ptr функций
+// Выделяется через _malloc один раз и растет по необходимости, поэтому вызовы не платят за malloc/free
+class WasmHeapArena {
+	constructor(module) {
+		this.module = module;
+		this.ptr = 0;
+		this.capacity = 0; // в double
+	}
+
+	// Гарантирует место под count double, возвращает смещение начала арены в HEAPF64
+	reserve(count) {
+		if (count > this.capacity) {
+			if (this.ptr) {
+				this.module._free(this.ptr);
+			}
+			// Запас в полтора раза, чтобы серия растущих размеров не перевыделяла арену каждый раз
+			const capacity = Math.ceil(count * 1.5);
+			this.ptr = this.module._malloc(capacity * Float64Array.BYTES_PER_ELEMENT);
+			if (!this.ptr) {
+				this.capacity = 0;
+				throw new Error('Не удалось выделить память в WASM модуле');
+			}
+			this.capacity = capacity;
+		}
+		return this.ptr / Float64Array.BYTES_PER_ELEMENT;
+	}
+
+	// HEAPF64 пересоздается при росте памяти (ALLOW_MEMORY_GROWTH), поэтому берем его заново при каждом вызове
+	get heap() {
+		return this.module.HEAPF64;
+	}
+
+	release() {
+		if (this.ptr) {
+			this.module._free(this.ptr);
+		}
+		this.ptr = 0;
+		this.capacity = 0;
+	}
+}
+
+module.exports = { WasmHeapArena };
\ No newline at end of file
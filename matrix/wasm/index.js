@@ -1,12 +1,65 @@
-const { multiplyWorker, multiplySimdWorker } = require('./worker-matrix');
+const { multiplyWorker, multiplySimdWorker, multiplyThreads, terminateThreads, hasThreadsBuild } = require('./worker-matrix');
+const { WasmHeapArena } = require('./heap-arena');
 
 let MatrixMultiplier;
+let arena;
 
 async function initWasm() {
 	const { default: init } = await import('./matrix.mjs');
 
 	const module = await init();
 	MatrixMultiplier = module;
+	arena = hasHeapExports() ? new WasmHeapArena(module) : null;
+}
+
+// *_ptr функции есть только в модуле, собранном текущим compile.sh
+function hasHeapExports() {
+	return !!(MatrixMultiplier && MatrixMultiplier._malloc && MatrixMultiplier.HEAPF64 && MatrixMultiplier._multiply_simd_ptr);
+}
+
+// Умножение через память модуля: строки A и B копируются в HEAPF64 через TypedArray.set (без val на каждый элемент),
+// в WASM передаются только указатели
+function multiplyHeap(kernel, A, B) {
+	if (!arena) {
+		throw new Error('WASM модуль собран без *_ptr функций, пересоберите: npm run build:wasm');
+	}
+
+	const m = A.length;
+	const k = B.length;
+	const n = B[0].length;
+	if (A[0].length !== k) {
+		throw new Error('Неподходящие размеры матриц для умножения');
+	}
+
+	const base = arena.reserve(m * k + k * n + m * n);
+	const aOffset = base;
+	const bOffset = aOffset + m * k;
+	const cOffset = bOffset + k * n;
+
+	const heap = arena.heap;
+	for (let i = 0; i < m; i++) {
+		heap.set(A[i], aOffset + i * k);
+	}
+	for (let p = 0; p < k; p++) {
+		heap.set(B[p], bOffset + p * n);
+	}
+
+	const bytes = Float64Array.BYTES_PER_ELEMENT;
+	kernel(aOffset * bytes, bOffset * bytes, cOffset * bytes, m, k, n);
+
+	const C = new Array(m);
+	for (let i = 0; i < m; i++) {
+		C[i] = Array.from(arena.heap.subarray(cOffset + i * n, cOffset + (i + 1) * n));
+	}
+	return C;
+}
+
+function multiplyBaseHeap(A, B) {
+	return multiplyHeap(MatrixMultiplier?._multiply_base_ptr, A, B);
+}
+
+function multiplySimdHeap(A, B) {
+	return multiplyHeap(MatrixMultiplier?._multiply_simd_ptr, A, B);
 }
 
 function multiplyBase(A, B) {
@@ -27,4 +80,16 @@ function multiplySimd(A, B) {
 	return C;
 }
 
-module.exports = { initWasm, multiplyBase, multiplySimd, multiplyWorker, multiplySimdWorker };
\ No newline at end of file
+module.exports = {
+	initWasm,
+	multiplyBase,
+	multiplySimd,
+	multiplyWorker,
+	multiplySimdWorker,
+	multiplyThreads,
+	terminateThreads,
+	hasThreadsBuild,
+	hasHeapExports,
+	multiplyBaseHeap,
+	multiplySimdHeap
+};
\ No newline at end of file
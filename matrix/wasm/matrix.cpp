@@ -1,7 +1,12 @@
 #include <emscripten/bind.h>
+#include <emscripten/emscripten.h>
 #include <vector>
 #include <algorithm>
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    #include <thread>
+#endif
+
 #ifdef __wasm_simd128__
     #include <wasm_simd128.h>
     #define SIMD_AVAILABLE 1
@@ -86,6 +91,168 @@ void multiply_simd(val a, val b, val c, int n) {
 #endif
 }
 
+// ========================== Интерфейс через память модуля ==========================
+// JS пишет матрицы прямо в HEAPF64 (буферы из _malloc), вызов передает только указатели и размеры.
+// Никаких val: время уходит на вычисления, а не на пересечение границы JS <-> WASM на каждый элемент
+
+extern "C" {
+
+// A(m x k), B(k x n) -> C(m x n), все row-major double
+EMSCRIPTEN_KEEPALIVE
+void multiply_base_ptr(const double* A, const double* B, double* C, int m, int k, int n) {
+    for (int i = 0; i < m; ++i) {
+        double* cRow = C + i * n;
+        std::fill(cRow, cRow + n, 0.0);
+
+        // Порядок i-p-j: строка B читается подряд
+        for (int p = 0; p < k; ++p) {
+            const double a = A[i * k + p];
+            const double* bRow = B + p * n;
+            for (int j = 0; j < n; ++j) {
+                cRow[j] += a * bRow[j];
+            }
+        }
+    }
+}
+
+#if SIMD_AVAILABLE
+// acc + a * b: relaxed madd (настоящий FMA там, где он есть), если собрано с -mrelaxed-simd
+static inline v128_t f64x2_madd(v128_t a, v128_t b, v128_t acc) {
+#ifdef __wasm_relaxed_simd__
+    return wasm_f64x2_relaxed_madd(a, b, acc);
+#else
+    return wasm_f64x2_add(acc, wasm_f64x2_mul(a, b));
+#endif
+}
+#endif
+
+// Глубина блока по k: полоса B (KC x 4) остается в L1, пока по ней проходит микроядро
+static const int KC = 256;
+
+// То же в double (без понижения до float32, как в multiply_simd), блочное f64x2 ядро:
+// микроядро 4 x 4 держит 8 аккумуляторов f64x2 в регистрах, на каждый шаг p -
+// 2 загрузки B и 4 splat A на 8 FMA
+EMSCRIPTEN_KEEPALIVE
+void multiply_simd_ptr(const double* A, const double* B, double* C, int m, int k, int n) {
+#if SIMD_AVAILABLE
+    std::fill(C, C + (size_t)m * n, 0.0);
+
+    for (int p0 = 0; p0 < k; p0 += KC) {
+        const int pEnd = std::min(k, p0 + KC);
+
+        int i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const double* a0 = A + (i + 0) * k;
+            const double* a1 = A + (i + 1) * k;
+            const double* a2 = A + (i + 2) * k;
+            const double* a3 = A + (i + 3) * k;
+            double* c0 = C + (i + 0) * n;
+            double* c1 = C + (i + 1) * n;
+            double* c2 = C + (i + 2) * n;
+            double* c3 = C + (i + 3) * n;
+
+            int j = 0;
+            for (; j + 4 <= n; j += 4) {
+                v128_t c00 = wasm_v128_load(c0 + j), c01 = wasm_v128_load(c0 + j + 2);
+                v128_t c10 = wasm_v128_load(c1 + j), c11 = wasm_v128_load(c1 + j + 2);
+                v128_t c20 = wasm_v128_load(c2 + j), c21 = wasm_v128_load(c2 + j + 2);
+                v128_t c30 = wasm_v128_load(c3 + j), c31 = wasm_v128_load(c3 + j + 2);
+
+                for (int p = p0; p < pEnd; ++p) {
+                    const v128_t b0 = wasm_v128_load(B + p * n + j);
+                    const v128_t b1 = wasm_v128_load(B + p * n + j + 2);
+
+                    v128_t a = wasm_f64x2_splat(a0[p]);
+                    c00 = f64x2_madd(a, b0, c00);
+                    c01 = f64x2_madd(a, b1, c01);
+                    a = wasm_f64x2_splat(a1[p]);
+                    c10 = f64x2_madd(a, b0, c10);
+                    c11 = f64x2_madd(a, b1, c11);
+                    a = wasm_f64x2_splat(a2[p]);
+                    c20 = f64x2_madd(a, b0, c20);
+                    c21 = f64x2_madd(a, b1, c21);
+                    a = wasm_f64x2_splat(a3[p]);
+                    c30 = f64x2_madd(a, b0, c30);
+                    c31 = f64x2_madd(a, b1, c31);
+                }
+
+                wasm_v128_store(c0 + j, c00); wasm_v128_store(c0 + j + 2, c01);
+                wasm_v128_store(c1 + j, c10); wasm_v128_store(c1 + j + 2, c11);
+                wasm_v128_store(c2 + j, c20); wasm_v128_store(c2 + j + 2, c21);
+                wasm_v128_store(c3 + j, c30); wasm_v128_store(c3 + j + 2, c31);
+            }
+
+            // Хвост столбцов
+            for (; j < n; ++j) {
+                for (int p = p0; p < pEnd; ++p) {
+                    const double b = B[p * n + j];
+                    c0[j] += a0[p] * b;
+                    c1[j] += a1[p] * b;
+                    c2[j] += a2[p] * b;
+                    c3[j] += a3[p] * b;
+                }
+            }
+        }
+
+        // Хвост строк: по одной строке, f64x2 по столбцам
+        for (; i < m; ++i) {
+            double* cRow = C + i * n;
+            for (int p = p0; p < pEnd; ++p) {
+                const v128_t a = wasm_f64x2_splat(A[i * k + p]);
+                const double* bRow = B + p * n;
+                int j = 0;
+                for (; j + 2 <= n; j += 2) {
+                    wasm_v128_store(cRow + j, f64x2_madd(a, wasm_v128_load(bRow + j), wasm_v128_load(cRow + j)));
+                }
+                for (; j < n; ++j) {
+                    cRow[j] += A[i * k + p] * bRow[j];
+                }
+            }
+        }
+    }
+#else
+    multiply_base_ptr(A, B, C, m, k, n);
+#endif
+}
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+// Меньше строк на поток не делим: запуск потока из пула дороже такого куска работы
+static const int MIN_ROWS_PER_THREAD = 16;
+
+// Только в сборке с -pthread (matrix-threads.mjs): строки A делятся между потоками пула,
+// все потоки читают A и B и пишут свою полосу C прямо в общей памяти модуля (SharedArrayBuffer)
+EMSCRIPTEN_KEEPALIVE
+void multiply_threads_ptr(const double* A, const double* B, double* C, int m, int k, int n, int threads) {
+    const int maxByRows = std::max(1, m / MIN_ROWS_PER_THREAD);
+    threads = std::max(1, std::min({ threads, maxByRows, (int)std::thread::hardware_concurrency() }));
+
+    // Полосы кратны 4 строкам, чтобы хвост микроядра 4 x 4 был только у последней
+    const int rowsPerThread = ((m + threads - 1) / threads + 3) / 4 * 4;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (int t = 1; t < threads; ++t) {
+        const int rowBegin = t * rowsPerThread;
+        const int rows = std::min(m, rowBegin + rowsPerThread) - rowBegin;
+        if (rows <= 0) {
+            break;
+        }
+        workers.emplace_back([=]() {
+            multiply_simd_ptr(A + (size_t)rowBegin * k, B, C + (size_t)rowBegin * n, rows, k, n);
+        });
+    }
+
+    // Первая полоса - на вызывающем потоке
+    multiply_simd_ptr(A, B, C, std::min(m, rowsPerThread), k, n);
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+#endif
+
+}
+
 EMSCRIPTEN_BINDINGS(module) {
     function("multiplyBase", &multiply_base);
     function("multiplySimd", &multiply_simd);
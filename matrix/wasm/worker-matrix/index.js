@@ -1,5 +1,7 @@
 const { Worker } = require('worker_threads');
 const path = require('path');
+const fs = require('fs');
+const os = require('os');
 
 // number[][] -> Float64Array (по аналогии с js-native/worker)
 function flatten2D(arr) {
@@ -85,4 +87,89 @@ async function multiplySimdWorker(A2d, B2d) {
 	});
 }
 
-module.exports = { multiplyWorker, multiplySimdWorker };
\ No newline at end of file
+// ========================== Многопоточная сборка (matrix-threads.mjs) ==========================
+// В отличие от multiplyWorker, воркер не создается на каждый запрос: он живет вместе с процессом,
+// держит загруженный модуль и раздает строки одного умножения по pthread-пулу модуля
+
+const threadsModuleFile = path.resolve(__dirname, '../matrix-threads.mjs');
+
+let threadsWorker = null;
+let nextRequestId = 0;
+const pendingRequests = new Map();
+
+function hasThreadsBuild() {
+	return fs.existsSync(threadsModuleFile);
+}
+
+function rejectPending(error) {
+	for (const { reject } of pendingRequests.values()) {
+		reject(error);
+	}
+	pendingRequests.clear();
+}
+
+function getThreadsWorker() {
+	if (threadsWorker) {
+		return threadsWorker;
+	}
+
+	threadsWorker = new Worker(path.join(__dirname, 'worker-threads.js'));
+	threadsWorker.on('message', ({ id, error, CBuffer, n, m }) => {
+		const request = pendingRequests.get(id);
+		if (!request) {
+			return;
+		}
+		pendingRequests.delete(id);
+		if (pendingRequests.size === 0) {
+			threadsWorker.unref();
+		}
+
+		if (error) {
+			request.reject(new Error(error));
+		} else {
+			request.resolve(unflatten2D(CBuffer, n, m));
+		}
+	});
+	threadsWorker.on('error', (error) => {
+		rejectPending(error);
+		threadsWorker = null;
+	});
+	threadsWorker.on('exit', () => {
+		rejectPending(new Error('WASM threads worker завершился'));
+		threadsWorker = null;
+	});
+	// Простаивающий воркер не держит процесс
+	threadsWorker.unref();
+	return threadsWorker;
+}
+
+async function multiplyThreads(A2d, B2d, threads = os.availableParallelism()) {
+	if (!hasThreadsBuild()) {
+		throw new Error('matrix-threads.mjs не найден, пересоберите: npm run build:wasm');
+	}
+
+	const { flat: A, n: N, k: K } = flatten2D(A2d);
+	const { flat: B, n: K2, k: M } = flatten2D(B2d);
+	if (K2 !== K) {
+		throw new Error('Неподходящие размеры матриц для умножения');
+	}
+
+	const worker = getThreadsWorker();
+	const id = nextRequestId++;
+	return new Promise((resolve, reject) => {
+		pendingRequests.set(id, { resolve, reject });
+		worker.ref();
+		// Запросы выполняются воркером по очереди: каждый и так занимает все ядра
+		worker.postMessage({ id, N, K, M, A: A.buffer, B: B.buffer, threads }, [A.buffer, B.buffer]);
+	});
+}
+
+async function terminateThreads() {
+	if (threadsWorker) {
+		const worker = threadsWorker;
+		threadsWorker = null;
+		await worker.terminate();
+	}
+}
+
+module.exports = { multiplyWorker, multiplySimdWorker, multiplyThreads, terminateThreads, hasThreadsBuild };
\ No newline at end of file
@@ -0,0 +1,37 @@
+const { parentPort } = require('worker_threads');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const { WasmHeapArena } = require('../heap-arena');
+
+// Постоянный воркер для matrix-threads.mjs: модуль и его пул pthread-воркеров загружаются один раз,
+// дальше каждый запрос - только копирование в общую память и вызов multiply_threads_ptr
+const matrixUrl = pathToFileURL(path.resolve(__dirname, '../matrix-threads.mjs')).href;
+
+const wasmReady = (async () => {
+	const { default: init } = await import(matrixUrl);
+	const module = await init();
+	return { module, arena: new WasmHeapArena(module) };
+})();
+
+parentPort.on('message', async ({ id, N, K, M, A, B, threads }) => {
+	try {
+		const { module, arena } = await wasmReady;
+
+		const base = arena.reserve(N * K + K * M + N * M);
+		const aOffset = base;
+		const bOffset = aOffset + N * K;
+		const cOffset = bOffset + K * M;
+
+		arena.heap.set(new Float64Array(A), aOffset);
+		arena.heap.set(new Float64Array(B), bOffset);
+
+		const bytes = Float64Array.BYTES_PER_ELEMENT;
+		module._multiply_threads_ptr(aOffset * bytes, bOffset * bytes, cOffset * bytes, N, K, M, threads);
+
+		// Память модуля общая и переиспользуется следующим запросом - отдаем копию C
+		const Cflat = arena.heap.slice(cOffset, cOffset + N * M);
+		parentPort.postMessage({ id, CBuffer: Cflat.buffer, n: N, m: M }, [Cflat.buffer]);
+	} catch (err) {
+		parentPort.postMessage({ id, error: err?.message || String(err) });
+	}
+});
\ No newline at end of file
@@ -2,6 +2,13 @@
 #include <vector>
 #include <cstring>
 #include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include "buffer_pool.h"
+#include "kernels.h"
+#include "alloc_tracker.h"
 
 Napi::Value SimpleAllocation(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -13,7 +20,11 @@ Napi::Value SimpleAllocation(const Napi::CallbackInfo& info) {
 
     int size = info[0].As<Napi::Number>().Int32Value();
     
-    int* data = new int[size];
+    int* data = TrackedNewArray<int>(size, NATIVE_ALLOC_SITE());
+    if (data == nullptr) {
+        Napi::Error::New(env, "Out of memory").ThrowAsJavaScriptException();
+        return env.Null();
+    }
     
     for (int i = 0; i < size; i++) {
         data[i] = i * i;
@@ -24,7 +35,7 @@ Napi::Value SimpleAllocation(const Napi::CallbackInfo& info) {
         result[i] = Napi::Number::New(env, data[i]);
     }
     
-    delete[] data;
+    TrackedDeleteArray(data);
     
     return result;
 }
@@ -39,7 +50,11 @@ Napi::Value AllocationWithLeak(const Napi::CallbackInfo& info) {
 
     int size = info[0].As<Napi::Number>().Int32Value();
     
-    int* data = new int[size];
+    int* data = TrackedNewArray<int>(size, NATIVE_ALLOC_SITE());
+    if (data == nullptr) {
+        Napi::Error::New(env, "Out of memory").ThrowAsJavaScriptException();
+        return env.Null();
+    }
     
     for (int i = 0; i < size; i++) {
         data[i] = i * i;
@@ -54,35 +69,56 @@ Napi::Value AllocationWithLeak(const Napi::CallbackInfo& info) {
 }
 
 
+// Поддерживаемые ядрами typed arrays: Int32Array, Float32Array, Float64Array
+bool GetKernelTarget(const Napi::Value& value, KernelType& type, void*& data, size_t& length) {
+    if (!value.IsTypedArray()) {
+        return false;
+    }
+    Napi::TypedArray array = value.As<Napi::TypedArray>();
+    switch (array.TypedArrayType()) {
+        case napi_int32_array: type = KernelType::Int32; break;
+        case napi_float32_array: type = KernelType::Float32; break;
+        case napi_float64_array: type = KernelType::Float64; break;
+        default: return false;
+    }
+    data = static_cast<uint8_t*>(array.ArrayBuffer().Data()) + array.ByteOffset();
+    length = array.ElementLength();
+    return true;
+}
+
 Napi::Value ProcessArray(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
 
+    // Оптимизация: Int32Array копируется одним memcpy и удваивается векторным ядром,
+    // без Napi::Value на элемент. Результат - новый Int32Array, вход не меняется
+    if (info.Length() >= 1 && info[0].IsTypedArray() &&
+        info[0].As<Napi::TypedArray>().TypedArrayType() == napi_int32_array) {
+        Napi::Int32Array input = info[0].As<Napi::Int32Array>();
+        size_t length = input.ElementLength();
+        Napi::Int32Array result = Napi::Int32Array::New(env, length);
+        if (length > 0) {
+            std::memcpy(result.Data(), input.Data(), length * sizeof(int32_t));
+        }
+        RunKernel(KernelType::Int32, result.Data(), length, KernelParams{ KernelOp::Scale, 2, 0, 2, 0 });
+        return result;
+    }
+
     if (info.Length() < 1 || !info[0].IsArray()) {
-        Napi::TypeError::New(env, "Array expected").ThrowAsJavaScriptException();
+        Napi::TypeError::New(env, "Array or Int32Array expected").ThrowAsJavaScriptException();
         return env.Null();
     }
 
     Napi::Array input = info[0].As<Napi::Array>();
     uint32_t length = input.Length();
     
-    int* data = new int[length];
-    
-    for (uint32_t i = 0; i < length; i++) {
-        Napi::Value val = input[i];
-        data[i] = val.As<Napi::Number>().Int32Value();
-    }
-    
-    for (uint32_t i = 0; i < length; i++) {
-        data[i] = data[i] * 2;
-    }
-    
+    // Обычный Array читается поэлементно, но без промежуточного new int[]
     Napi::Array result = Napi::Array::New(env, length);
     for (uint32_t i = 0; i < length; i++) {
-        result[i] = Napi::Number::New(env, data[i]);
+        Napi::Value val = input[i];
+        int32_t value = val.As<Napi::Number>().Int32Value();
+        result[i] = Napi::Number::New(env, static_cast<int32_t>(static_cast<uint32_t>(value) * 2u));
     }
     
-    delete[] data;
-    
     return result;
 }
 
@@ -98,15 +134,158 @@ Napi::Value ProcessBuffer(const Napi::CallbackInfo& info) {
     int32_t* data = buffer.Data();
     size_t length = buffer.Length() / sizeof(int32_t);
     
-    for (size_t i = 0; i < length; i++) {
-        data[i] = data[i] * 2;
-    }
+    // Оптимизация: векторное ядро (AVX2/NEON) вместо скалярного цикла
+    RunKernel(KernelType::Int32, data, length, KernelParams{ KernelOp::Scale, 2, 0, 2, 0 });
     
     return Napi::String::New(env, "Buffer processed in-place");
 }
 
+// Числовые аргументы операции начиная с info[first]; для Int32Array они приводятся как ToInt32
+bool ReadKernelParams(const Napi::CallbackInfo& info, size_t first, KernelOp op, KernelParams& params) {
+    Napi::Env env = info.Env();
+    params = KernelParams{ op, 0, 0, 0, 0 };
+
+    size_t arity = KernelOpArity(op);
+    for (size_t i = 0; i < arity; i++) {
+        if (info.Length() <= first + i || !info[first + i].IsNumber()) {
+            Napi::TypeError::New(env, "Number expected").ThrowAsJavaScriptException();
+            return false;
+        }
+    }
+    if (arity > 0) {
+        params.a = info[first].As<Napi::Number>().DoubleValue();
+        params.ia = info[first].As<Napi::Number>().Int32Value();
+    }
+    if (arity > 1) {
+        params.b = info[first + 1].As<Napi::Number>().DoubleValue();
+        params.ib = info[first + 1].As<Napi::Number>().Int32Value();
+    }
+    return true;
+}
+
+// Общая часть scaleArray/addArray/clampArray/mapArray: меняет массив на месте и возвращает его же
+Napi::Value ApplyKernel(const Napi::CallbackInfo& info, KernelOp op, size_t firstArg) {
+    Napi::Env env = info.Env();
+
+    KernelType type;
+    void* data = nullptr;
+    size_t length = 0;
+    if (info.Length() < 1 || !GetKernelTarget(info[0], type, data, length)) {
+        Napi::TypeError::New(env, "Int32Array, Float32Array or Float64Array expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    KernelParams params;
+    if (!ReadKernelParams(info, firstArg, op, params)) {
+        return env.Null();
+    }
+
+    RunKernel(type, data, length, params);
+    return info[0];
+}
+
+bool ReadKernelOp(const Napi::CallbackInfo& info, size_t index, KernelOp& op) {
+    if (info.Length() <= index || !info[index].IsNumber() ||
+        !ParseKernelOp(info[index].As<Napi::Number>().Int32Value(), op)) {
+        Napi::TypeError::New(info.Env(), "Unknown op code (see addon.ops)").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// scaleArray(typedArray, k) -> typedArray
+Napi::Value ScaleArray(const Napi::CallbackInfo& info) { return ApplyKernel(info, KernelOp::Scale, 1); }
+// addArray(typedArray, k) -> typedArray
+Napi::Value AddArray(const Napi::CallbackInfo& info) { return ApplyKernel(info, KernelOp::Add, 1); }
+// clampArray(typedArray, lo, hi) -> typedArray
+Napi::Value ClampArray(const Napi::CallbackInfo& info) { return ApplyKernel(info, KernelOp::Clamp, 1); }
+
+// mapArray(typedArray, op, a?, b?) -> typedArray, op из addon.ops
+Napi::Value MapArray(const Napi::CallbackInfo& info) {
+    KernelOp op;
+    if (!ReadKernelOp(info, 1, op)) {
+        return info.Env().Null();
+    }
+    return ApplyKernel(info, op, 2);
+}
+
+class KernelWorker : public Napi::AsyncWorker {
+public:
+    KernelWorker(Napi::Env env, Napi::TypedArray array, KernelType type, void* data, size_t length,
+                 const KernelParams& params, size_t threads)
+    : Napi::AsyncWorker(env),
+    deferred_(Napi::Promise::Deferred::New(env)),
+    arrayRef_(Napi::Persistent(array)),
+    type_(type),
+    data_(data),
+    length_(length),
+    params_(params),
+    threads_(threads) {}
+
+    Napi::Promise Promise() { return deferred_.Promise(); }
+
+    // Поток пула libuv считает первую полосу, остальные - временные std::thread
+    void Execute() override {
+        RunKernelParallel(type_, data_, length_, params_, threads_);
+    }
+
+    void OnOK() override {
+        Napi::TypedArray array = arrayRef_.Value();
+        arrayRef_.Reset();
+        deferred_.Resolve(array);
+    }
+
+    void OnError(const Napi::Error& e) override {
+        arrayRef_.Reset();
+        deferred_.Reject(e.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    Napi::Reference<Napi::TypedArray> arrayRef_; // держит массив живым, пока потоки пишут в его память
+    KernelType type_;
+    void* data_;
+    size_t length_;
+    KernelParams params_;
+    size_t threads_;
+};
+
+// mapArrayAsync(typedArray, op, a?, b?, { threads }?) -> Promise<typedArray>
+// Большой массив делится на полосы по потокам; массив нельзя трогать, пока Promise не завершился
+Napi::Value MapArrayAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    KernelType type;
+    void* data = nullptr;
+    size_t length = 0;
+    if (info.Length() < 1 || !GetKernelTarget(info[0], type, data, length)) {
+        Napi::TypeError::New(env, "Int32Array, Float32Array or Float64Array expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    KernelOp op;
+    KernelParams params;
+    if (!ReadKernelOp(info, 1, op) || !ReadKernelParams(info, 2, op, params)) {
+        return env.Null();
+    }
+
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t optionsIndex = 2 + KernelOpArity(op);
+    if (info.Length() > optionsIndex && info[optionsIndex].IsObject()) {
+        Napi::Value value = info[optionsIndex].As<Napi::Object>().Get("threads");
+        if (value.IsNumber() && value.As<Napi::Number>().Int32Value() > 0) {
+            threads = value.As<Napi::Number>().Int32Value();
+        }
+    }
+
+    auto* worker = new KernelWorker(env, info[0].As<Napi::TypedArray>(), type, data, length, params, threads);
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
 void FinalizeExternalBuffer(Napi::Env env, int32_t* data) {
-    delete[] data;
+    TrackedDeleteArray(data);
     std::printf("🗑️  Finalizer called: buffer memory freed\n");
 }
 
@@ -120,7 +299,11 @@ Napi::Value CreateExternalBuffer(const Napi::CallbackInfo& info) {
 
     int32_t size = info[0].As<Napi::Number>().Int32Value();
     
-    int32_t* data = new int32_t[size];
+    int32_t* data = TrackedNewArray<int32_t>(size, NATIVE_ALLOC_SITE());
+    if (data == nullptr) {
+        Napi::Error::New(env, "Out of memory").ThrowAsJavaScriptException();
+        return env.Null();
+    }
     
     for (int32_t i = 0; i < size; i++) {
         data[i] = i * 3;
@@ -134,6 +317,186 @@ Napi::Value CreateExternalBuffer(const Napi::CallbackInfo& info) {
     );
 }
 
+// Оптимизация: память буфера берется из BufferPool, финализатор возвращает блок в пул вместо delete[]
+// V8 сам учитывает byteLength external буфера, поэтому через AdjustExternalMemory сообщаем только
+// хвост класса размеров (blockSize - byteLength), иначе живые байты считались бы дважды
+// hint - запрошенный размер в байтах: по нему восстанавливается размер блока без отдельной аллокации
+void FinalizePooledBuffer(Napi::Env env, int32_t* data, void* hint) {
+    size_t bytes = reinterpret_cast<uintptr_t>(hint);
+    size_t blockSize = BufferPool::BlockSize(bytes);
+    BufferPool::Instance().Release(data, blockSize);
+    if (blockSize > bytes) {
+        Napi::MemoryManagement::AdjustExternalMemory(env, -static_cast<int64_t>(blockSize - bytes));
+    }
+}
+
+Napi::Value CreatePooledBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Number expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    int32_t size = info[0].As<Napi::Number>().Int32Value();
+    if (size < 0) {
+        Napi::RangeError::New(env, "Size must be non-negative").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    size_t bytes = static_cast<size_t>(size) * sizeof(int32_t);
+    size_t blockSize = 0;
+    int32_t* data = static_cast<int32_t*>(BufferPool::Instance().Acquire(bytes, blockSize));
+    if (data == nullptr) {
+        Napi::Error::New(env, "Out of memory").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    for (int32_t i = 0; i < size; i++) {
+        data[i] = i * 3;
+    }
+
+    if (blockSize > bytes) {
+        Napi::MemoryManagement::AdjustExternalMemory(env, static_cast<int64_t>(blockSize - bytes));
+    }
+
+    return Napi::Buffer<int32_t>::New(
+        env,
+        data,
+        size,
+        FinalizePooledBuffer,
+        reinterpret_cast<void*>(static_cast<uintptr_t>(bytes))
+    );
+}
+
+// { liveBytes, cachedBytes, maxCachedBytes, hits, misses, hitRate, dropped, trimmedBytes, oversized, classes }
+Napi::Value GetBufferPoolStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    BufferPool::Stats stats = BufferPool::Instance().GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("liveBytes", Napi::Number::New(env, static_cast<double>(stats.liveBytes)));
+    result.Set("cachedBytes", Napi::Number::New(env, static_cast<double>(stats.cachedBytes)));
+    result.Set("maxCachedBytes", Napi::Number::New(env, static_cast<double>(stats.maxCachedBytes)));
+    result.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+    result.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+    uint64_t requests = stats.hits + stats.misses;
+    result.Set("hitRate", Napi::Number::New(env, requests > 0 ? static_cast<double>(stats.hits) / requests : 0.0));
+    result.Set("dropped", Napi::Number::New(env, static_cast<double>(stats.dropped)));
+    result.Set("trimmedBytes", Napi::Number::New(env, static_cast<double>(stats.trimmedBytes)));
+    result.Set("oversized", Napi::Number::New(env, static_cast<double>(stats.oversized)));
+
+    Napi::Array classes = Napi::Array::New(env, stats.classes.size());
+    for (size_t i = 0; i < stats.classes.size(); i++) {
+        Napi::Object item = Napi::Object::New(env);
+        item.Set("blockSize", Napi::Number::New(env, static_cast<double>(stats.classes[i].blockSize)));
+        item.Set("cachedBlocks", Napi::Number::New(env, static_cast<double>(stats.classes[i].cachedBlocks)));
+        item.Set("liveBlocks", Napi::Number::New(env, static_cast<double>(stats.classes[i].liveBlocks)));
+        classes[i] = item;
+    }
+    result.Set("classes", classes);
+    return result;
+}
+
+// trimBufferPool(keepBytes = 0) - отдает системе свободные блоки сверх keepBytes, возвращает освобожденные байты
+Napi::Value TrimBufferPool(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    double keepBytes = 0;
+    if (info.Length() > 0 && info[0].IsNumber()) {
+        keepBytes = info[0].As<Napi::Number>().DoubleValue();
+    }
+    if (keepBytes < 0) {
+        Napi::RangeError::New(env, "keepBytes must be non-negative").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    size_t freed = BufferPool::Instance().Trim(static_cast<size_t>(keepBytes));
+    return Napi::Number::New(env, static_cast<double>(freed));
+}
+
+// configureBufferPool(maxCachedBytes) - лимит кэша свободных блоков, лишнее освобождается сразу
+Napi::Value ConfigureBufferPool(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Number expected").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    double maxCachedBytes = info[0].As<Napi::Number>().DoubleValue();
+    if (maxCachedBytes < 0) {
+        Napi::RangeError::New(env, "maxCachedBytes must be non-negative").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    BufferPool::Instance().SetMaxCachedBytes(static_cast<size_t>(maxCachedBytes));
+    return env.Undefined();
+}
+
+// enableNativeMemoryTracking({ sampleInterval }?) - включает учет аллокаций аддона.
+// sampleInterval - средний шаг выборки по местам вызова в байтах (1 - точно, каждая аллокация)
+Napi::Value EnableNativeMemoryTracking(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    size_t sampleInterval = AllocTracker::kDefaultSampleInterval;
+    if (info.Length() > 0 && info[0].IsObject()) {
+        Napi::Value value = info[0].As<Napi::Object>().Get("sampleInterval");
+        if (!value.IsUndefined()) {
+            if (!value.IsNumber() || value.As<Napi::Number>().DoubleValue() < 1) {
+                Napi::RangeError::New(env, "sampleInterval must be a number >= 1").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            sampleInterval = static_cast<size_t>(value.As<Napi::Number>().DoubleValue());
+        }
+    }
+
+    AllocTracker::Enable(sampleInterval);
+    return env.Undefined();
+}
+
+// Уже учтенные блоки продолжают вычитаться при освобождении
+Napi::Value DisableNativeMemoryTracking(const Napi::CallbackInfo& info) {
+    AllocTracker::Disable();
+    return info.Env().Undefined();
+}
+
+// getNativeMemoryStats() -> { enabled, sampleInterval, liveBytes, liveAllocations, highWaterBytes,
+//   totalAllocations, totalAllocatedBytes, elapsedSeconds, allocationRate, sites: [...] }
+// Общие счетчики точные, поля sites - оценки по выборке
+Napi::Value GetNativeMemoryStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    AllocTrackerStats stats = AllocTracker::GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, stats.enabled));
+    result.Set("sampleInterval", Napi::Number::New(env, static_cast<double>(stats.sampleInterval)));
+    result.Set("liveBytes", Napi::Number::New(env, static_cast<double>(stats.liveBytes)));
+    result.Set("liveAllocations", Napi::Number::New(env, static_cast<double>(stats.liveAllocations)));
+    result.Set("highWaterBytes", Napi::Number::New(env, static_cast<double>(stats.highWaterBytes)));
+    result.Set("totalAllocations", Napi::Number::New(env, static_cast<double>(stats.totalAllocations)));
+    result.Set("totalAllocatedBytes", Napi::Number::New(env, static_cast<double>(stats.totalAllocatedBytes)));
+    result.Set("elapsedSeconds", Napi::Number::New(env, stats.elapsedSeconds));
+    result.Set("allocationRate", Napi::Number::New(env, stats.allocationRate));
+
+    Napi::Array sites = Napi::Array::New(env, stats.sites.size());
+    for (size_t i = 0; i < stats.sites.size(); i++) {
+        const AllocSiteStats& site = stats.sites[i];
+        Napi::Object item = Napi::Object::New(env);
+        item.Set("function", Napi::String::New(env, site.function));
+        item.Set("file", Napi::String::New(env, site.file));
+        item.Set("line", Napi::Number::New(env, site.line));
+        item.Set("sampledAllocations", Napi::Number::New(env, static_cast<double>(site.sampledAllocations)));
+        item.Set("allocations", Napi::Number::New(env, site.allocations));
+        item.Set("liveAllocations", Napi::Number::New(env, site.liveAllocations));
+        item.Set("allocatedBytes", Napi::Number::New(env, site.allocatedBytes));
+        item.Set("liveBytes", Napi::Number::New(env, site.liveBytes));
+        sites[i] = item;
+    }
+    result.Set("sites", sites);
+    return result;
+}
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set(
         Napi::String::New(env, "simpleAllocation"),
@@ -155,6 +518,72 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
         Napi::String::New(env, "createExternalBuffer"),
         Napi::Function::New(env, CreateExternalBuffer)
     );
+    exports.Set(
+        Napi::String::New(env, "createPooledBuffer"),
+        Napi::Function::New(env, CreatePooledBuffer)
+    );
+    exports.Set(
+        Napi::String::New(env, "getBufferPoolStats"),
+        Napi::Function::New(env, GetBufferPoolStats)
+    );
+    exports.Set(
+        Napi::String::New(env, "trimBufferPool"),
+        Napi::Function::New(env, TrimBufferPool)
+    );
+    exports.Set(
+        Napi::String::New(env, "configureBufferPool"),
+        Napi::Function::New(env, ConfigureBufferPool)
+    );
+    exports.Set(
+        Napi::String::New(env, "scaleArray"),
+        Napi::Function::New(env, ScaleArray)
+    );
+    exports.Set(
+        Napi::String::New(env, "addArray"),
+        Napi::Function::New(env, AddArray)
+    );
+    exports.Set(
+        Napi::String::New(env, "clampArray"),
+        Napi::Function::New(env, ClampArray)
+    );
+    exports.Set(
+        Napi::String::New(env, "mapArray"),
+        Napi::Function::New(env, MapArray)
+    );
+    exports.Set(
+        Napi::String::New(env, "mapArrayAsync"),
+        Napi::Function::New(env, MapArrayAsync)
+    );
+
+    Napi::Object ops = Napi::Object::New(env);
+    ops.Set("SCALE", Napi::Number::New(env, static_cast<int32_t>(KernelOp::Scale)));
+    ops.Set("ADD", Napi::Number::New(env, static_cast<int32_t>(KernelOp::Add)));
+    ops.Set("CLAMP", Napi::Number::New(env, static_cast<int32_t>(KernelOp::Clamp)));
+    ops.Set("ABS", Napi::Number::New(env, static_cast<int32_t>(KernelOp::Abs)));
+    exports.Set(Napi::String::New(env, "ops"), ops);
+    exports.Set(Napi::String::New(env, "kernelIsa"), Napi::String::New(env, KernelIsa()));
+    exports.Set(
+        Napi::String::New(env, "enableNativeMemoryTracking"),
+        Napi::Function::New(env, EnableNativeMemoryTracking)
+    );
+    exports.Set(
+        Napi::String::New(env, "disableNativeMemoryTracking"),
+        Napi::Function::New(env, DisableNativeMemoryTracking)
+    );
+    exports.Set(
+        Napi::String::New(env, "getNativeMemoryStats"),
+        Napi::Function::New(env, GetNativeMemoryStats)
+    );
+
+    // NATIVE_MEMORY_TRACKING=1 (или =<sampleInterval>) - включить учет без изменения кода сервиса
+    if (const char* tracking = std::getenv("NATIVE_MEMORY_TRACKING")) {
+        long interval = std::strtol(tracking, nullptr, 10);
+        if (interval > 1) {
+            AllocTracker::Enable(static_cast<size_t>(interval));
+        } else if (interval == 1 || std::strcmp(tracking, "true") == 0) {
+            AllocTracker::Enable();
+        }
+    }
     return exports;
 }
 
@@ -0,0 +1,208 @@
+#include "alloc_tracker.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+
+namespace {
+
+// Заголовок перед блоком: 16 байт сохраняют выравнивание malloc
+struct AllocHeader {
+    uint64_t bytes;
+    uint32_t site;     // kUntracked - выделено при выключенном учете
+    float weight;      // 0 - не в выборке, иначе вес для оценок по месту вызова
+};
+static_assert(sizeof(AllocHeader) == 16, "header must keep 16-byte alignment");
+
+constexpr uint32_t kUntracked = UINT32_MAX;
+
+struct SiteRecord {
+    const char* function;
+    const char* file;
+    int line;
+    uint64_t sampledAllocations = 0;
+    double allocations = 0;
+    double liveAllocations = 0;
+    double allocatedBytes = 0;
+    double liveBytes = 0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<bool> g_enabled{ false };
+std::atomic<size_t> g_sampleInterval{ AllocTracker::kDefaultSampleInterval };
+std::atomic<int64_t> g_liveBytes{ 0 };
+std::atomic<int64_t> g_liveAllocations{ 0 };
+std::atomic<int64_t> g_highWaterBytes{ 0 };
+std::atomic<uint64_t> g_totalAllocations{ 0 };
+std::atomic<uint64_t> g_totalAllocatedBytes{ 0 };
+
+// Таблица мест вызова и окно для allocationRate - под мьютексом, на горячий путь попадает только выборка
+std::mutex g_mutex;
+std::vector<SiteRecord>& Sites() {
+    static std::vector<SiteRecord>* sites = new std::vector<SiteRecord>();
+    return *sites;
+}
+bool g_started = false;
+Clock::time_point g_startTime;
+Clock::time_point g_rateTime;
+uint64_t g_rateBytes = 0;
+
+// Экспоненциальный интервал до следующей выборки (в байтах), свой генератор на поток
+int64_t NextSampleDistance(size_t interval) {
+    if (interval <= 1) {
+        return 0;
+    }
+    thread_local uint64_t state = 0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    const double uniform = (static_cast<double>(state >> 11) + 0.5) / 9007199254740992.0; // (0, 1)
+    return static_cast<int64_t>(-std::log(uniform) * static_cast<double>(interval));
+}
+
+// Вес выборки: вероятность попасть в выборку для блока size байт - 1 - exp(-size / interval)
+float SampleWeight(size_t bytes, size_t interval) {
+    if (interval <= 1) {
+        return 1.0f;
+    }
+    const double probability = 1.0 - std::exp(-static_cast<double>(bytes) / static_cast<double>(interval));
+    return static_cast<float>(1.0 / std::max(probability, 1e-12));
+}
+
+bool ShouldSample(size_t bytes, size_t interval) {
+    thread_local int64_t bytesUntilSample = -1;
+    if (bytesUntilSample < 0) {
+        bytesUntilSample = NextSampleDistance(interval);
+    }
+    bytesUntilSample -= static_cast<int64_t>(bytes);
+    if (bytesUntilSample >= 0) {
+        return false;
+    }
+    bytesUntilSample = NextSampleDistance(interval);
+    return true;
+}
+
+} // namespace
+
+void AllocTracker::Enable(size_t sampleInterval) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_sampleInterval.store(sampleInterval > 0 ? sampleInterval : 1, std::memory_order_relaxed);
+    if (!g_started) {
+        g_started = true;
+        g_startTime = Clock::now();
+        g_rateTime = g_startTime;
+        g_rateBytes = g_totalAllocatedBytes.load(std::memory_order_relaxed);
+    }
+    g_enabled.store(true, std::memory_order_release);
+}
+
+void AllocTracker::Disable() {
+    g_enabled.store(false, std::memory_order_release);
+}
+
+bool AllocTracker::Enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint32_t AllocTracker::RegisterSite(const char* function, const char* file, int line) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    SiteRecord record;
+    record.function = function;
+    record.file = file;
+    record.line = line;
+    Sites().push_back(record);
+    return static_cast<uint32_t>(Sites().size() - 1);
+}
+
+void* AllocTracker::Allocate(size_t bytes, uint32_t site) {
+    if (bytes > SIZE_MAX - sizeof(AllocHeader)) {
+        return nullptr;
+    }
+    AllocHeader* header = static_cast<AllocHeader*>(std::malloc(sizeof(AllocHeader) + bytes));
+    if (header == nullptr) {
+        return nullptr;
+    }
+    header->bytes = bytes;
+    header->site = kUntracked;
+    header->weight = 0.0f;
+
+    if (!g_enabled.load(std::memory_order_relaxed)) {
+        return header + 1;
+    }
+
+    header->site = site;
+    g_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_totalAllocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    g_liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    const int64_t live = g_liveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+    int64_t highWater = g_highWaterBytes.load(std::memory_order_relaxed);
+    while (live > highWater && !g_highWaterBytes.compare_exchange_weak(highWater, live, std::memory_order_relaxed)) {
+    }
+
+    const size_t interval = g_sampleInterval.load(std::memory_order_relaxed);
+    if (ShouldSample(bytes, interval)) {
+        header->weight = SampleWeight(bytes, interval);
+        std::lock_guard<std::mutex> lock(g_mutex);
+        SiteRecord& record = Sites()[site];
+        record.sampledAllocations++;
+        record.allocations += header->weight;
+        record.liveAllocations += header->weight;
+        record.allocatedBytes += header->weight * static_cast<double>(bytes);
+        record.liveBytes += header->weight * static_cast<double>(bytes);
+    }
+    return header + 1;
+}
+
+void AllocTracker::Free(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    AllocHeader* header = static_cast<AllocHeader*>(pointer) - 1;
+
+    // Блок учтен при выделении - вычитаем, даже если учет уже выключен, иначе live только растет
+    if (header->site != kUntracked) {
+        g_liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+        g_liveBytes.fetch_sub(static_cast<int64_t>(header->bytes), std::memory_order_relaxed);
+        if (header->weight > 0.0f) {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            SiteRecord& record = Sites()[header->site];
+            record.liveAllocations -= header->weight;
+            record.liveBytes -= header->weight * static_cast<double>(header->bytes);
+        }
+    }
+    std::free(header);
+}
+
+AllocTrackerStats AllocTracker::GetStats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    AllocTrackerStats stats;
+    stats.enabled = g_enabled.load(std::memory_order_relaxed);
+    stats.sampleInterval = g_sampleInterval.load(std::memory_order_relaxed);
+    stats.liveBytes = g_liveBytes.load(std::memory_order_relaxed);
+    stats.liveAllocations = g_liveAllocations.load(std::memory_order_relaxed);
+    stats.highWaterBytes = g_highWaterBytes.load(std::memory_order_relaxed);
+    stats.totalAllocations = g_totalAllocations.load(std::memory_order_relaxed);
+    stats.totalAllocatedBytes = g_totalAllocatedBytes.load(std::memory_order_relaxed);
+    stats.elapsedSeconds = 0.0;
+    stats.allocationRate = 0.0;
+
+    if (g_started) {
+        const Clock::time_point now = Clock::now();
+        stats.elapsedSeconds = std::chrono::duration<double>(now - g_startTime).count();
+        const double window = std::chrono::duration<double>(now - g_rateTime).count();
+        if (window > 0.0) {
+            stats.allocationRate = static_cast<double>(stats.totalAllocatedBytes - g_rateBytes) / window;
+        }
+        g_rateTime = now;
+        g_rateBytes = stats.totalAllocatedBytes;
+    }
+
+    for (const SiteRecord& record : Sites()) {
+        stats.sites.push_back({ record.function, record.file, record.line, record.sampledAllocations,
+            record.allocations, record.liveAllocations, record.allocatedBytes, record.liveBytes });
+    }
+    return stats;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Учет нативных аллокаций аддона: общие счетчики точные (relaxed atomics),
+// разбивка по местам вызова - по выборке, как в heap profiler'ах: в среднем одна
+// аллокация на sampleInterval байт, оценки масштабируются весом выборки.
+// Выключено по умолчанию: до enable() каждая аллокация стоит одну проверку флага
+// и 16 байт заголовка (в нем размер и место вызова - free не нужен поиск по таблице)
+
+struct AllocSiteStats {
+    const char* function;
+    const char* file;
+    int line;
+    uint64_t sampledAllocations;   // сколько аллокаций попало в выборку
+    double allocations;            // оценка всех аллокаций
+    double liveAllocations;        // оценка живых (не освобожденных)
+    double allocatedBytes;
+    double liveBytes;
+};
+
+struct AllocTrackerStats {
+    bool enabled;
+    size_t sampleInterval;
+    int64_t liveBytes;
+    int64_t liveAllocations;
+    int64_t highWaterBytes;
+    uint64_t totalAllocations;
+    uint64_t totalAllocatedBytes;
+    double elapsedSeconds;        // с момента первого enable()
+    double allocationRate;        // байт/с с предыдущего GetStats (или с enable)
+    std::vector<AllocSiteStats> sites;
+};
+
+class AllocTracker {
+public:
+    static constexpr size_t kDefaultSampleInterval = 512 * 1024;
+
+    // sampleInterval = 1 - учитывать каждую аллокацию точно
+    static void Enable(size_t sampleInterval = kDefaultSampleInterval);
+    static void Disable();
+    static bool Enabled();
+
+    static uint32_t RegisterSite(const char* function, const char* file, int line);
+
+    static void* Allocate(size_t bytes, uint32_t site);
+    static void Free(void* pointer);
+
+    static AllocTrackerStats GetStats();
+};
+
+// Место вызова регистрируется один раз на каждое раскрытие макроса (static в своей лямбде)
+#define NATIVE_ALLOC_SITE() \
+    [](const char* function) { static const uint32_t site = AllocTracker::RegisterSite(function, __FILE__, __LINE__); return site; }(__func__)
+
+// Только для тривиальных типов: конструкторы и деструкторы не вызываются
+template <typename T>
+T* TrackedNewArray(size_t count, uint32_t site) {
+    if (count > SIZE_MAX / sizeof(T)) {
+        return nullptr;
+    }
+    return static_cast<T*>(AllocTracker::Allocate(count * sizeof(T), site));
+}
+
+template <typename T>
+void TrackedDeleteArray(T* pointer) {
+    AllocTracker::Free(pointer);
+}
@@ -2,7 +2,7 @@
   "targets": [
     {
       "target_name": "addon",
-      "sources": ["addon.cpp"],
+      "sources": ["addon.cpp", "buffer_pool.cpp", "kernels.cpp", "alloc_tracker.cpp"],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")"
       ],
@@ -0,0 +1,141 @@
+#include "buffer_pool.h"
+#include <new>
+
+BufferPool& BufferPool::Instance() {
+    // Пул общий для процесса: буферы из worker_threads возвращаются в него же
+    static BufferPool* pool = new BufferPool();
+    return *pool;
+}
+
+BufferPool::~BufferPool() {
+    Trim(0);
+}
+
+size_t BufferPool::ClassSize(size_t bytes) {
+    size_t size = size_t(1) << kMinClassShift;
+    while (size < bytes) {
+        size <<= 1;
+    }
+    return size <= (size_t(1) << kMaxClassShift) ? size : 0;
+}
+
+size_t BufferPool::BlockSize(size_t bytes) {
+    const size_t classSize = ClassSize(bytes);
+    return classSize != 0 ? classSize : (bytes + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+size_t BufferPool::ClassIndex(size_t blockSize) {
+    size_t shift = kMinClassShift;
+    while ((size_t(1) << shift) < blockSize) {
+        ++shift;
+    }
+    return shift - kMinClassShift;
+}
+
+void* BufferPool::AllocateBlock(size_t blockSize) {
+    return ::operator new(blockSize, std::align_val_t(kAlignment), std::nothrow);
+}
+
+void BufferPool::FreeBlock(void* block, size_t) {
+    ::operator delete(block, std::align_val_t(kAlignment));
+}
+
+void* BufferPool::Acquire(size_t bytes, size_t& blockSize) {
+    const size_t classSize = ClassSize(bytes);
+    if (classSize == 0) {
+        // Слишком большие блоки не кэшируем: один такой блок съел бы весь лимит
+        blockSize = BlockSize(bytes);
+        void* block = AllocateBlock(blockSize);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (block) {
+            ++oversized_;
+            liveBytes_ += blockSize;
+        }
+        return block;
+    }
+
+    blockSize = classSize;
+    const size_t index = ClassIndex(classSize);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_[index].empty()) {
+            void* block = free_[index].back();
+            free_[index].pop_back();
+            cachedBytes_ -= classSize;
+            liveBytes_ += classSize;
+            ++live_[index];
+            ++hits_;
+            return block;
+        }
+    }
+
+    // Системный аллокатор - вне блокировки
+    void* block = AllocateBlock(classSize);
+    if (block) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        liveBytes_ += classSize;
+        ++live_[index];
+        ++misses_;
+    }
+    return block;
+}
+
+void BufferPool::Release(void* block, size_t blockSize) {
+    const bool pooled = ClassSize(blockSize) == blockSize;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        liveBytes_ -= blockSize;
+        if (pooled) {
+            const size_t index = ClassIndex(blockSize);
+            --live_[index];
+            if (cachedBytes_ + blockSize <= maxCachedBytes_) {
+                free_[index].push_back(block);
+                cachedBytes_ += blockSize;
+                return;
+            }
+            ++dropped_;
+        }
+    }
+    FreeBlock(block, blockSize);
+}
+
+size_t BufferPool::TrimLocked(size_t maxCachedBytes) {
+    size_t freed = 0;
+    // Сначала крупные классы: меньше вызовов free на тот же объем
+    for (size_t index = kClassCount; index-- > 0 && cachedBytes_ > maxCachedBytes;) {
+        const size_t blockSize = size_t(1) << (index + kMinClassShift);
+        while (!free_[index].empty() && cachedBytes_ > maxCachedBytes) {
+            FreeBlock(free_[index].back(), blockSize);
+            free_[index].pop_back();
+            cachedBytes_ -= blockSize;
+            freed += blockSize;
+        }
+        if (free_[index].empty()) {
+            free_[index].shrink_to_fit();
+        }
+    }
+    trimmedBytes_ += freed;
+    return freed;
+}
+
+size_t BufferPool::Trim(size_t maxCachedBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return TrimLocked(maxCachedBytes);
+}
+
+void BufferPool::SetMaxCachedBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxCachedBytes_ = bytes;
+    TrimLocked(bytes);
+}
+
+BufferPool::Stats BufferPool::GetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats{ liveBytes_, cachedBytes_, maxCachedBytes_, hits_, misses_, dropped_, trimmedBytes_, oversized_, {} };
+    for (size_t index = 0; index < kClassCount; ++index) {
+        if (!free_[index].empty() || live_[index] > 0) {
+            stats.classes.push_back({ size_t(1) << (index + kMinClassShift), free_[index].size(), live_[index] });
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Пул блоков для external буферов по классам размеров (степени двойки от 64 Б до 64 МБ).
+// Финализатор буфера возвращает блок в пул, и следующий буфер того же класса берет его без malloc.
+// Свободные блоки держатся до лимита maxCachedBytes, лишние сразу отдаются системе, trim() чистит кэш
+class BufferPool {
+public:
+    static constexpr size_t kMinClassShift = 6;   // 64 Б
+    static constexpr size_t kMaxClassShift = 26;  // 64 МБ, больше - мимо пула
+    static constexpr size_t kClassCount = kMaxClassShift - kMinClassShift + 1;
+    static constexpr size_t kAlignment = 64;      // под AVX/NEON и без false sharing
+
+    struct ClassStats {
+        size_t blockSize;
+        size_t cachedBlocks;
+        size_t liveBlocks;
+    };
+
+    struct Stats {
+        size_t liveBytes;        // выдано и еще не возвращено (по размеру класса)
+        size_t cachedBytes;      // свободные блоки в пуле
+        size_t maxCachedBytes;
+        uint64_t hits;           // выдано из кэша
+        uint64_t misses;         // пришлось выделять у системы
+        uint64_t dropped;        // возвращено системе при release из-за лимита
+        uint64_t trimmedBytes;   // всего освобождено через trim
+        uint64_t oversized;      // запросы больше максимального класса
+        std::vector<ClassStats> classes;
+    };
+
+    static BufferPool& Instance();
+
+    // Блок не меньше bytes; blockSize - фактический размер (его и нужно вернуть в Release)
+    void* Acquire(size_t bytes, size_t& blockSize);
+    void Release(void* block, size_t blockSize);
+
+    // Освобождает кэш до maxCachedBytes байт (0 - весь), возвращает сколько освобождено
+    size_t Trim(size_t maxCachedBytes = 0);
+
+    void SetMaxCachedBytes(size_t bytes);
+    Stats GetStats();
+
+    // Размер класса для bytes, 0 если больше максимального класса
+    static size_t ClassSize(size_t bytes);
+    // Фактический размер блока, который Acquire выделит под bytes
+    static size_t BlockSize(size_t bytes);
+
+private:
+    BufferPool() = default;
+    ~BufferPool();
+
+    static size_t ClassIndex(size_t blockSize);
+    static void* AllocateBlock(size_t blockSize);
+    static void FreeBlock(void* block, size_t blockSize);
+    size_t TrimLocked(size_t maxCachedBytes);
+
+    std::mutex mutex_;
+    std::vector<void*> free_[kClassCount];
+    size_t live_[kClassCount] = {};
+    size_t liveBytes_ = 0;
+    size_t cachedBytes_ = 0;
+    size_t maxCachedBytes_ = 64 * 1024 * 1024;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t trimmedBytes_ = 0;
+    uint64_t oversized_ = 0;
+};
@@ -0,0 +1,48 @@
+const addon = require('../build/Release/addon');
+const { formatMemory } = require('./utils');
+
+const SIZE = 1000000;
+const LARGE_SIZE = 16 * 1000000;
+const REPEATS = 50;
+
+function measure(label, fn) {
+    fn(); // разогрев
+    const start = process.hrtime.bigint();
+    for (let i = 0; i < REPEATS; i++) {
+        fn();
+    }
+    const ms = Number(process.hrtime.bigint() - start) / 1e6 / REPEATS;
+    console.log(`${label.padEnd(40)} ${ms.toFixed(3).padStart(9)} ms`);
+    return ms;
+}
+
+console.log(`=== In-place ядра для typed arrays (${addon.kernelIsa}) ===`);
+
+console.log('\nprocessArray: Array vs Int32Array');
+const array = new Array(SIZE).fill(0).map((_, i) => i);
+const int32 = Int32Array.from(array);
+measure('processArray(Array)', () => addon.processArray(array));
+measure('processArray(Int32Array) - fast path', () => addon.processArray(int32));
+
+console.log('\nscale x2, Float32Array');
+const floats = new Float32Array(SIZE).map((_, i) => i);
+measure('JS цикл', () => {
+    for (let i = 0; i < floats.length; i++) {
+        floats[i] *= 2;
+    }
+});
+measure('scaleArray', () => addon.scaleArray(floats, 2));
+measure('mapArray(ops.CLAMP)', () => addon.mapArray(floats, addon.ops.CLAMP, -1000, 1000));
+
+(async () => {
+    console.log(`\nmapArrayAsync, Float64Array ${LARGE_SIZE / 1e6}M (${(LARGE_SIZE * 8 / 1024 / 1024).toFixed(0)} MB)`);
+    const large = new Float64Array(LARGE_SIZE).fill(1.5);
+    for (const threads of [1, 2, 4, 8]) {
+        const start = process.hrtime.bigint();
+        await addon.mapArrayAsync(large, addon.ops.SCALE, 1.0001, { threads });
+        const ms = Number(process.hrtime.bigint() - start) / 1e6;
+        console.log(`${`threads=${threads}`.padEnd(40)} ${ms.toFixed(3).padStart(9)} ms`);
+    }
+
+    console.log('\nAfter:', formatMemory(process.memoryUsage()));
+})();
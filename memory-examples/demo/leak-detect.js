@@ -0,0 +1,79 @@
+const path = require('path');
+const addon = require('../build/Release/addon');
+
+const SIZE = 1000000;
+const CALLS = 50;
+// Рост живой памяти места вызова больше порога после GC считаем утечкой
+const LEAK_THRESHOLD_BYTES = 1024 * 1024;
+
+function formatBytes(bytes) {
+    return `${(bytes / 1024 / 1024).toFixed(2)} MB`;
+}
+
+function gcTwice() {
+    // Два GC: финализаторы external буферов вызываются между циклами (см. demo/gc.js)
+    if (global.gc) {
+        global.gc();
+        global.gc();
+    }
+}
+
+function siteKey(site) {
+    return `${site.function} (${path.basename(site.file)}:${site.line})`;
+}
+
+function snapshotSites() {
+    const stats = addon.getNativeMemoryStats();
+    return { stats, sites: new Map(stats.sites.map(site => [siteKey(site), site])) };
+}
+
+console.log('=== Native Memory Tracking (поиск утечки) ===');
+
+// Выборка по умолчанию (512 КБ) - режим, который можно держать включенным в проде
+addon.enableNativeMemoryTracking();
+
+// Разогрев: места вызова регистрируются при первом вызове
+addon.simpleAllocation(SIZE);
+gcTwice();
+const before = snapshotSites();
+
+for (let i = 0; i < CALLS; i++) {
+    addon.simpleAllocation(SIZE);
+    addon.allocationWithLeak(SIZE);
+}
+gcTwice();
+const after = snapshotSites();
+
+console.log(`\nПосле ${CALLS} вызовов каждой функции и GC:`);
+console.log({
+    liveBytes: formatBytes(after.stats.liveBytes),
+    highWaterBytes: formatBytes(after.stats.highWaterBytes),
+    totalAllocations: after.stats.totalAllocations,
+    allocationRate: `${formatBytes(after.stats.allocationRate)}/s`,
+});
+
+console.log('\nМеста вызова (оценки по выборке):');
+const leaks = [];
+for (const [key, site] of after.sites) {
+    const baseline = before.sites.get(key);
+    const growth = site.liveBytes - (baseline ? baseline.liveBytes : 0);
+    const leaked = growth > LEAK_THRESHOLD_BYTES;
+    console.log(
+        `${leaked ? '🔴' : '🟢'} ${key.padEnd(40)} выделено ${formatBytes(site.allocatedBytes).padStart(10)}` +
+        `   живых ${formatBytes(site.liveBytes).padStart(10)}   в выборке ${site.sampledAllocations}`
+    );
+    if (leaked) {
+        leaks.push({ key, growth });
+    }
+}
+
+console.log('');
+if (leaks.length === 0) {
+    console.log('✅ Утечек не найдено');
+} else {
+    for (const leak of leaks) {
+        console.log(`❌ Утечка: ${leak.key} +${formatBytes(leak.growth)} за ${CALLS} вызовов (~${(leak.growth / CALLS / 1024).toFixed(0)} KB на вызов)`);
+    }
+    // Ненулевой код выхода - демо можно запускать как проверку в CI
+    process.exitCode = 1;
+}
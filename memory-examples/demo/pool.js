@@ -0,0 +1,46 @@
+const addon = require('../build/Release/addon');
+const { formatMemory } = require('./utils');
+
+const ROUNDS = 40;
+const BUFFERS_PER_ROUND = 50;
+// Размеры в int32: от 4 КБ до 4 МБ, как у короткоживущих буферов сервиса
+const SIZES = [1000, 10000, 100000, 1000000];
+
+function formatPoolStats(stats) {
+    return {
+        liveBytes: `${(stats.liveBytes / 1024 / 1024).toFixed(2)} MB`,
+        cachedBytes: `${(stats.cachedBytes / 1024 / 1024).toFixed(2)} MB`,
+        hits: stats.hits,
+        misses: stats.misses,
+        hitRate: `${(stats.hitRate * 100).toFixed(1)}%`,
+        dropped: stats.dropped,
+    };
+}
+
+console.log('=== Pooled External Buffer (блоки переиспользуются после финализатора) ===');
+addon.configureBufferPool(128 * 1024 * 1024);
+console.log('Before:', formatMemory(process.memoryUsage()));
+
+const start = process.hrtime.bigint();
+for (let round = 0; round < ROUNDS; round++) {
+    let buffers = [];
+    for (let i = 0; i < BUFFERS_PER_ROUND; i++) {
+        buffers.push(addon.createPooledBuffer(SIZES[i % SIZES.length]));
+    }
+    buffers = null;
+    // Два GC: первый помечает буферы, второй вызывает финализаторы (см. demo/gc.js)
+    if (global.gc) {
+        global.gc();
+        global.gc();
+    }
+}
+const elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+
+console.log(`After ${ROUNDS * BUFFERS_PER_ROUND} buffers (${elapsedMs.toFixed(1)} ms):`, formatMemory(process.memoryUsage()));
+console.log('Pool:', formatPoolStats(addon.getBufferPoolStats()));
+console.log('Classes:', addon.getBufferPoolStats().classes);
+
+const freed = addon.trimBufferPool();
+console.log(`\nTrim: freed ${(freed / 1024 / 1024).toFixed(2)} MB`);
+console.log('After trim:', formatMemory(process.memoryUsage()));
+console.log('Pool:', formatPoolStats(addon.getBufferPoolStats()));
@@ -0,0 +1,290 @@
+#include "kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define KERNELS_AVX2 1
+    #include <immintrin.h>
+    // Ядро компилируется под AVX2 без -mavx2 для всего модуля, выбор - по CPU в рантайме
+    #define KERNEL_TARGET __attribute__((target("avx2")))
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define KERNELS_NEON 1
+    #include <arm_neon.h>
+    #define KERNEL_TARGET
+#endif
+
+namespace {
+
+// ==================== Скалярный путь (хвосты и fallback) ====================
+
+inline int32_t Mul(int32_t x, int32_t k) { return static_cast<int32_t>(static_cast<uint32_t>(x) * static_cast<uint32_t>(k)); }
+inline float Mul(float x, float k) { return x * k; }
+inline double Mul(double x, double k) { return x * k; }
+
+inline int32_t Add(int32_t x, int32_t k) { return static_cast<int32_t>(static_cast<uint32_t>(x) + static_cast<uint32_t>(k)); }
+inline float Add(float x, float k) { return x + k; }
+inline double Add(double x, double k) { return x + k; }
+
+// INT32_MIN остается INT32_MIN, как в векторных abs
+inline int32_t Abs(int32_t x) { return x < 0 ? static_cast<int32_t>(0u - static_cast<uint32_t>(x)) : x; }
+inline float Abs(float x) { return std::fabs(x); }
+inline double Abs(double x) { return std::fabs(x); }
+
+// NaN проходит насквозь; векторные версии повторяют этот порядок сравнений
+template <typename T>
+inline T Clamp(T x, T lo, T hi) { return std::min(std::max(x, lo), hi); }
+
+template <typename T>
+void ScalarKernel(T* data, size_t length, KernelOp op, T a, T b) {
+    switch (op) {
+        case KernelOp::Scale:
+            for (size_t i = 0; i < length; i++) data[i] = Mul(data[i], a);
+            break;
+        case KernelOp::Add:
+            for (size_t i = 0; i < length; i++) data[i] = Add(data[i], a);
+            break;
+        case KernelOp::Clamp:
+            for (size_t i = 0; i < length; i++) data[i] = Clamp(data[i], a, b);
+            break;
+        case KernelOp::Abs:
+            for (size_t i = 0; i < length; i++) data[i] = Abs(data[i]);
+            break;
+    }
+}
+
+// ==================== Векторные операции по ISA ====================
+// Max(x, lo) == std::max(x, lo), Min(x, hi) == std::min(x, hi) вплоть до NaN и знака нуля
+
+#ifdef KERNELS_AVX2
+template <typename T> struct Vec;
+
+template <> struct Vec<int32_t> {
+    using V = __m256i;
+    static constexpr size_t kWidth = 8;
+    KERNEL_TARGET static V Load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    KERNEL_TARGET static void Store(int32_t* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    KERNEL_TARGET static V Set(int32_t x) { return _mm256_set1_epi32(x); }
+    KERNEL_TARGET static V Mul(V x, V k) { return _mm256_mullo_epi32(x, k); }
+    KERNEL_TARGET static V Add(V x, V k) { return _mm256_add_epi32(x, k); }
+    KERNEL_TARGET static V Max(V x, V lo) { return _mm256_max_epi32(x, lo); }
+    KERNEL_TARGET static V Min(V x, V hi) { return _mm256_min_epi32(x, hi); }
+    KERNEL_TARGET static V Abs(V x) { return _mm256_abs_epi32(x); }
+};
+
+template <> struct Vec<float> {
+    using V = __m256;
+    static constexpr size_t kWidth = 8;
+    KERNEL_TARGET static V Load(const float* p) { return _mm256_loadu_ps(p); }
+    KERNEL_TARGET static void Store(float* p, V v) { _mm256_storeu_ps(p, v); }
+    KERNEL_TARGET static V Set(float x) { return _mm256_set1_ps(x); }
+    KERNEL_TARGET static V Mul(V x, V k) { return _mm256_mul_ps(x, k); }
+    KERNEL_TARGET static V Add(V x, V k) { return _mm256_add_ps(x, k); }
+    // maxps(a, b) = a > b ? a : b - поэтому граница первым операндом
+    KERNEL_TARGET static V Max(V x, V lo) { return _mm256_max_ps(lo, x); }
+    KERNEL_TARGET static V Min(V x, V hi) { return _mm256_min_ps(hi, x); }
+    KERNEL_TARGET static V Abs(V x) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x); }
+};
+
+template <> struct Vec<double> {
+    using V = __m256d;
+    static constexpr size_t kWidth = 4;
+    KERNEL_TARGET static V Load(const double* p) { return _mm256_loadu_pd(p); }
+    KERNEL_TARGET static void Store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    KERNEL_TARGET static V Set(double x) { return _mm256_set1_pd(x); }
+    KERNEL_TARGET static V Mul(V x, V k) { return _mm256_mul_pd(x, k); }
+    KERNEL_TARGET static V Add(V x, V k) { return _mm256_add_pd(x, k); }
+    KERNEL_TARGET static V Max(V x, V lo) { return _mm256_max_pd(lo, x); }
+    KERNEL_TARGET static V Min(V x, V hi) { return _mm256_min_pd(hi, x); }
+    KERNEL_TARGET static V Abs(V x) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x); }
+};
+
+bool HasVectorPath() {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+#endif
+
+#ifdef KERNELS_NEON
+template <typename T> struct Vec;
+
+template <> struct Vec<int32_t> {
+    using V = int32x4_t;
+    static constexpr size_t kWidth = 4;
+    static V Load(const int32_t* p) { return vld1q_s32(p); }
+    static void Store(int32_t* p, V v) { vst1q_s32(p, v); }
+    static V Set(int32_t x) { return vdupq_n_s32(x); }
+    static V Mul(V x, V k) { return vmulq_s32(x, k); }
+    static V Add(V x, V k) { return vaddq_s32(x, k); }
+    static V Max(V x, V lo) { return vmaxq_s32(x, lo); }
+    static V Min(V x, V hi) { return vminq_s32(x, hi); }
+    static V Abs(V x) { return vabsq_s32(x); }
+};
+
+// vmaxq/vminq по-своему обрабатывают NaN и -0, поэтому сравнение + выбор, как в std::max/std::min
+template <> struct Vec<float> {
+    using V = float32x4_t;
+    static constexpr size_t kWidth = 4;
+    static V Load(const float* p) { return vld1q_f32(p); }
+    static void Store(float* p, V v) { vst1q_f32(p, v); }
+    static V Set(float x) { return vdupq_n_f32(x); }
+    static V Mul(V x, V k) { return vmulq_f32(x, k); }
+    static V Add(V x, V k) { return vaddq_f32(x, k); }
+    static V Max(V x, V lo) { return vbslq_f32(vcltq_f32(x, lo), lo, x); }
+    static V Min(V x, V hi) { return vbslq_f32(vcltq_f32(hi, x), hi, x); }
+    static V Abs(V x) { return vabsq_f32(x); }
+};
+
+template <> struct Vec<double> {
+    using V = float64x2_t;
+    static constexpr size_t kWidth = 2;
+    static V Load(const double* p) { return vld1q_f64(p); }
+    static void Store(double* p, V v) { vst1q_f64(p, v); }
+    static V Set(double x) { return vdupq_n_f64(x); }
+    static V Mul(V x, V k) { return vmulq_f64(x, k); }
+    static V Add(V x, V k) { return vaddq_f64(x, k); }
+    static V Max(V x, V lo) { return vbslq_f64(vcltq_f64(x, lo), lo, x); }
+    static V Min(V x, V hi) { return vbslq_f64(vcltq_f64(hi, x), hi, x); }
+    static V Abs(V x) { return vabsq_f64(x); }
+};
+
+// NEON входит в базовый ARMv8-A
+bool HasVectorPath() { return true; }
+#endif
+
+#if defined(KERNELS_AVX2) || defined(KERNELS_NEON)
+// Оптимизация: два вектора за итерацию - два независимых load/op/store, хвост скалярно
+template <typename T>
+KERNEL_TARGET void VectorKernel(T* data, size_t length, KernelOp op, T a, T b) {
+    using Ops = Vec<T>;
+    constexpr size_t kStep = Ops::kWidth * 2;
+    const size_t vectorEnd = length - length % kStep;
+    size_t i = 0;
+
+    switch (op) {
+        case KernelOp::Scale: {
+            const typename Ops::V k = Ops::Set(a);
+            for (; i < vectorEnd; i += kStep) {
+                Ops::Store(data + i, Ops::Mul(Ops::Load(data + i), k));
+                Ops::Store(data + i + Ops::kWidth, Ops::Mul(Ops::Load(data + i + Ops::kWidth), k));
+            }
+            break;
+        }
+        case KernelOp::Add: {
+            const typename Ops::V k = Ops::Set(a);
+            for (; i < vectorEnd; i += kStep) {
+                Ops::Store(data + i, Ops::Add(Ops::Load(data + i), k));
+                Ops::Store(data + i + Ops::kWidth, Ops::Add(Ops::Load(data + i + Ops::kWidth), k));
+            }
+            break;
+        }
+        case KernelOp::Clamp: {
+            const typename Ops::V lo = Ops::Set(a);
+            const typename Ops::V hi = Ops::Set(b);
+            for (; i < vectorEnd; i += kStep) {
+                Ops::Store(data + i, Ops::Min(Ops::Max(Ops::Load(data + i), lo), hi));
+                Ops::Store(data + i + Ops::kWidth, Ops::Min(Ops::Max(Ops::Load(data + i + Ops::kWidth), lo), hi));
+            }
+            break;
+        }
+        case KernelOp::Abs:
+            for (; i < vectorEnd; i += kStep) {
+                Ops::Store(data + i, Ops::Abs(Ops::Load(data + i)));
+                Ops::Store(data + i + Ops::kWidth, Ops::Abs(Ops::Load(data + i + Ops::kWidth)));
+            }
+            break;
+    }
+
+    ScalarKernel(data + i, length - i, op, a, b);
+}
+#endif
+
+template <typename T>
+void RunTyped(T* data, size_t length, KernelOp op, T a, T b) {
+#if defined(KERNELS_AVX2) || defined(KERNELS_NEON)
+    if (HasVectorPath()) {
+        VectorKernel(data, length, op, a, b);
+        return;
+    }
+#endif
+    ScalarKernel(data, length, op, a, b);
+}
+
+size_t ElementSize(KernelType type) {
+    return type == KernelType::Float64 ? sizeof(double) : sizeof(int32_t);
+}
+
+} // namespace
+
+bool ParseKernelOp(int32_t code, KernelOp& op) {
+    if (code < static_cast<int32_t>(KernelOp::Scale) || code > static_cast<int32_t>(KernelOp::Abs)) {
+        return false;
+    }
+    op = static_cast<KernelOp>(code);
+    return true;
+}
+
+size_t KernelOpArity(KernelOp op) {
+    switch (op) {
+        case KernelOp::Scale:
+        case KernelOp::Add:
+            return 1;
+        case KernelOp::Clamp:
+            return 2;
+        case KernelOp::Abs:
+            return 0;
+    }
+    return 0;
+}
+
+void RunKernel(KernelType type, void* data, size_t length, const KernelParams& params) {
+    switch (type) {
+        case KernelType::Int32:
+            RunTyped(static_cast<int32_t*>(data), length, params.op, params.ia, params.ib);
+            break;
+        case KernelType::Float32:
+            RunTyped(static_cast<float*>(data), length, params.op, static_cast<float>(params.a), static_cast<float>(params.b));
+            break;
+        case KernelType::Float64:
+            RunTyped(static_cast<double*>(data), length, params.op, params.a, params.b);
+            break;
+    }
+}
+
+void RunKernelParallel(KernelType type, void* data, size_t length, const KernelParams& params, size_t threads) {
+    const size_t elementSize = ElementSize(type);
+    const size_t lineElements = 64 / elementSize;
+    threads = std::max<size_t>(1, std::min(threads, length / kMinElementsPerThread));
+    if (threads == 1) {
+        RunKernel(type, data, length, params);
+        return;
+    }
+
+    // Полоса кратна строке кэша: соседние потоки не пишут в одну линию
+    size_t band = (length + threads - 1) / threads;
+    band = (band + lineElements - 1) / lineElements * lineElements;
+
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    // Первая полоса - в текущем потоке, остальные - в дополнительных
+    for (size_t begin = band; begin < length; begin += band) {
+        const size_t count = std::min(band, length - begin);
+        workers.emplace_back(RunKernel, type, bytes + begin * elementSize, count, params);
+    }
+    RunKernel(type, data, std::min(band, length), params);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+const char* KernelIsa() {
+#if defined(KERNELS_AVX2)
+    return HasVectorPath() ? "avx2" : "scalar";
+#elif defined(KERNELS_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Поэлементные in-place ядра для typed arrays: AVX2 (с проверкой CPU в рантайме), NEON на arm64,
+// иначе скалярный цикл. Int32 считается по модулю 2^32, как Math.imul и | 0 в JS
+enum class KernelOp : int32_t {
+    Scale = 0,  // x * a
+    Add = 1,    // x + a
+    Clamp = 2,  // min(max(x, a), b)
+    Abs = 3,    // |x|
+};
+
+enum class KernelType {
+    Int32,
+    Float32,
+    Float64,
+};
+
+// a/b - для Float32/Float64, ia/ib - те же аргументы после ToInt32 для Int32
+struct KernelParams {
+    KernelOp op;
+    double a;
+    double b;
+    int32_t ia;
+    int32_t ib;
+};
+
+bool ParseKernelOp(int32_t code, KernelOp& op);
+// Сколько числовых аргументов нужно операции
+size_t KernelOpArity(KernelOp op);
+
+void RunKernel(KernelType type, void* data, size_t length, const KernelParams& params);
+
+// Делит массив на полосы по потокам (границы по 64 байта, без false sharing).
+// Массивы меньше kMinElementsPerThread на поток считаются в текущем потоке
+constexpr size_t kMinElementsPerThread = 1 << 16;
+void RunKernelParallel(KernelType type, void* data, size_t length, const KernelParams& params, size_t threads);
+
+// "avx2", "neon" или "scalar" - какой путь выбран на этой машине
+const char* KernelIsa();
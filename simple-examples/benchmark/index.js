@@ -0,0 +1,118 @@
+const path = require('path');
+
+// Стоимость одного вызова hash(string) для каждого способа биндинга.
+// Запуск: node benchmark [--lengths 1,8,32,128,1024] [--calls 2000000] [--repeats 5]
+// Перед запуском соберите нужные примеры (npm run build в их папках), несобранные пропускаются
+
+const VARIANTS = ['native-libs', 'native-libs-fast-api', 'nan', 'napi', 'node-addon-api'];
+const KEYS_PER_LENGTH = 1024; // разные строки, чтобы не мерить один и тот же закешированный вызов
+
+function parseArgs() {
+    const options = { lengths: [1, 8, 32, 128, 1024], calls: 2_000_000, repeats: 5 };
+    const args = process.argv.slice(2);
+    for (let i = 0; i < args.length; i++) {
+        switch (args[i]) {
+            case '--lengths':
+                options.lengths = args[++i].split(',').map(Number);
+                break;
+            case '--calls':
+                options.calls = parseInt(args[++i], 10);
+                break;
+            case '--repeats':
+                options.repeats = parseInt(args[++i], 10);
+                break;
+        }
+    }
+    return options;
+}
+
+function loadVariants() {
+    const loaded = [];
+    for (const name of VARIANTS) {
+        try {
+            const addon = require(path.join(__dirname, '..', name, 'build', 'Release', 'hasher.node'));
+            loaded.push({ name, addon });
+        } catch {
+            console.warn(`⚠️ ${name}: не собран, пропускаем (cd ${name} && npm run build)`);
+        }
+    }
+    return loaded;
+}
+
+function generateKeys(length) {
+    const alphabet = 'abcdefghijklmnopqrstuvwxyz0123456789';
+    return Array.from({ length: KEYS_PER_LENGTH }, () => {
+        let key = '';
+        for (let i = 0; i < length; i++) {
+            key += alphabet[Math.floor(Math.random() * alphabet.length)];
+        }
+        return key;
+    });
+}
+
+// Отдельная функция-цикл на каждый вариант: у общего цикла точка вызова стала бы полиморфной,
+// и TurboFan не смог бы заинлайнить вызов (а для Fast API - подставить прямой вызов C-функции)
+function createLoop() {
+    return new Function('hash', 'keys', 'calls', `
+        let sink = 0;
+        const mask = keys.length - 1;
+        for (let i = 0; i < calls; i++) {
+            sink += hash(keys[i & mask]);
+        }
+        return sink;
+    `);
+}
+
+function measure(loop, hash, keys, calls, repeats) {
+    // Прогрев: интерпретатор -> baseline -> TurboFan
+    loop(hash, keys, Math.min(calls, 200_000));
+
+    const samples = [];
+    for (let r = 0; r < repeats; r++) {
+        const start = process.hrtime.bigint();
+        loop(hash, keys, calls);
+        samples.push(Number(process.hrtime.bigint() - start) / calls);
+    }
+    samples.sort((a, b) => a - b);
+    return samples[Math.floor(samples.length / 2)];
+}
+
+function checkResults(variants, keys) {
+    const [reference, ...others] = variants;
+    for (const { name, addon } of others) {
+        for (const key of keys.slice(0, 16)) {
+            if (addon.hash(key) !== reference.addon.hash(key)) {
+                throw new Error(`${name}: хеш "${key}" отличается от ${reference.name}`);
+            }
+        }
+    }
+}
+
+function main() {
+    const options = parseArgs();
+    const variants = loadVariants();
+    if (variants.length === 0) {
+        console.error('❌ Ни один пример не собран');
+        process.exit(1);
+    }
+
+    console.log(`\n⏱️  ns на вызов hash(string), медиана из ${options.repeats} прогонов по ${options.calls} вызовов\n`);
+    console.log('Длина'.padEnd(8) + variants.map(v => v.name.padStart(22)).join(''));
+
+    for (const length of options.lengths) {
+        const keys = generateKeys(length);
+        checkResults(variants, keys);
+
+        // Длинные строки считаются дольше - уменьшаем число вызовов, чтобы прогон занимал сопоставимое время
+        const calls = Math.max(10_000, Math.floor(options.calls / Math.max(1, length / 32)));
+        const row = variants.map(({ addon }) => measure(createLoop(), addon.hash, keys, calls, options.repeats));
+        console.log(String(length).padEnd(8) + row.map(ns => ns.toFixed(1).padStart(22)).join(''));
+    }
+
+    const fast = variants.find(v => v.name === 'native-libs-fast-api');
+    if (fast) {
+        console.log(`\n⚡ native-libs-fast-api: Fast API ${fast.addon.fastApi ? 'включен' : 'недоступен в заголовках этой версии Node'}, быстрых вызовов: ${fast.addon.getFastCallCount()}`);
+    }
+}
+
+main();
\ No newline at end of file
@@ -0,0 +1,354 @@
+#pragma once
+
+// Общие хеш-функции для всех примеров hasher: сами примеры отличаются только способом биндинга,
+// поэтому алгоритмы лежат в одном месте и подключаются через include_dirs в binding.gyp
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+#endif
+
+// DJB2 по длине, а не до '\0': так же работает для ключей внутри Buffer.
+// Для строк без нулевых байтов совпадает с djb2_hash(const char*) из hasher.cpp, включая знак char
+// у байтов не-ASCII символов
+inline unsigned long djb2_hash_bytes(const uint8_t* data, size_t len) {
+    unsigned long hash = 5381;
+    for (size_t i = 0; i < len; ++i) {
+        hash = ((hash << 5) + hash) + static_cast<char>(data[i]);
+    }
+    return hash;
+}
+
+// ========================== wyhash (final4) ==========================
+// 64-битный хеш: 16-48 байт за шаг через умножение 64x64 -> 128, без побайтового цикла и зависимостей
+// между байтами. SIMD ему не нужен: одно умножение mulx дает больше перемешивания, чем векторные сдвиги
+
+namespace wyhash_detail {
+
+static const uint64_t kSecret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+inline void Mum(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    // Переносимый 64x64 -> 128 через половинки
+    const uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    const uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline uint64_t Mix(uint64_t a, uint64_t b) {
+    Mum(&a, &b);
+    return a ^ b;
+}
+
+// Чтения через memcpy: ключи в Buffer не выровнены. Порядок байтов little-endian (x64, arm64)
+inline uint64_t Read8(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t Read4(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline uint64_t Read3(const uint8_t* p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+}
+
+inline uint64_t wyhash64(const void* key, size_t len, uint64_t seed = 0) {
+    using namespace wyhash_detail;
+    const uint8_t* p = static_cast<const uint8_t*>(key);
+    seed ^= Mix(seed ^ kSecret[0], kSecret[1]);
+
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (Read4(p) << 32) | Read4(p + ((len >> 3) << 2));
+            b = (Read4(p + len - 4) << 32) | Read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = Read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            // Три независимые цепочки: умножения идут параллельно на конвейере
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+                see1 = Mix(Read8(p + 16) ^ kSecret[2], Read8(p + 24) ^ see1);
+                see2 = Mix(Read8(p + 32) ^ kSecret[3], Read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = Read8(p + i - 16);
+        b = Read8(p + i - 8);
+    }
+
+    a ^= kSecret[1];
+    b ^= seed;
+    Mum(&a, &b);
+    return Mix(a ^ kSecret[0] ^ len, b ^ kSecret[1]);
+}
+
+// Алгоритм для hashMany/hashBuffer: djb2 -> Float64Array (как hash), wyhash -> BigUint64Array
+enum class HashAlgorithm { Djb2, Wyhash };
+
+inline bool ParseHashAlgorithm(const char* name, HashAlgorithm& out) {
+    if (std::strcmp(name, "djb2") == 0) {
+        out = HashAlgorithm::Djb2;
+        return true;
+    }
+    if (std::strcmp(name, "wyhash") == 0) {
+        out = HashAlgorithm::Wyhash;
+        return true;
+    }
+    return false;
+}
+
+// Хеширует count ключей, упакованных подряд: ключ i - байты [offsets[i], offsets[i + 1]).
+// out - double* для djb2 или uint64_t* для wyhash. false, если offsets выходят за буфер или убывают
+inline bool HashPacked(HashAlgorithm algorithm, const uint8_t* data, size_t dataLen,
+                       const uint32_t* offsets, size_t count, void* out) {
+    for (size_t i = 0; i < count; ++i) {
+        if (offsets[i] > offsets[i + 1] || offsets[i + 1] > dataLen) {
+            return false;
+        }
+    }
+
+    if (algorithm == HashAlgorithm::Djb2) {
+        double* dst = static_cast<double*>(out);
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<double>(djb2_hash_bytes(data + offsets[i], offsets[i + 1] - offsets[i]));
+        }
+    } else {
+        uint64_t* dst = static_cast<uint64_t*>(out);
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = wyhash64(data + offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    }
+    return true;
+}
+
+// ========================== Потоковое хеширование ==========================
+// Состояние между update: результат совпадает с djb2_hash_bytes / wyhash64 от склеенного входа,
+// независимо от того, как он порезан на чанки
+
+// wyhash по частям. Блок в 48 байт съедается, только когда за ним пришел хотя бы еще один байт:
+// wyhash64 оставляет последний полный блок хвосту (i > 48), поэтому он ждет в буфере до digest.
+// Финальному шагу нужны последние 16 байт уже съеденных данных, поэтому они хранятся перед буфером хвоста
+class Wyhash64Stream {
+public:
+    explicit Wyhash64Stream(uint64_t seed = 0) { Reset(seed); }
+
+    void Reset(uint64_t seed = 0) {
+        using namespace wyhash_detail;
+        seed_ = seed ^ Mix(seed ^ kSecret[0], kSecret[1]);
+        see1_ = see2_ = seed_;
+        total_ = 0;
+        pending_ = 0;
+    }
+
+    void Update(const void* data, size_t len) {
+        if (len == 0) {
+            return;
+        }
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        total_ += len;
+
+        // Сначала дополняем накопленный хвост до блока
+        if (pending_ > 0) {
+            const size_t take = std::min(len, kBlock - pending_);
+            std::memcpy(buffer_ + kHistory + pending_, p, take);
+            pending_ += take;
+            p += take;
+            len -= take;
+            if (len == 0) {
+                // Полный блок может оказаться последним - съедим его только со следующими байтами
+                return;
+            }
+            ConsumeBlock(buffer_ + kHistory);
+            pending_ = 0;
+        }
+
+        // Большие чанки - прямо из памяти вызывающего, без копирования; последний блок остается в буфере
+        while (len > kBlock) {
+            ConsumeBlock(p);
+            p += kBlock;
+            len -= kBlock;
+        }
+
+        std::memcpy(buffer_ + kHistory, p, len);
+        pending_ = len;
+    }
+
+    // Не меняет состояние: можно продолжить update и снова вызвать digest
+    uint64_t Digest() const {
+        using namespace wyhash_detail;
+        const uint8_t* p = buffer_ + kHistory;
+        if (total_ <= 16) {
+            // Блоков не было, весь вход в буфере - обычный wyhash с тем же seed
+            return Finish(p, total_, seed_, total_);
+        }
+
+        uint64_t seed = seed_;
+        if (total_ > kBlock) {
+            seed ^= see1_ ^ see2_;
+        }
+        size_t i = pending_;
+        while (i > 16) {
+            seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        // p + i - 16 может заходить в историю перед буфером - там последние байты съеденного блока
+        return Mix2(Read8(p + i - 16), Read8(p + i - 8), seed, total_);
+    }
+
+private:
+    static const size_t kBlock = 48;
+    static const size_t kHistory = 16;
+
+    void ConsumeBlock(const uint8_t* p) {
+        using namespace wyhash_detail;
+        seed_ = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed_);
+        see1_ = Mix(Read8(p + 16) ^ kSecret[2], Read8(p + 24) ^ see1_);
+        see2_ = Mix(Read8(p + 32) ^ kSecret[3], Read8(p + 40) ^ see2_);
+        std::memcpy(buffer_, p + kBlock - kHistory, kHistory);
+    }
+
+    // Ветка len <= 16 из wyhash64 для уже смешанного seed
+    static uint64_t Finish(const uint8_t* p, size_t len, uint64_t seed, uint64_t total) {
+        using namespace wyhash_detail;
+        uint64_t a, b;
+        if (len >= 4) {
+            a = (Read4(p) << 32) | Read4(p + ((len >> 3) << 2));
+            b = (Read4(p + len - 4) << 32) | Read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = Read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+        return Mix2(a, b, seed, total);
+    }
+
+    static uint64_t Mix2(uint64_t a, uint64_t b, uint64_t seed, uint64_t total) {
+        using namespace wyhash_detail;
+        a ^= kSecret[1];
+        b ^= seed;
+        Mum(&a, &b);
+        return Mix(a ^ kSecret[0] ^ total, b ^ kSecret[1]);
+    }
+
+    uint64_t seed_, see1_, see2_;
+    uint64_t total_;
+    size_t pending_;
+    uint8_t buffer_[kHistory + kBlock] = {};
+};
+
+// djb2 по частям: состояние - сам хеш
+class Djb2Stream {
+public:
+    void Reset() { hash_ = 5381; }
+
+    void Update(const void* data, size_t len) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        unsigned long hash = hash_;
+        for (size_t i = 0; i < len; ++i) {
+            hash = ((hash << 5) + hash) + static_cast<char>(p[i]);
+        }
+        hash_ = hash;
+    }
+
+    unsigned long Digest() const { return hash_; }
+
+private:
+    unsigned long hash_ = 5381;
+};
+
+// Состояние объекта Hasher во всех примерах: алгоритм выбирается в конструкторе
+struct StreamingHasher {
+    HashAlgorithm algorithm = HashAlgorithm::Djb2;
+    Djb2Stream djb2;
+    Wyhash64Stream wyhash;
+
+    void Update(const void* data, size_t len) {
+        if (algorithm == HashAlgorithm::Djb2) {
+            djb2.Update(data, len);
+        } else {
+            wyhash.Update(data, len);
+        }
+    }
+
+    void Reset() {
+        djb2.Reset();
+        wyhash.Reset();
+    }
+};
+
+// ========================== Древовидный хеш ==========================
+// Вход режется на чанки фиксированного размера, лист i = wyhash64(чанк i, seed = i), дальше листья
+// попарно сворачиваются снизу вверх (нечетный последний поднимается на уровень как есть), корень
+// смешивается с длиной входа. Порядок свертки задан структурой дерева, а не потоками, которые
+// считали листья, поэтому результат один и тот же при любом числе потоков и для синхронного пути
+
+static const size_t kTreeHashChunk = 1 << 20;
+
+inline size_t TreeHashLeafCount(size_t len) {
+    return len == 0 ? 1 : (len + kTreeHashChunk - 1) / kTreeHashChunk;
+}
+
+inline uint64_t TreeHashLeaf(const uint8_t* data, size_t len, size_t index) {
+    const size_t begin = index * kTreeHashChunk;
+    const size_t size = std::min(kTreeHashChunk, len - begin);
+    return wyhash64(data + begin, size, index);
+}
+
+inline uint64_t TreeHashRoot(std::vector<uint64_t> level, uint64_t totalLength) {
+    while (level.size() > 1) {
+        size_t out = 0;
+        for (size_t i = 0; i + 1 < level.size(); i += 2) {
+            const uint64_t pair[2] = { level[i], level[i + 1] };
+            level[out++] = wyhash64(pair, sizeof(pair));
+        }
+        if (level.size() % 2 == 1) {
+            level[out++] = level.back();
+        }
+        level.resize(out);
+    }
+    const uint64_t root[2] = { level[0], totalLength };
+    return wyhash64(root, sizeof(root));
+}
@@ -2,7 +2,8 @@
   "targets": [
     { 
       "include_dirs" : [
-        "<!@(node -p \"require('nan').include\")"
+        "<!@(node -p \"require('nan').include\")",
+        "../common"
       ],
       "target_name": "hasher",
       "sources": [ "hasher.cpp" ]
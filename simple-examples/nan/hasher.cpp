@@ -1,5 +1,6 @@
 #include <nan.h>
 #include <string>
+#include "hash.h"
 
 unsigned long djb2_hash(const char* str) {
     unsigned long hash = 5381;
@@ -27,8 +28,184 @@ NAN_METHOD(hash) {
     info.GetReturnValue().Set(Nan::New<v8::Number>(hash_result));
 }
 
+// Необязательный аргумент алгоритма: 'djb2' (по умолчанию) или 'wyhash'
+static bool ReadAlgorithm(const Nan::FunctionCallbackInfo<v8::Value>& info, int index, HashAlgorithm& algorithm) {
+    algorithm = HashAlgorithm::Djb2;
+    if (info.Length() <= index || info[index]->IsUndefined()) {
+        return true;
+    }
+    if (!info[index]->IsString() || !ParseHashAlgorithm(*Nan::Utf8String(info[index]), algorithm)) {
+        Nan::ThrowTypeError("Алгоритм должен быть 'djb2' или 'wyhash'");
+        return false;
+    }
+    return true;
+}
+
+// Результат под алгоритм: Float64Array для djb2 (как hash), BigUint64Array для wyhash
+static v8::Local<v8::TypedArray> CreateResult(HashAlgorithm algorithm, size_t count, void** data) {
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), count * 8);
+    *data = buffer->GetBackingStore()->Data();
+    if (algorithm == HashAlgorithm::Djb2) {
+        return v8::Float64Array::New(buffer, 0, count);
+    }
+    return v8::BigUint64Array::New(buffer, 0, count);
+}
+
+// hash64(string) -> bigint (wyhash)
+NAN_METHOD(hash64) {
+    if (info.Length() < 1 || !info[0]->IsString()) {
+        Nan::ThrowTypeError("Аргумент должен быть строкой");
+        return;
+    }
+    
+    Nan::Utf8String input(info[0]);
+    uint64_t hash_result = wyhash64(*input, input.length());
+    
+    info.GetReturnValue().Set(v8::BigInt::NewFromUnsigned(info.GetIsolate(), hash_result));
+}
+
+// hashMany(strings[], algorithm?) - один вызов на весь массив.
+// Nan::Utf8String держит до 1 КБ на стеке, так что короткие ключи не выделяют память
+NAN_METHOD(hashMany) {
+    if (info.Length() < 1 || !info[0]->IsArray()) {
+        Nan::ThrowTypeError("Первый аргумент должен быть массивом строк");
+        return;
+    }
+    
+    HashAlgorithm algorithm;
+    if (!ReadAlgorithm(info, 1, algorithm)) {
+        return;
+    }
+    
+    v8::Local<v8::Array> strings = info[0].As<v8::Array>();
+    const uint32_t count = strings->Length();
+    void* out;
+    v8::Local<v8::TypedArray> result = CreateResult(algorithm, count, &out);
+    
+    for (uint32_t i = 0; i < count; ++i) {
+        v8::Local<v8::Value> item = Nan::Get(strings, i).ToLocalChecked();
+        if (!item->IsString()) {
+            Nan::ThrowTypeError("Все элементы массива должны быть строками");
+            return;
+        }
+        
+        Nan::Utf8String input(item);
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(*input);
+        if (algorithm == HashAlgorithm::Djb2) {
+            static_cast<double*>(out)[i] = static_cast<double>(djb2_hash_bytes(bytes, input.length()));
+        } else {
+            static_cast<uint64_t*>(out)[i] = wyhash64(bytes, input.length());
+        }
+    }
+    
+    info.GetReturnValue().Set(result);
+}
+
+// hashBuffer(buffer, offsets, algorithm?) - ключи упакованы в один Buffer, offsets (Uint32Array, count + 1)
+// задают границы. Хешируем прямо по памяти Buffer, без копий и без строк
+NAN_METHOD(hashBuffer) {
+    if (info.Length() < 2 || !node::Buffer::HasInstance(info[0]) || !info[1]->IsUint32Array()) {
+        Nan::ThrowTypeError("Ожидается Buffer и Uint32Array смещений");
+        return;
+    }
+    
+    HashAlgorithm algorithm;
+    if (!ReadAlgorithm(info, 2, algorithm)) {
+        return;
+    }
+    
+    Nan::TypedArrayContents<uint32_t> offsets(info[1]);
+    const size_t count = offsets.length() > 0 ? offsets.length() - 1 : 0;
+    void* out;
+    v8::Local<v8::TypedArray> result = CreateResult(algorithm, count, &out);
+    
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(node::Buffer::Data(info[0]));
+    if (!HashPacked(algorithm, data, node::Buffer::Length(info[0]), *offsets, count, out)) {
+        Nan::ThrowRangeError("Смещения должны не убывать и не выходить за Buffer");
+        return;
+    }
+    
+    info.GetReturnValue().Set(result);
+}
+
+// new Hasher(algorithm?) - потоковое хеширование: update(Buffer | string) по чанкам, digest() в конце.
+// Состояние живет в нативном объекте, вход целиком в памяти не нужен
+class Hasher : public Nan::ObjectWrap {
+public:
+    static NAN_MODULE_INIT(Init) {
+        v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(New);
+        tpl->SetClassName(Nan::New("Hasher").ToLocalChecked());
+        tpl->InstanceTemplate()->SetInternalFieldCount(1);
+        
+        Nan::SetPrototypeMethod(tpl, "update", Update);
+        Nan::SetPrototypeMethod(tpl, "digest", Digest);
+        Nan::SetPrototypeMethod(tpl, "reset", Reset);
+        
+        Nan::Set(target, Nan::New("Hasher").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
+    }
+    
+private:
+    static NAN_METHOD(New) {
+        if (!info.IsConstructCall()) {
+            Nan::ThrowTypeError("Hasher нужно создавать через new");
+            return;
+        }
+        
+        HashAlgorithm algorithm;
+        if (!ReadAlgorithm(info, 0, algorithm)) {
+            return;
+        }
+        
+        Hasher* hasher = new Hasher();
+        hasher->state_.algorithm = algorithm;
+        hasher->Wrap(info.This());
+        info.GetReturnValue().Set(info.This());
+    }
+    
+    // update(Buffer | string) -> this. Buffer хешируется прямо из своей памяти
+    static NAN_METHOD(Update) {
+        Hasher* hasher = Nan::ObjectWrap::Unwrap<Hasher>(info.This());
+        
+        if (info.Length() >= 1 && node::Buffer::HasInstance(info[0])) {
+            hasher->state_.Update(node::Buffer::Data(info[0]), node::Buffer::Length(info[0]));
+        } else if (info.Length() >= 1 && info[0]->IsString()) {
+            Nan::Utf8String input(info[0]);
+            hasher->state_.Update(*input, input.length());
+        } else {
+            Nan::ThrowTypeError("Аргумент должен быть Buffer или строкой");
+            return;
+        }
+        
+        info.GetReturnValue().Set(info.This());
+    }
+    
+    // digest() -> number (djb2) | bigint (wyhash). Состояние не сбрасывается
+    static NAN_METHOD(Digest) {
+        Hasher* hasher = Nan::ObjectWrap::Unwrap<Hasher>(info.This());
+        
+        if (hasher->state_.algorithm == HashAlgorithm::Djb2) {
+            info.GetReturnValue().Set(Nan::New<v8::Number>(hasher->state_.djb2.Digest()));
+        } else {
+            info.GetReturnValue().Set(v8::BigInt::NewFromUnsigned(info.GetIsolate(), hasher->state_.wyhash.Digest()));
+        }
+    }
+    
+    // reset() -> this, чтобы переиспользовать объект для следующего входа
+    static NAN_METHOD(Reset) {
+        Hasher* hasher = Nan::ObjectWrap::Unwrap<Hasher>(info.This());
+        hasher->state_.Reset();
+        info.GetReturnValue().Set(info.This());
+    }
+    
+    StreamingHasher state_;
+};
+
 NAN_MODULE_INIT(Init) {
+    Hasher::Init(target);
     NAN_EXPORT(target, hash);
+    NAN_EXPORT(target, hash64);
+    NAN_EXPORT(target, hashMany);
+    NAN_EXPORT(target, hashBuffer);
 }
 
 NODE_MODULE(hasher, Init)
\ No newline at end of file
@@ -1,13 +1,30 @@
 #include <node_api.h>
 #include <string>
+#include <vector>
+#include "hash.h"
 
-unsigned long djb2_hash(const char* str) {
-    unsigned long hash = 5381;
-    int c;
-    while ((c = *str++)) {
-        hash = ((hash << 5) + hash) + c;
+// N-API обрезает строку по границе символа, а символ UTF-8 занимает до 4 байт: копия полная,
+// только если после нее в буфере осталось место еще под один такой символ и завершающий ноль
+static bool CopiedWhole(size_t copied, size_t capacity) {
+    return copied + 4 < capacity;
+}
+
+// UTF-8 байты строки в переиспользуемый буфер: второй вызов с запросом длины - только если строка не влезла
+static napi_status ReadUtf8(napi_env env, napi_value value, std::vector<char>& scratch, size_t* length) {
+    if (scratch.size() < 256) {
+        scratch.resize(256);
+    }
+    napi_status status = napi_get_value_string_utf8(env, value, scratch.data(), scratch.size(), length);
+    if (status != napi_ok || CopiedWhole(*length, scratch.size())) {
+        return status;
     }
-    return hash;
+    
+    status = napi_get_value_string_utf8(env, value, nullptr, 0, length);
+    if (status != napi_ok) {
+        return status;
+    }
+    scratch.resize(*length + 1);
+    return napi_get_value_string_utf8(env, value, scratch.data(), scratch.size(), length);
 }
 
 napi_value Hash(napi_env env, napi_callback_info info) {
@@ -39,42 +56,357 @@ napi_value Hash(napi_env env, napi_callback_info info) {
         return nullptr;
     }
     
-    size_t str_size;
-    status = napi_get_value_string_utf8(env, argv[0], nullptr, 0, &str_size);
+    // Оптимизация: N-API не отдает указатель на байты строки, но короткие ключи копируются в буфер на стеке
+    // за один вызов - без new[] и без отдельного запроса длины. В кучу уходят только длинные строки
+    char stack_buffer[256];
+    size_t copied;
+    status = napi_get_value_string_utf8(env, argv[0], stack_buffer, sizeof(stack_buffer), &copied);
+    if (status != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка получения строки");
+        return nullptr;
+    }
+    
+    unsigned long hash_result;
+    if (CopiedWhole(copied, sizeof(stack_buffer))) {
+        hash_result = djb2_hash_bytes(reinterpret_cast<const uint8_t*>(stack_buffer), copied);
+    } else {
+        std::vector<char> input;
+        status = ReadUtf8(env, argv[0], input, &copied);
+        if (status != napi_ok) {
+            napi_throw_error(env, nullptr, "Ошибка получения строки");
+            return nullptr;
+        }
+        hash_result = djb2_hash_bytes(reinterpret_cast<const uint8_t*>(input.data()), copied);
+    }
+    
+    status = napi_create_double(env, static_cast<double>(hash_result), &result);
     if (status != napi_ok) {
-        napi_throw_error(env, nullptr, "Ошибка получения размера строки");
+        napi_throw_error(env, nullptr, "Ошибка создания результата");
         return nullptr;
     }
     
-    char* input = new char[str_size + 1];
+    return result;
+}
+
+// Необязательный аргумент алгоритма: 'djb2' (по умолчанию) или 'wyhash'
+static bool ReadAlgorithm(napi_env env, size_t argc, napi_value* argv, size_t index, HashAlgorithm* algorithm) {
+    *algorithm = HashAlgorithm::Djb2;
+    if (argc <= index) {
+        return true;
+    }
+    
+    napi_valuetype valuetype;
+    if (napi_typeof(env, argv[index], &valuetype) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка проверки типа");
+        return false;
+    }
+    if (valuetype == napi_undefined) {
+        return true;
+    }
+    
+    char name[16];
     size_t copied;
-    status = napi_get_value_string_utf8(env, argv[0], input, str_size + 1, &copied);
+    if (valuetype != napi_string ||
+        napi_get_value_string_utf8(env, argv[index], name, sizeof(name), &copied) != napi_ok ||
+        !ParseHashAlgorithm(name, *algorithm)) {
+        napi_throw_type_error(env, nullptr, "Алгоритм должен быть 'djb2' или 'wyhash'");
+        return false;
+    }
+    return true;
+}
+
+// Результат под алгоритм: Float64Array для djb2 (как hash), BigUint64Array для wyhash
+static napi_status CreateResult(napi_env env, HashAlgorithm algorithm, size_t count, void** data, napi_value* result) {
+    napi_value arraybuffer;
+    napi_status status = napi_create_arraybuffer(env, count * 8, data, &arraybuffer);
     if (status != napi_ok) {
-        delete[] input;
+        return status;
+    }
+    
+    napi_typedarray_type type = algorithm == HashAlgorithm::Djb2 ? napi_float64_array : napi_biguint64_array;
+    return napi_create_typedarray(env, type, count, arraybuffer, 0, result);
+}
+
+// hash64(string) -> bigint (wyhash)
+napi_value Hash64(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    if (napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка получения аргументов");
+        return nullptr;
+    }
+    
+    napi_valuetype valuetype = napi_undefined;
+    if (argc < 1 || napi_typeof(env, argv[0], &valuetype) != napi_ok || valuetype != napi_string) {
+        napi_throw_type_error(env, nullptr, "Аргумент должен быть строкой");
+        return nullptr;
+    }
+    
+    std::vector<char> input;
+    size_t length;
+    if (ReadUtf8(env, argv[0], input, &length) != napi_ok) {
         napi_throw_error(env, nullptr, "Ошибка получения строки");
         return nullptr;
     }
     
-    unsigned long hash_result = djb2_hash(input);
-    delete[] input;
+    napi_value result;
+    if (napi_create_bigint_uint64(env, wyhash64(input.data(), length), &result) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка создания результата");
+        return nullptr;
+    }
+    return result;
+}
+
+// hashMany(strings[], algorithm?) - один вызов на весь массив, буфер под UTF-8 общий для всех строк
+napi_value HashMany(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    if (napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка получения аргументов");
+        return nullptr;
+    }
     
-    status = napi_create_double(env, static_cast<double>(hash_result), &result);
-    if (status != napi_ok) {
+    bool is_array = false;
+    if (argc < 1 || napi_is_array(env, argv[0], &is_array) != napi_ok || !is_array) {
+        napi_throw_type_error(env, nullptr, "Первый аргумент должен быть массивом строк");
+        return nullptr;
+    }
+    
+    HashAlgorithm algorithm;
+    if (!ReadAlgorithm(env, argc, argv, 1, &algorithm)) {
+        return nullptr;
+    }
+    
+    uint32_t count;
+    if (napi_get_array_length(env, argv[0], &count) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка получения длины массива");
+        return nullptr;
+    }
+    
+    void* out;
+    napi_value result;
+    if (CreateResult(env, algorithm, count, &out, &result) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка создания результата");
+        return nullptr;
+    }
+    
+    std::vector<char> scratch;
+    for (uint32_t i = 0; i < count; ++i) {
+        napi_value item;
+        napi_valuetype valuetype = napi_undefined;
+        size_t length;
+        if (napi_get_element(env, argv[0], i, &item) != napi_ok ||
+            napi_typeof(env, item, &valuetype) != napi_ok || valuetype != napi_string ||
+            ReadUtf8(env, item, scratch, &length) != napi_ok) {
+            napi_throw_type_error(env, nullptr, "Все элементы массива должны быть строками");
+            return nullptr;
+        }
+        
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(scratch.data());
+        if (algorithm == HashAlgorithm::Djb2) {
+            static_cast<double*>(out)[i] = static_cast<double>(djb2_hash_bytes(bytes, length));
+        } else {
+            static_cast<uint64_t*>(out)[i] = wyhash64(bytes, length);
+        }
+    }
+    
+    return result;
+}
+
+// hashBuffer(buffer, offsets, algorithm?) - ключи упакованы в один Buffer, offsets (Uint32Array, count + 1)
+// задают границы. Хешируем прямо по памяти Buffer, без копий и без строк
+napi_value HashBuffer(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    if (napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка получения аргументов");
+        return nullptr;
+    }
+    
+    bool is_buffer = false;
+    bool is_typedarray = false;
+    if (argc < 2 ||
+        napi_is_buffer(env, argv[0], &is_buffer) != napi_ok || !is_buffer ||
+        napi_is_typedarray(env, argv[1], &is_typedarray) != napi_ok || !is_typedarray) {
+        napi_throw_type_error(env, nullptr, "Ожидается Buffer и Uint32Array смещений");
+        return nullptr;
+    }
+    
+    void* data;
+    size_t data_length;
+    if (napi_get_buffer_info(env, argv[0], &data, &data_length) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка получения Buffer");
+        return nullptr;
+    }
+    
+    napi_typedarray_type type;
+    size_t offsets_length;
+    void* offsets;
+    if (napi_get_typedarray_info(env, argv[1], &type, &offsets_length, &offsets, nullptr, nullptr) != napi_ok ||
+        type != napi_uint32_array) {
+        napi_throw_type_error(env, nullptr, "Ожидается Buffer и Uint32Array смещений");
+        return nullptr;
+    }
+    
+    HashAlgorithm algorithm;
+    if (!ReadAlgorithm(env, argc, argv, 2, &algorithm)) {
+        return nullptr;
+    }
+    
+    const size_t count = offsets_length > 0 ? offsets_length - 1 : 0;
+    void* out;
+    napi_value result;
+    if (CreateResult(env, algorithm, count, &out, &result) != napi_ok) {
         napi_throw_error(env, nullptr, "Ошибка создания результата");
         return nullptr;
     }
     
+    if (!HashPacked(algorithm, static_cast<const uint8_t*>(data), data_length, static_cast<const uint32_t*>(offsets), count, out)) {
+        napi_throw_range_error(env, nullptr, "Смещения должны не убывать и не выходить за Buffer");
+        return nullptr;
+    }
+    return result;
+}
+
+// ========================== Hasher ==========================
+// new Hasher(algorithm?) - потоковое хеширование: update(Buffer | string) по чанкам, digest() в конце.
+// Состояние живет в нативном объекте, вход целиком в памяти не нужен
+
+struct HasherObject {
+    StreamingHasher state;
+    std::vector<char> scratch; // UTF-8 для строковых чанков, переиспользуется между update
+};
+
+static void HasherFinalize(napi_env env, void* data, void* hint) {
+    delete static_cast<HasherObject*>(data);
+}
+
+static HasherObject* UnwrapHasher(napi_env env, napi_callback_info info, size_t* argc, napi_value* argv, napi_value* self) {
+    HasherObject* hasher = nullptr;
+    if (napi_get_cb_info(env, info, argc, argv, self, nullptr) != napi_ok ||
+        napi_unwrap(env, *self, reinterpret_cast<void**>(&hasher)) != napi_ok) {
+        napi_throw_error(env, nullptr, "Метод нужно вызывать на объекте Hasher");
+        return nullptr;
+    }
+    return hasher;
+}
+
+napi_value HasherConstructor(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_value self;
+    if (napi_get_cb_info(env, info, &argc, argv, &self, nullptr) != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка получения аргументов");
+        return nullptr;
+    }
+    
+    HashAlgorithm algorithm;
+    if (!ReadAlgorithm(env, argc, argv, 0, &algorithm)) {
+        return nullptr;
+    }
+    
+    HasherObject* hasher = new HasherObject();
+    hasher->state.algorithm = algorithm;
+    if (napi_wrap(env, self, hasher, HasherFinalize, nullptr, nullptr) != napi_ok) {
+        delete hasher;
+        napi_throw_error(env, nullptr, "Ошибка создания Hasher");
+        return nullptr;
+    }
+    return self;
+}
+
+// update(Buffer | string) -> this. Buffer хешируется прямо из своей памяти
+napi_value HasherUpdate(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    napi_value self;
+    HasherObject* hasher = UnwrapHasher(env, info, &argc, argv, &self);
+    if (!hasher) {
+        return nullptr;
+    }
+    
+    bool is_buffer = false;
+    napi_valuetype valuetype = napi_undefined;
+    if (argc < 1 || napi_is_buffer(env, argv[0], &is_buffer) != napi_ok || napi_typeof(env, argv[0], &valuetype) != napi_ok ||
+        (!is_buffer && valuetype != napi_string)) {
+        napi_throw_type_error(env, nullptr, "Аргумент должен быть Buffer или строкой");
+        return nullptr;
+    }
+    
+    if (is_buffer) {
+        void* data;
+        size_t length;
+        if (napi_get_buffer_info(env, argv[0], &data, &length) != napi_ok) {
+            napi_throw_error(env, nullptr, "Ошибка получения Buffer");
+            return nullptr;
+        }
+        hasher->state.Update(data, length);
+    } else {
+        size_t length;
+        if (ReadUtf8(env, argv[0], hasher->scratch, &length) != napi_ok) {
+            napi_throw_error(env, nullptr, "Ошибка получения строки");
+            return nullptr;
+        }
+        hasher->state.Update(hasher->scratch.data(), length);
+    }
+    
+    return self;
+}
+
+// digest() -> number (djb2) | bigint (wyhash). Состояние не сбрасывается
+napi_value HasherDigest(napi_env env, napi_callback_info info) {
+    size_t argc = 0;
+    napi_value self;
+    HasherObject* hasher = UnwrapHasher(env, info, &argc, nullptr, &self);
+    if (!hasher) {
+        return nullptr;
+    }
+    
+    napi_value result;
+    napi_status status = hasher->state.algorithm == HashAlgorithm::Djb2
+        ? napi_create_double(env, static_cast<double>(hasher->state.djb2.Digest()), &result)
+        : napi_create_bigint_uint64(env, hasher->state.wyhash.Digest(), &result);
+    if (status != napi_ok) {
+        napi_throw_error(env, nullptr, "Ошибка создания результата");
+        return nullptr;
+    }
     return result;
 }
 
+// reset() -> this, чтобы переиспользовать объект для следующего входа
+napi_value HasherReset(napi_env env, napi_callback_info info) {
+    size_t argc = 0;
+    napi_value self;
+    HasherObject* hasher = UnwrapHasher(env, info, &argc, nullptr, &self);
+    if (!hasher) {
+        return nullptr;
+    }
+    
+    hasher->state.Reset();
+    return self;
+}
+
 napi_value Init(napi_env env, napi_value exports) {
-    napi_status status;
-    napi_value fn;
+    napi_property_descriptor hasher_methods[] = {
+        { "update", nullptr, HasherUpdate, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "digest", nullptr, HasherDigest, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "reset", nullptr, HasherReset, nullptr, nullptr, nullptr, napi_default, nullptr },
+    };
     
-    status = napi_create_function(env, nullptr, 0, Hash, nullptr, &fn);
+    napi_value hasher_class;
+    napi_status status = napi_define_class(env, "Hasher", NAPI_AUTO_LENGTH, HasherConstructor, nullptr,
+        sizeof(hasher_methods) / sizeof(hasher_methods[0]), hasher_methods, &hasher_class);
     if (status != napi_ok) return nullptr;
     
-    status = napi_set_named_property(env, exports, "hash", fn);
+    napi_property_descriptor methods[] = {
+        { "hash", nullptr, Hash, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "hash64", nullptr, Hash64, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "hashMany", nullptr, HashMany, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "hashBuffer", nullptr, HashBuffer, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "Hasher", nullptr, nullptr, nullptr, nullptr, hasher_class, napi_default, nullptr },
+    };
+    
+    status = napi_define_properties(env, exports, sizeof(methods) / sizeof(methods[0]), methods);
     if (status != napi_ok) return nullptr;
     
     return exports;
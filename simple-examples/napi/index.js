@@ -1,2 +1,35 @@
 const hasher = require('./build/Release/hasher');
-console.log(hasher.hash("hello"));
\ No newline at end of file
+const fs = require('fs');
+console.log(hasher.hash("hello"));
+
+const keys = ["hello", "world", "shard-key"];
+console.log(hasher.hash64("hello"));
+console.log(hasher.hashMany(keys));
+console.log(hasher.hashMany(keys, "wyhash"));
+
+// Ключи, упакованные в один Buffer: offsets - границы ключей (count + 1)
+const packed = Buffer.from(keys.join(""));
+const offsets = new Uint32Array(keys.length + 1);
+keys.forEach((key, i) => offsets[i + 1] = offsets[i] + Buffer.byteLength(key));
+console.log(hasher.hashBuffer(packed, offsets, "wyhash"));
+
+// Граница буфера 256 байт: многобайтовая строка, которую N-API обрезал бы по символу, хешируется целиком
+const boundary = "яя" + "€".repeat(84);
+const boundaryBytes = Buffer.from(boundary);
+const boundaryHash = hasher.hashBuffer(boundaryBytes, new Uint32Array([0, boundaryBytes.length]))[0];
+console.log(hasher.hash(boundary) === boundaryHash && hasher.hashMany([boundary])[0] === boundaryHash);
+
+// Эталонные значения wyhash final4: на 48 и 96 байтах последний полный блок уходит в хвост, а не в цикл
+const wyhashVectors = [["a".repeat(48), 1232470792784282675n], ["a".repeat(96), 5907807327554728597n]];
+for (const [input, expected] of wyhashVectors) {
+    const chunked = new hasher.Hasher("wyhash");
+    chunked.update(Buffer.from(input.slice(0, 48)));
+    chunked.update(Buffer.from(input.slice(48)));
+    console.log(hasher.hash64(input) === expected && chunked.digest() === expected);
+}
+
+// Потоковое хеширование: файл читается чанками и целиком в память не попадает
+const fileHasher = new hasher.Hasher("wyhash");
+fs.createReadStream(__filename)
+    .on("data", (chunk) => fileHasher.update(chunk))
+    .on("end", () => console.log(fileHasher.digest()));
\ No newline at end of file
@@ -0,0 +1,9 @@
+{
+  "targets": [
+    {
+      "target_name": "hasher",
+      "include_dirs": [ "../common" ],
+      "sources": [ "hasher.cpp" ]
+    }
+  ]
+}
@@ -0,0 +1,107 @@
+#include <node.h>
+#include <v8.h>
+#include <string>
+#include "hash.h"
+
+// Fast API: заголовок есть в node-gyp headers начиная с Node 24 (в .nvmrc проекта - 24).
+// Без него модуль собирается с одним медленным путем, и это видно по fastApi === false
+#if defined(__has_include)
+    #if __has_include(<v8-fast-api-calls.h>)
+        #include <v8-fast-api-calls.h>
+        #define HASHER_FAST_API 1
+    #endif
+#endif
+#ifndef HASHER_FAST_API
+    #define HASHER_FAST_API 0
+#endif
+
+namespace hasher {
+    using v8::Boolean;
+    using v8::ConstructorBehavior;
+    using v8::Context;
+    using v8::Exception;
+    using v8::FunctionCallbackInfo;
+    using v8::FunctionTemplate;
+    using v8::HandleScope;
+    using v8::Isolate;
+    using v8::Local;
+    using v8::Number;
+    using v8::Object;
+    using v8::SideEffectType;
+    using v8::Signature;
+    using v8::String;
+    using v8::Value;
+
+    // Сколько раз JIT вызвал быстрый путь - чтобы бенчмарк мог показать, что он действительно сработал
+    static double fast_call_count = 0;
+
+    // UTF-8 байты строки в переиспользуемый буфер (общий для обоих путей, все вызовы на главном потоке)
+    static std::string scratch;
+
+    static double HashString(Isolate* isolate, Local<String> str) {
+        const int length = str->Utf8Length(isolate);
+        scratch.resize(length);
+        str->WriteUtf8(isolate, &scratch[0], length, nullptr,
+            String::NO_NULL_TERMINATION | String::REPLACE_INVALID_UTF8);
+        return static_cast<double>(djb2_hash_bytes(reinterpret_cast<const uint8_t*>(scratch.data()), length));
+    }
+
+    // Медленный путь: обычный FunctionCallbackInfo, как в native-libs. V8 зовет его из интерпретатора
+    // и baseline кода, а также когда оптимизированный код не может пройти через быстрый
+    void Hash(const FunctionCallbackInfo<Value>& args) {
+        Isolate* isolate = args.GetIsolate();
+
+        if (args.Length() < 1 || !args[0]->IsString()) {
+            isolate->ThrowException(Exception::TypeError(
+                String::NewFromUtf8Literal(isolate, "Аргумент должен быть строкой")));
+            return;
+        }
+
+        args.GetReturnValue().Set(Number::New(isolate, HashString(isolate, args[0].As<String>())));
+    }
+
+#if HASHER_FAST_API
+    // Быстрый путь: TurboFan зовет его напрямую как C-функцию из оптимизированного кода,
+    // без создания FunctionCallbackInfo, без перехода через C++ builtin и без упаковки результата в Number
+    static double FastHash(Local<Value> receiver, Local<Value> input, v8::FastApiCallbackOptions& options) {
+        ++fast_call_count;
+        Isolate* isolate = options.isolate;
+        HandleScope scope(isolate);
+
+        if (!input->IsString()) {
+            isolate->ThrowException(Exception::TypeError(
+                String::NewFromUtf8Literal(isolate, "Аргумент должен быть строкой")));
+            return 0;
+        }
+        return HashString(isolate, input.As<String>());
+    }
+
+    static const v8::CFunction fast_hash = v8::CFunction::Make(FastHash);
+#endif
+
+    void GetFastCallCount(const FunctionCallbackInfo<Value>& args) {
+        args.GetReturnValue().Set(Number::New(args.GetIsolate(), fast_call_count));
+    }
+
+    void Init(Local<Object> exports) {
+        Isolate* isolate = exports->GetIsolate();
+        Local<Context> context = isolate->GetCurrentContext();
+
+        // Вместо NODE_SET_METHOD шаблон создается вручную: только так к функции привязывается CFunction
+        Local<FunctionTemplate> hash_template = FunctionTemplate::New(
+            isolate, Hash, Local<Value>(), Local<Signature>(), 1,
+            ConstructorBehavior::kThrow, SideEffectType::kHasNoSideEffect
+#if HASHER_FAST_API
+            , &fast_hash
+#endif
+        );
+        exports->Set(context, String::NewFromUtf8Literal(isolate, "hash"),
+            hash_template->GetFunction(context).ToLocalChecked()).FromJust();
+
+        NODE_SET_METHOD(exports, "getFastCallCount", GetFastCallCount);
+        exports->Set(context, String::NewFromUtf8Literal(isolate, "fastApi"),
+            Boolean::New(isolate, HASHER_FAST_API)).FromJust();
+    }
+
+    NODE_MODULE(NODE_GYP_MODULE_NAME, Init)
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+const hasher = require('bindings')('hasher');
+console.log(hasher.hash("hello"));
+
+// Быстрый путь включается только в оптимизированном коде: нужен горячий цикл
+let sum = 0;
+for (let i = 0; i < 1e6; i++) {
+    sum += hasher.hash("hello");
+}
+console.log(`Fast API: ${hasher.fastApi}, быстрых вызовов: ${hasher.getFastCallCount()}`);
\ No newline at end of file
@@ -2,6 +2,7 @@
   "targets": [
     {
       "target_name": "hasher",
+      "include_dirs": [ "../common" ],
       "sources": [ "hasher.cpp" ]
     }
   ]
@@ -1,16 +1,28 @@
 #include <node.h>
+#include <node_buffer.h>
+#include <node_object_wrap.h>
 #include <v8.h>
 #include <string>
+#include "hash.h"
 
 namespace hasher {
+    using v8::Array;
+    using v8::ArrayBuffer;
+    using v8::BigInt;
+    using v8::BigUint64Array;
     using v8::Context;
     using v8::Exception;
+    using v8::Float64Array;
+    using v8::Function;
+    using v8::FunctionTemplate;
     using v8::FunctionCallbackInfo;
     using v8::Isolate;
     using v8::Local;
     using v8::Number;
     using v8::Object;
     using v8::String;
+    using v8::TypedArray;
+    using v8::Uint32Array;
     using v8::Value;
 
     unsigned long djb2_hash(const char* str) {
@@ -43,8 +55,217 @@ namespace hasher {
         args.GetReturnValue().Set(Number::New(isolate, hash_result));
     }
 
+    void ThrowTypeError(Isolate* isolate, const char* message) {
+        isolate->ThrowException(Exception::TypeError(
+            String::NewFromUtf8(isolate, message).ToLocalChecked()));
+    }
+
+    // UTF-8 байты строки в переиспользуемый буфер, без аллокации на каждую строку (в отличие от Utf8Value)
+    size_t WriteUtf8(Isolate* isolate, Local<String> str, std::string& scratch) {
+        const int length = str->Utf8Length(isolate);
+        scratch.resize(length);
+        str->WriteUtf8(isolate, &scratch[0], length, nullptr,
+            String::NO_NULL_TERMINATION | String::REPLACE_INVALID_UTF8);
+        return length;
+    }
+
+    // Необязательный аргумент алгоритма: 'djb2' (по умолчанию) или 'wyhash'
+    bool ReadAlgorithm(const FunctionCallbackInfo<Value>& args, int index, HashAlgorithm& algorithm) {
+        Isolate* isolate = args.GetIsolate();
+        algorithm = HashAlgorithm::Djb2;
+        if (args.Length() <= index || args[index]->IsUndefined()) {
+            return true;
+        }
+        if (!args[index]->IsString() || !ParseHashAlgorithm(*String::Utf8Value(isolate, args[index]), algorithm)) {
+            ThrowTypeError(isolate, "Алгоритм должен быть 'djb2' или 'wyhash'");
+            return false;
+        }
+        return true;
+    }
+
+    // Результат под алгоритм: Float64Array для djb2 (как hash), BigUint64Array для wyhash
+    Local<TypedArray> CreateResult(Isolate* isolate, HashAlgorithm algorithm, size_t count, void** data) {
+        Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, count * 8);
+        *data = buffer->GetBackingStore()->Data();
+        if (algorithm == HashAlgorithm::Djb2) {
+            return Float64Array::New(buffer, 0, count);
+        }
+        return BigUint64Array::New(buffer, 0, count);
+    }
+
+    // hash64(string) -> bigint (wyhash)
+    void Hash64(const FunctionCallbackInfo<Value>& args) {
+        Isolate* isolate = args.GetIsolate();
+
+        if (args.Length() < 1 || !args[0]->IsString()) {
+            ThrowTypeError(isolate, "Аргумент должен быть строкой");
+            return;
+        }
+
+        std::string input;
+        const size_t length = WriteUtf8(isolate, args[0].As<String>(), input);
+        args.GetReturnValue().Set(BigInt::NewFromUnsigned(isolate, wyhash64(input.data(), length)));
+    }
+
+    // hashMany(strings[], algorithm?) - один вызов на весь массив, буфер под UTF-8 общий для всех строк
+    void HashMany(const FunctionCallbackInfo<Value>& args) {
+        Isolate* isolate = args.GetIsolate();
+        Local<Context> context = isolate->GetCurrentContext();
+
+        if (args.Length() < 1 || !args[0]->IsArray()) {
+            ThrowTypeError(isolate, "Первый аргумент должен быть массивом строк");
+            return;
+        }
+
+        HashAlgorithm algorithm;
+        if (!ReadAlgorithm(args, 1, algorithm)) {
+            return;
+        }
+
+        Local<Array> strings = args[0].As<Array>();
+        const uint32_t count = strings->Length();
+        void* out;
+        Local<TypedArray> result = CreateResult(isolate, algorithm, count, &out);
+
+        std::string scratch;
+        for (uint32_t i = 0; i < count; ++i) {
+            Local<Value> item;
+            if (!strings->Get(context, i).ToLocal(&item) || !item->IsString()) {
+                ThrowTypeError(isolate, "Все элементы массива должны быть строками");
+                return;
+            }
+
+            const size_t length = WriteUtf8(isolate, item.As<String>(), scratch);
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(scratch.data());
+            if (algorithm == HashAlgorithm::Djb2) {
+                static_cast<double*>(out)[i] = static_cast<double>(djb2_hash_bytes(bytes, length));
+            } else {
+                static_cast<uint64_t*>(out)[i] = wyhash64(bytes, length);
+            }
+        }
+
+        args.GetReturnValue().Set(result);
+    }
+
+    // hashBuffer(buffer, offsets, algorithm?) - ключи упакованы в один Buffer, offsets (Uint32Array, count + 1)
+    // задают границы. Хешируем прямо по памяти Buffer, без копий и без строк
+    void HashBuffer(const FunctionCallbackInfo<Value>& args) {
+        Isolate* isolate = args.GetIsolate();
+
+        if (args.Length() < 2 || !node::Buffer::HasInstance(args[0]) || !args[1]->IsUint32Array()) {
+            ThrowTypeError(isolate, "Ожидается Buffer и Uint32Array смещений");
+            return;
+        }
+
+        HashAlgorithm algorithm;
+        if (!ReadAlgorithm(args, 2, algorithm)) {
+            return;
+        }
+
+        Local<Uint32Array> offsetsArray = args[1].As<Uint32Array>();
+        const uint32_t* offsets = reinterpret_cast<const uint32_t*>(
+            static_cast<const uint8_t*>(offsetsArray->Buffer()->GetBackingStore()->Data()) + offsetsArray->ByteOffset());
+        const size_t count = offsetsArray->Length() > 0 ? offsetsArray->Length() - 1 : 0;
+
+        void* out;
+        Local<TypedArray> result = CreateResult(isolate, algorithm, count, &out);
+
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(node::Buffer::Data(args[0]));
+        if (!HashPacked(algorithm, data, node::Buffer::Length(args[0]), offsets, count, out)) {
+            isolate->ThrowException(Exception::RangeError(
+                String::NewFromUtf8Literal(isolate, "Смещения должны не убывать и не выходить за Buffer")));
+            return;
+        }
+
+        args.GetReturnValue().Set(result);
+    }
+
+    // new Hasher(algorithm?) - потоковое хеширование: update(Buffer | string) по чанкам, digest() в конце.
+    // Состояние живет в нативном объекте, вход целиком в памяти не нужен
+    class Hasher : public node::ObjectWrap {
+    public:
+        static void Init(Local<Object> exports) {
+            Isolate* isolate = exports->GetIsolate();
+            Local<Context> context = isolate->GetCurrentContext();
+
+            Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+            tpl->SetClassName(String::NewFromUtf8Literal(isolate, "Hasher"));
+            tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+            NODE_SET_PROTOTYPE_METHOD(tpl, "update", Update);
+            NODE_SET_PROTOTYPE_METHOD(tpl, "digest", Digest);
+            NODE_SET_PROTOTYPE_METHOD(tpl, "reset", Reset);
+
+            Local<Function> constructor = tpl->GetFunction(context).ToLocalChecked();
+            exports->Set(context, String::NewFromUtf8Literal(isolate, "Hasher"), constructor).FromJust();
+        }
+
+    private:
+        static void New(const FunctionCallbackInfo<Value>& args) {
+            Isolate* isolate = args.GetIsolate();
+            if (!args.IsConstructCall()) {
+                ThrowTypeError(isolate, "Hasher нужно создавать через new");
+                return;
+            }
+
+            HashAlgorithm algorithm;
+            if (!ReadAlgorithm(args, 0, algorithm)) {
+                return;
+            }
+
+            Hasher* hasher = new Hasher();
+            hasher->state_.algorithm = algorithm;
+            hasher->Wrap(args.This());
+            args.GetReturnValue().Set(args.This());
+        }
+
+        // update(Buffer | string) -> this. Buffer хешируется прямо из своей памяти
+        static void Update(const FunctionCallbackInfo<Value>& args) {
+            Isolate* isolate = args.GetIsolate();
+            Hasher* hasher = ObjectWrap::Unwrap<Hasher>(args.This());
+
+            if (args.Length() >= 1 && node::Buffer::HasInstance(args[0])) {
+                hasher->state_.Update(node::Buffer::Data(args[0]), node::Buffer::Length(args[0]));
+            } else if (args.Length() >= 1 && args[0]->IsString()) {
+                const size_t length = WriteUtf8(isolate, args[0].As<String>(), hasher->scratch_);
+                hasher->state_.Update(hasher->scratch_.data(), length);
+            } else {
+                ThrowTypeError(isolate, "Аргумент должен быть Buffer или строкой");
+                return;
+            }
+
+            args.GetReturnValue().Set(args.This());
+        }
+
+        // digest() -> number (djb2) | bigint (wyhash). Состояние не сбрасывается
+        static void Digest(const FunctionCallbackInfo<Value>& args) {
+            Isolate* isolate = args.GetIsolate();
+            Hasher* hasher = ObjectWrap::Unwrap<Hasher>(args.This());
+
+            if (hasher->state_.algorithm == HashAlgorithm::Djb2) {
+                args.GetReturnValue().Set(Number::New(isolate, hasher->state_.djb2.Digest()));
+            } else {
+                args.GetReturnValue().Set(BigInt::NewFromUnsigned(isolate, hasher->state_.wyhash.Digest()));
+            }
+        }
+
+        // reset() -> this, чтобы переиспользовать объект для следующего входа
+        static void Reset(const FunctionCallbackInfo<Value>& args) {
+            Hasher* hasher = ObjectWrap::Unwrap<Hasher>(args.This());
+            hasher->state_.Reset();
+            args.GetReturnValue().Set(args.This());
+        }
+
+        StreamingHasher state_;
+        std::string scratch_; // UTF-8 для строковых чанков, переиспользуется между update
+    };
+
     void Init(Local<Object> exports) {
+        Hasher::Init(exports);
         NODE_SET_METHOD(exports, "hash", Hash);
+        NODE_SET_METHOD(exports, "hash64", Hash64);
+        NODE_SET_METHOD(exports, "hashMany", HashMany);
+        NODE_SET_METHOD(exports, "hashBuffer", HashBuffer);
     }
 
     NODE_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -2,7 +2,8 @@
   "targets": [
     { 
       "include_dirs" : [
-        "<!@(node -p \"require('node-addon-api').include\")"
+        "<!@(node -p \"require('node-addon-api').include\")",
+        "../common"
       ],
       "target_name": "hasher",
       "sources": [ "hasher.cpp" ],
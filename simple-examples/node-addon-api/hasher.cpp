@@ -1,5 +1,9 @@
 #include <napi.h>
 #include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include "hash.h"
 
 unsigned long djb2_hash(const char* str) {
     unsigned long hash = 5381;
@@ -29,8 +33,295 @@ Napi::Number Hash(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, hash_result);
 }
 
+// N-API обрезает строку по границе символа, а символ UTF-8 занимает до 4 байт: копия полная,
+// только если после нее в буфере осталось место еще под один такой символ и завершающий ноль
+static bool CopiedWhole(size_t copied, size_t capacity) {
+    return copied + 4 < capacity;
+}
+
+// UTF-8 байты строки в переиспользуемый буфер: один вызов N-API, если строка влезла, иначе второй с нужным размером
+static bool ReadUtf8(Napi::Env env, napi_value value, std::vector<char>& scratch, size_t& length) {
+    if (scratch.size() < 256) {
+        scratch.resize(256);
+    }
+    if (napi_get_value_string_utf8(env, value, scratch.data(), scratch.size(), &length) != napi_ok) {
+        return false;
+    }
+    if (CopiedWhole(length, scratch.size())) {
+        return true;
+    }
+    // Буфер заполнен почти целиком - строка могла обрезаться
+    if (napi_get_value_string_utf8(env, value, nullptr, 0, &length) != napi_ok) {
+        return false;
+    }
+    scratch.resize(length + 1);
+    return napi_get_value_string_utf8(env, value, scratch.data(), scratch.size(), &length) == napi_ok;
+}
+
+// Необязательный аргумент алгоритма: 'djb2' (по умолчанию) или 'wyhash'
+static bool ReadAlgorithm(const Napi::CallbackInfo& info, size_t index, HashAlgorithm& algorithm) {
+    algorithm = HashAlgorithm::Djb2;
+    if (info.Length() <= index || info[index].IsUndefined()) {
+        return true;
+    }
+    if (!info[index].IsString() || !ParseHashAlgorithm(info[index].As<Napi::String>().Utf8Value().c_str(), algorithm)) {
+        Napi::TypeError::New(info.Env(), "Алгоритм должен быть 'djb2' или 'wyhash'").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// Результат под алгоритм: Float64Array для djb2 (как hash), BigUint64Array для wyhash
+static Napi::TypedArray CreateResult(Napi::Env env, HashAlgorithm algorithm, size_t count, void** data) {
+    if (algorithm == HashAlgorithm::Djb2) {
+        Napi::Float64Array result = Napi::Float64Array::New(env, count);
+        *data = result.Data();
+        return result;
+    }
+    Napi::BigUint64Array result = Napi::BigUint64Array::New(env, count);
+    *data = result.Data();
+    return result;
+}
+
+// hash64(string) -> bigint (wyhash)
+Napi::Value Hash64(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Аргумент должен быть строкой").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    std::vector<char> scratch;
+    size_t length;
+    if (!ReadUtf8(env, info[0], scratch, length)) {
+        Napi::Error::New(env, "Ошибка получения строки").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return Napi::BigInt::New(env, wyhash64(scratch.data(), length));
+}
+
+// hashMany(strings[], algorithm?) - один вызов на весь массив, буфер под UTF-8 общий для всех строк
+Napi::Value HashMany(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        Napi::TypeError::New(env, "Первый аргумент должен быть массивом строк").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    HashAlgorithm algorithm;
+    if (!ReadAlgorithm(info, 1, algorithm)) {
+        return env.Null();
+    }
+
+    Napi::Array strings = info[0].As<Napi::Array>();
+    const uint32_t count = strings.Length();
+    void* out;
+    Napi::TypedArray result = CreateResult(env, algorithm, count, &out);
+
+    std::vector<char> scratch;
+    for (uint32_t i = 0; i < count; ++i) {
+        Napi::Value item = strings[i];
+        size_t length;
+        if (!item.IsString() || !ReadUtf8(env, item, scratch, length)) {
+            Napi::TypeError::New(env, "Все элементы массива должны быть строками").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(scratch.data());
+        if (algorithm == HashAlgorithm::Djb2) {
+            static_cast<double*>(out)[i] = static_cast<double>(djb2_hash_bytes(bytes, length));
+        } else {
+            static_cast<uint64_t*>(out)[i] = wyhash64(bytes, length);
+        }
+    }
+    return result;
+}
+
+// hashBuffer(buffer, offsets, algorithm?) - ключи упакованы в один Buffer, offsets (Uint32Array, count + 1)
+// задают границы. Хешируем прямо по памяти Buffer, без копий и без строк
+Napi::Value HashBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsBuffer() || !info[1].IsTypedArray() ||
+        info[1].As<Napi::TypedArray>().TypedArrayType() != napi_uint32_array) {
+        Napi::TypeError::New(env, "Ожидается Buffer и Uint32Array смещений").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    HashAlgorithm algorithm;
+    if (!ReadAlgorithm(info, 2, algorithm)) {
+        return env.Null();
+    }
+
+    Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+    Napi::Uint32Array offsets = info[1].As<Napi::Uint32Array>();
+    const size_t count = offsets.ElementLength() > 0 ? offsets.ElementLength() - 1 : 0;
+
+    void* out;
+    Napi::TypedArray result = CreateResult(env, algorithm, count, &out);
+    if (!HashPacked(algorithm, buffer.Data(), buffer.Length(), offsets.Data(), count, out)) {
+        Napi::RangeError::New(env, "Смещения должны не убывать и не выходить за Buffer").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return result;
+}
+
+// ========================== hashAsync ==========================
+// Меньше этого размера считаем сразу на главном потоке: очередь libuv и Promise дороже самого хеша
+static const size_t kAsyncHashThreshold = 4 * kTreeHashChunk;
+
+// Общее состояние одного hashAsync: листья дерева заполняют несколько задач пула libuv,
+// последняя завершившаяся сворачивает дерево и резолвит Promise (OnOK всегда на главном потоке)
+struct TreeHashJob {
+    TreeHashJob(Napi::Env env, Napi::Buffer<uint8_t> buffer)
+    : deferred(Napi::Promise::Deferred::New(env)),
+    bufferRef(Napi::Persistent(buffer)),
+    data(buffer.Data()),
+    length(buffer.Length()),
+    leaves(TreeHashLeafCount(buffer.Length())) {}
+
+    Napi::Promise::Deferred deferred;
+    Napi::Reference<Napi::Buffer<uint8_t>> bufferRef; // держит Buffer живым, пока потоки читают его память
+    const uint8_t* data;
+    size_t length;
+    std::vector<uint64_t> leaves;
+    size_t pending = 0;
+};
+
+class TreeHashWorker : public Napi::AsyncWorker {
+public:
+    TreeHashWorker(Napi::Env env, std::shared_ptr<TreeHashJob> job, size_t firstLeaf, size_t lastLeaf)
+    : Napi::AsyncWorker(env),
+    job_(std::move(job)),
+    firstLeaf_(firstLeaf),
+    lastLeaf_(lastLeaf) {}
+
+    // Задачи пишут в непересекающиеся диапазоны leaves, синхронизация не нужна
+    void Execute() override {
+        for (size_t i = firstLeaf_; i < lastLeaf_; ++i) {
+            job_->leaves[i] = TreeHashLeaf(job_->data, job_->length, i);
+        }
+    }
+
+    void OnOK() override {
+        if (--job_->pending > 0) {
+            return;
+        }
+        const uint64_t root = TreeHashRoot(job_->leaves, job_->length);
+        job_->bufferRef.Reset();
+        job_->deferred.Resolve(Napi::BigInt::New(Env(), root));
+    }
+
+private:
+    std::shared_ptr<TreeHashJob> job_;
+    size_t firstLeaf_, lastLeaf_;
+};
+
+// Столько задач, сколько потоков в пуле libuv: больше все равно не выполнится одновременно
+static size_t ThreadPoolSize() {
+    const char* env = std::getenv("UV_THREADPOOL_SIZE");
+    const long size = env ? std::strtol(env, nullptr, 10) : 0;
+    return size > 0 ? static_cast<size_t>(size) : 4;
+}
+
+// hashAsync(buffer) -> Promise<bigint> - древовидный wyhash (см. TreeHashRoot в hash.h).
+// Чанки по 1 МБ считаются параллельно в пуле libuv; Buffer нельзя менять, пока Promise не завершился
+Napi::Value HashAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsBuffer()) {
+        Napi::TypeError::New(env, "Аргумент должен быть Buffer").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+    const size_t leafCount = TreeHashLeafCount(buffer.Length());
+
+    if (buffer.Length() < kAsyncHashThreshold) {
+        std::vector<uint64_t> leaves(leafCount);
+        for (size_t i = 0; i < leafCount; ++i) {
+            leaves[i] = TreeHashLeaf(buffer.Data(), buffer.Length(), i);
+        }
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        deferred.Resolve(Napi::BigInt::New(env, TreeHashRoot(std::move(leaves), buffer.Length())));
+        return deferred.Promise();
+    }
+
+    auto job = std::make_shared<TreeHashJob>(env, buffer);
+    const size_t tasks = std::min(leafCount, ThreadPoolSize());
+    job->pending = tasks;
+
+    for (size_t t = 0; t < tasks; ++t) {
+        const size_t firstLeaf = leafCount * t / tasks;
+        const size_t lastLeaf = leafCount * (t + 1) / tasks;
+        (new TreeHashWorker(env, job, firstLeaf, lastLeaf))->Queue();
+    }
+    return job->deferred.Promise();
+}
+
+// new Hasher(algorithm?) - потоковое хеширование: update(Buffer | string) по чанкам, digest() в конце.
+// Состояние живет в нативном объекте, вход целиком в памяти не нужен
+class Hasher : public Napi::ObjectWrap<Hasher> {
+public:
+    static Napi::Function Init(Napi::Env env) {
+        return DefineClass(env, "Hasher", {
+            InstanceMethod("update", &Hasher::Update),
+            InstanceMethod("digest", &Hasher::Digest),
+            InstanceMethod("reset", &Hasher::Reset),
+        });
+    }
+
+    Hasher(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Hasher>(info) {
+        ReadAlgorithm(info, 0, state_.algorithm);
+    }
+
+private:
+    // update(Buffer | string) -> this. Buffer хешируется прямо из своей памяти
+    Napi::Value Update(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+
+        if (info.Length() >= 1 && info[0].IsBuffer()) {
+            Napi::Buffer<uint8_t> buffer = info[0].As<Napi::Buffer<uint8_t>>();
+            state_.Update(buffer.Data(), buffer.Length());
+        } else if (info.Length() >= 1 && info[0].IsString()) {
+            size_t length;
+            if (!ReadUtf8(env, info[0], scratch_, length)) {
+                Napi::Error::New(env, "Ошибка получения строки").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            state_.Update(scratch_.data(), length);
+        } else {
+            Napi::TypeError::New(env, "Аргумент должен быть Buffer или строкой").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+
+        return info.This();
+    }
+
+    // digest() -> number (djb2) | bigint (wyhash). Состояние не сбрасывается
+    Napi::Value Digest(const Napi::CallbackInfo& info) {
+        if (state_.algorithm == HashAlgorithm::Djb2) {
+            return Napi::Number::New(info.Env(), static_cast<double>(state_.djb2.Digest()));
+        }
+        return Napi::BigInt::New(info.Env(), state_.wyhash.Digest());
+    }
+
+    // reset() -> this, чтобы переиспользовать объект для следующего входа
+    Napi::Value Reset(const Napi::CallbackInfo& info) {
+        state_.Reset();
+        return info.This();
+    }
+
+    StreamingHasher state_;
+    std::vector<char> scratch_; // UTF-8 для строковых чанков, переиспользуется между update
+};
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set(Napi::String::New(env, "Hasher"), Hasher::Init(env));
     exports.Set(Napi::String::New(env, "hash"), Napi::Function::New(env, Hash));
+    exports.Set(Napi::String::New(env, "hash64"), Napi::Function::New(env, Hash64));
+    exports.Set(Napi::String::New(env, "hashMany"), Napi::Function::New(env, HashMany));
+    exports.Set(Napi::String::New(env, "hashBuffer"), Napi::Function::New(env, HashBuffer));
+    exports.Set(Napi::String::New(env, "hashAsync"), Napi::Function::New(env, HashAsync));
     return exports;
 }
 